@@ -0,0 +1,301 @@
+/*
+    nanogui/capture.h -- Asynchronous framebuffer readback and frame encoding
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/glutil.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \struct CapturedFrame capture.h nanogui/capture.h
+ *
+ * \brief A single frame that was read back from the GPU.
+ *
+ * The pixel data is stored as tightly packed 8 bit RGBA values, starting with
+ * the top row of the image.
+ */
+struct CapturedFrame {
+    /// Size of the frame in pixels
+    Vector2i size = Vector2i::Zero();
+
+    /// Time stamp that was passed to \ref GLFrameCapture::capture()
+    double time = 0.0;
+
+    /// Frame index (counts all frames submitted to the capture object)
+    uint64_t index = 0;
+
+    /// RGBA8 pixel data (top row first)
+    std::vector<uint8_t> data;
+};
+
+//  ----------------------------------------------------
+
+/**
+ * \class GLFrameCapture capture.h nanogui/capture.h
+ *
+ * \brief Asynchronous framebuffer readback using a ring of pixel buffer objects.
+ *
+ * Each call to \ref capture() issues a ``glReadPixels`` into the next pixel
+ * buffer object of a ring and inserts a fence behind it. The call returns
+ * immediately; the data is copied out of the buffer once the fence has been
+ * signaled, which is typically one or two frames later. Completed frames are
+ * handed to the callback by \ref poll(), which is also invoked automatically
+ * at the beginning of every \ref capture(). The pipeline only stalls when
+ * the GPU falls more than ``bufferCount`` frames behind.
+ *
+ * All methods must be called on the thread that owns the OpenGL context.
+ * Combine with \ref FrameEncoder to move file I/O off that thread.
+ */
+class NANOGUI_EXPORT GLFrameCapture {
+public:
+    /// Callback that receives completed frames (invoked on the OpenGL thread)
+    using Callback = std::function<void(CapturedFrame &&)>;
+
+    /// Default constructor: unusable until you call the ``init()`` method
+    GLFrameCapture() : mSize(Vector2i::Zero()), mHead(0), mPending(0), mFrameIndex(0) { }
+
+    /// Allocate ``bufferCount`` pixel buffer objects for frames of the given size
+    void init(const Vector2i &size, int bufferCount = 3);
+
+    /// Release all associated resources (pending frames are discarded)
+    void free();
+
+    /// Return whether or not the capture object has been initialized
+    bool ready() const { return !mSlots.empty(); }
+
+    /// Return the size of captured frames
+    const Vector2i &size() const { return mSize; }
+
+    /// Return the number of pixel buffer objects in the ring
+    int bufferCount() const { return (int) mSlots.size(); }
+
+    /// Return the number of readbacks that have not been delivered yet
+    int pending() const { return mPending; }
+
+    /// Set the callback which receives completed frames
+    void setCallback(const Callback &callback) { mCallback = callback; }
+
+    /// Return the callback which receives completed frames
+    const Callback &callback() const { return mCallback; }
+
+    /**
+     * \brief Start an asynchronous readback of the given framebuffer object.
+     *
+     * \param framebuffer
+     *     OpenGL name of a single-sampled framebuffer object. The value ``0``
+     *     refers to the back buffer of the default framebuffer.
+     *
+     * \param time
+     *     Time stamp that will be stored in the resulting \ref CapturedFrame.
+     */
+    void capture(GLuint framebuffer = 0, double time = 0.0);
+
+    /// Start an asynchronous readback of a \ref GLFramebuffer (multisampled ones are resolved first)
+    void capture(GLFramebuffer &framebuffer, double time = 0.0);
+
+    /**
+     * \brief Deliver all completed readbacks to the callback.
+     *
+     * \param wait
+     *     If ``true``, block until every pending readback has completed.
+     *
+     * \return
+     *     The number of frames that were delivered.
+     */
+    int poll(bool wait = false);
+
+protected:
+    /// Copy a finished slot into a \ref CapturedFrame and invoke the callback
+    bool retrieve(bool wait);
+
+    /**
+     * \struct Slot capture.h nanogui/capture.h
+     *
+     * A pixel buffer object of the ring along with its fence.
+     */
+    struct Slot {
+        GLuint pbo;
+        GLsync fence;
+        double time;
+        uint64_t index;
+    };
+
+    std::vector<Slot> mSlots;
+    Vector2i mSize;
+    int mHead, mPending;
+    uint64_t mFrameIndex;
+    GLFramebuffer mResolve;
+    Callback mCallback;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//  ----------------------------------------------------
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \class SPSCQueue capture.h nanogui/capture.h
+ *
+ * \brief Bounded lock-free queue for exactly one producer and one consumer thread.
+ */
+template <typename T> class SPSCQueue {
+public:
+    SPSCQueue(size_t capacity) : mItems(capacity + 1), mHead(0), mTail(0) { }
+
+    /// Try to append an element (producer thread). Returns ``false`` when full.
+    bool push(T &&value) {
+        size_t tail = mTail.load(std::memory_order_relaxed),
+               next = (tail + 1) % mItems.size();
+        if (next == mHead.load(std::memory_order_acquire))
+            return false;
+        mItems[tail] = std::move(value);
+        mTail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /// Try to remove the oldest element (consumer thread). Returns ``false`` when empty.
+    bool pop(T &value) {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+            return false;
+        value = std::move(mItems[head]);
+        mHead.store((head + 1) % mItems.size(), std::memory_order_release);
+        return true;
+    }
+
+    /// Return whether the queue is currently empty
+    bool empty() const {
+        return mHead.load(std::memory_order_acquire) ==
+               mTail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> mItems;
+    std::atomic<size_t> mHead, mTail;
+};
+
+NAMESPACE_END(detail)
+
+//  ----------------------------------------------------
+
+/**
+ * \class FrameEncoder capture.h nanogui/capture.h
+ *
+ * \brief Streams captured frames to disk on a worker thread.
+ *
+ * Frames are handed over through a bounded lock-free queue, so \ref push()
+ * never blocks the rendering thread. When the worker cannot keep up, new
+ * frames are dropped (see \ref dropped()) instead of stalling the caller.
+ *
+ * \rst
+ * **Usage**
+ *
+ * .. code-block:: cpp
+ *
+ *    FrameEncoder encoder("session.y4m", FrameEncoder::Format::Y4M, 60);
+ *    GLFrameCapture capture;
+ *    capture.init(screen->framebufferSize());
+ *    capture.setCallback([&](CapturedFrame &&frame) {
+ *        encoder.push(std::move(frame));
+ *    });
+ *    screen->setFrameCapture(&capture);
+ *
+ * \endrst
+ */
+class NANOGUI_EXPORT FrameEncoder {
+public:
+    /// Supported output formats
+    enum class Format {
+        Raw, ///< Concatenated RGBA8 frames in a single file
+        Y4M, ///< YUV4MPEG2 stream (4:4:4, BT.601) in a single file
+        PNG  ///< One PNG file per frame; ``path`` is a ``printf`` pattern such as ``"frame_%05d.png"``
+    };
+
+    /**
+     * \brief Create an encoder and start its worker thread.
+     *
+     * \param path
+     *     Output file name (``Raw``, ``Y4M``) or ``printf`` pattern with a
+     *     single ``%d`` conversion (``PNG``).
+     *
+     * \param format
+     *     The output format.
+     *
+     * \param fps
+     *     Frame rate that is written into the Y4M stream header.
+     *
+     * \param queueSize
+     *     Maximum number of frames waiting to be written.
+     */
+    FrameEncoder(const std::string &path, Format format, int fps = 60,
+                 size_t queueSize = 8);
+
+    /// Write all queued frames and terminate the worker thread
+    ~FrameEncoder();
+
+    /// Hand a frame to the worker thread. Returns ``false`` if it had to be dropped.
+    bool push(CapturedFrame &&frame);
+
+    /// Return the output format
+    Format format() const { return mFormat; }
+
+    /// Return the number of frames that have been written so far
+    size_t written() const { return mWritten; }
+
+    /// Return the number of frames that were dropped because the queue was full
+    size_t dropped() const { return mDropped; }
+
+protected:
+    /// Worker thread main loop
+    void run();
+
+    /// Write a single frame in the selected output format
+    void write(const CapturedFrame &frame);
+
+    /// Check that a PNG file name pattern contains exactly one ``%d`` conversion
+    static bool validPattern(const std::string &path);
+
+protected:
+    std::string mPath;
+    Format mFormat;
+    int mFPS;
+    FILE *mFile;
+    Vector2i mStreamSize;
+    std::vector<uint8_t> mScratch;
+    detail::SPSCQueue<CapturedFrame> mQueue;
+    std::atomic<bool> mActive;
+    std::atomic<size_t> mWritten, mDropped;
+    std::mutex mMutex;
+    std::condition_variable mCond;
+    std::thread mThread;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * \brief Write an RGBA8 image (top row first) to a PNG file.
+ *
+ * The image data is stored without compression, which keeps encoding cheap
+ * enough for continuous capture.
+ */
+extern NANOGUI_EXPORT void writePNG(const std::string &filename,
+                                    const Vector2i &size,
+                                    const uint8_t *data);
+
+NAMESPACE_END(nanogui)
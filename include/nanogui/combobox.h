@@ -10,11 +10,20 @@
  * \file nanogui/combobox.h
  *
  * \brief Simple combo box widget based on a popup button.
+ *
+ * By default, the popup contains one radio button per item. For long item
+ * lists, \ref setVirtualized() replaces them by a single scrollable list
+ * that is drawn directly from \ref items() and only draws the visible rows.
+ * Typing while the popup is open filters the list to the items that start
+ * with the typed text; the required prefix index is built on a worker thread
+ * whenever the items change. Changing the items again never waits for an
+ * index that is still being built.
  */
 
 #pragma once
 
 #include <nanogui/popupbutton.h>
+#include <memory>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -62,9 +71,41 @@ public:
     /// The short descriptions associated with this ComboBox.
     const std::vector<std::string> &itemsShort() const { return mItemsShort; }
 
+    /// Whether the popup shows a virtualized list instead of one button per item.
+    bool virtualized() const { return mList != nullptr; }
+
+    /// Sets whether the popup shows a virtualized list instead of one button per item.
+    void setVirtualized(bool virtualized);
+
+    /// The number of rows shown at once by the virtualized list.
+    int visibleRows() const { return mVisibleRows; }
+
+    /// Sets the number of rows shown at once by the virtualized list.
+    void setVisibleRows(int visibleRows);
+
+    /// The type-ahead filter of the virtualized list.
+    const std::string &filter() const { return mFilter; }
+
+    /**
+     * \brief Sets the type-ahead filter of the virtualized list.
+     *
+     * Only items whose label starts with the filter are listed; the
+     * comparison ignores the case of ASCII characters.
+     */
+    void setFilter(const std::string &filter);
+
     /// Handles mouse scrolling events for this ComboBox.
     virtual bool scrollEvent(const Vector2i &p, const Vector2f &rel) override;
 
+    /// Scrolls the virtualized list to the selected item when the popup opens.
+    virtual bool mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) override;
+
+    /// Forwards key presses to the virtualized list while the popup is open.
+    virtual bool keyboardEvent(int key, int scancode, int action, int modifiers) override;
+
+    /// Forwards text input to the virtualized list while the popup is open.
+    virtual bool keyboardCharacterEvent(unsigned int codepoint) override;
+
     /// Saves the state of this ComboBox to the specified Serializer.
     virtual void save(Serializer &s) const override;
 
@@ -72,6 +113,33 @@ public:
     virtual bool load(Serializer &s) override;
 
 protected:
+    class ItemList;
+    struct IndexSlot;
+
+    /**
+     * \struct PrefixIndex combobox.h nanogui/combobox.h
+     *
+     * \brief Item labels in lower case along with their index, sorted for prefix search.
+     */
+    struct PrefixIndex {
+        std::vector<std::pair<std::string, int>> entries;
+    };
+
+    /// Selects an item, closes the popup and invokes the callback.
+    void selectItem(int index);
+
+    /// Recreates the popup contents for the current items.
+    void rebuildPopup(bool virtualized);
+
+    /// Recomputes the items matching the filter.
+    void updateFilter();
+
+    /// The number of items that match the filter.
+    int filteredCount() const;
+
+    /// The index of the item shown in the given row of the virtualized list.
+    int filteredItem(int row) const { return mFilterActive ? mFiltered[row] : row; }
+
     /// The items associated with this ComboBox.
     std::vector<std::string> mItems;
 
@@ -84,6 +152,24 @@ protected:
     /// The current index this ComboBox has selected.
     int mSelectedIndex;
 
+    /// The virtualized list inside the popup (``nullptr`` unless virtualized).
+    ItemList *mList;
+
+    /// The number of rows shown at once by the virtualized list.
+    int mVisibleRows;
+
+    /// The type-ahead filter of the virtualized list.
+    std::string mFilter;
+
+    /// Whether the filter is non-empty, in which case \ref mFiltered lists the matching items.
+    bool mFilterActive;
+
+    /// The indices of the items that match the filter, in ascending order.
+    std::vector<int> mFiltered;
+
+    /// Receives the prefix index of the items from the worker thread that builds it.
+    std::shared_ptr<IndexSlot> mIndex;
+
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
@@ -372,25 +372,33 @@ class ColorWheel;
 class ColorPicker;
 class ComboBox;
 class GLFramebuffer;
+class GLFrameCapture;
+class GLRenderTarget;
 class GLShader;
+class GLTexture;
 class GridLayout;
 class GroupLayout;
 class ImagePanel;
 class ImageView;
 class Label;
 class Layout;
+class LazyPage;
 class MessageDialog;
 class Object;
 class Popup;
+class PrimitiveBatch;
 class PopupButton;
 class ProgressBar;
 class Screen;
 class Serializer;
+class Skin;
 class Slider;
 class StackedWidget;
 class TabHeader;
 class TabWidget;
+class TextArea;
 class TextBox;
+class TextDocument;
 class GLCanvas;
 class Theme;
 class ToolButton;
@@ -435,7 +443,9 @@ extern NANOGUI_EXPORT void shutdown();
  *     ``detach != None``, the function returns an opaque handle that
  *     will release any resources allocated by the created thread when the
  *     handle's ``join()`` method is invoked (or when it is garbage
- *     collected).
+ *     collected). Alternatively, ``mainloop_async()`` runs the main loop as
+ *     a task of the current ``asyncio`` event loop without creating any
+ *     threads (see \ref mainloop_iteration()).
  *
  * \remark
  *     Unfortunately, Mac OS X strictly requires all event processing to take
@@ -454,6 +464,32 @@ extern NANOGUI_EXPORT void shutdown();
  */
 extern NANOGUI_EXPORT void mainloop(int refresh = 50);
 
+/**
+ * \brief Run a single iteration of the application main loop
+ *
+ * Draws all visible screens (unless ``draw`` is ``false``) and then
+ * processes pending mouse/keyboard/.. events. Screens whose windows were
+ * asked to close are hidden. This is the body of \ref mainloop(); calling it
+ * repeatedly makes it possible to drive NanoGUI from a different event loop
+ * (the Python bindings use it to run the user interface as a task of an
+ * ``asyncio`` event loop).
+ *
+ * \param timeout
+ *     Number of seconds to wait for an event when none is pending. Zero
+ *     only processes the events that have already arrived, and a negative
+ *     value waits until the next event.
+ *
+ * \param draw
+ *     Whether to redraw the visible screens before processing events.
+ *
+ * \return
+ *     ``false`` if there is no visible screen anymore.
+ */
+extern NANOGUI_EXPORT bool mainloop_iteration(double timeout = 0, bool draw = true);
+
+/// Return the time of the most recent user interaction with any visible screen
+extern NANOGUI_EXPORT double last_interaction();
+
 /// Request the application main loop to terminate (e.g. if you detached mainloop).
 extern NANOGUI_EXPORT void leave();
 
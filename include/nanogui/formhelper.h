@@ -16,13 +16,16 @@
 #pragma once
 
 #include <nanogui/screen.h>
+#include <nanogui/opengl.h>
 #include <nanogui/label.h>
 #include <nanogui/checkbox.h>
 #include <nanogui/textbox.h>
 #include <nanogui/combobox.h>
 #include <nanogui/colorpicker.h>
 #include <nanogui/layout.h>
+#include <nanogui/reflection.h>
 #include <cassert>
+#include <memory>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -155,26 +158,24 @@ public:
     template <typename Type> detail::FormWidget<Type> *
     addVariable(const std::string &label, const std::function<void(const Type &)> &setter,
                 const std::function<Type()> &getter, bool editable = true) {
-        Label *labelW = new Label(mWindow, label, mLabelFontName, mLabelFontSize);
-        auto widget = new detail::FormWidget<Type>(mWindow);
-        auto refresh = [widget, getter] {
-            Type value = getter(), current = widget->value();
-            if (value != current)
-                widget->setValue(value);
+        auto widget = createVariableWidget<Type>(label, editable);
+        /* Compare against the last value shown by the widget instead of
+           reading it back (which e.g. parses the text of number fields) */
+        auto cache = std::make_shared<Type>(getter());
+        widget->setValue(*cache);
+        auto update = [widget, getter, cache]() -> int {
+            Type value = getter();
+            if (value == *cache)
+                return 0;
+            *cache = value;
+            widget->setValue(value);
+            return 1;
         };
-        refresh();
-        widget->setCallback(setter);
-        widget->setEditable(editable);
-        widget->setFontSize(mWidgetFontSize);
-        Vector2i fs = widget->fixedSize();
-        widget->setFixedSize(Vector2i(fs.x() != 0 ? fs.x() : mFixedSize.x(),
-                                      fs.y() != 0 ? fs.y() : mFixedSize.y()));
-        mRefreshCallbacks.push_back(refresh);
-        if (mLayout->rowCount() > 0)
-            mLayout->appendRow(mVariableSpacing);
-        mLayout->appendRow(0);
-        mLayout->setAnchor(labelW, AdvancedGridLayout::Anchor(1, mLayout->rowCount()-1));
-        mLayout->setAnchor(widget, AdvancedGridLayout::Anchor(3, mLayout->rowCount()-1));
+        widget->setCallback([setter, cache](const Type &value) {
+            *cache = value;
+            setter(value);
+        });
+        mBindings.push_back(Binding { widget, nullptr, update, mRefreshInterval, glfwGetTime() });
         return widget;
     }
 
@@ -188,6 +189,30 @@ public:
         );
     }
 
+    /**
+     * \brief Add a data widget for every field of a struct whose fields were
+     * declared with \ref NANOGUI_REFLECT.
+     *
+     * The widgets are labeled with the field names. Instead of a getter and
+     * setter per field, all fields share a single binding that compares the
+     * struct field by field against a cached copy (see \ref refresh()) and
+     * accesses the fields through member pointers of their static type.
+     * Use \ref notifyStruct() for push-style updates.
+     *
+     * \return
+     *     The widgets in the order of the fields (e.g. to set the items of
+     *     the ComboBox of an ``enum`` field).
+     */
+    template <typename T> std::vector<Widget *> addStruct(T &object, bool editable = true) {
+        auto cache = std::make_shared<T>(object);
+        std::vector<Widget *> widgets;
+        StructAdder<T> adder { this, &object, cache, editable, widgets };
+        forEachField<T>(adder);
+        mBindings.push_back(Binding { nullptr, &object, StructUpdater<T> { &object, cache, widgets },
+                                      mRefreshInterval, glfwGetTime() });
+        return widgets;
+    }
+
     /// Add a button with a custom callback
     Button *addButton(const std::string &label, const std::function<void()> &cb) {
         Button *button = new Button(mWindow, label);
@@ -212,10 +237,93 @@ public:
         }
     }
 
-    /// Cause all widgets to re-synchronize with the underlying variable state
-    void refresh() {
-        for (auto const &callback : mRefreshCallbacks)
-            callback();
+    /**
+     * \brief Cause all widgets to re-synchronize with the underlying variable state.
+     *
+     * Each getter is compared against the value that was last shown by its
+     * widget, and only widgets whose value changed are updated. Variables
+     * with a refresh interval (see \ref setRefreshInterval()) are only polled
+     * once the interval has elapsed since their last update.
+     *
+     * \param force
+     *     Poll all variables, regardless of their refresh interval.
+     *
+     * \return
+     *     The number of widgets that were updated.
+     */
+    int refresh(bool force = false) {
+        double now = glfwGetTime();
+        int updated = 0;
+        for (auto &binding : mBindings) {
+            if (!force && binding.interval != 0 &&
+                (binding.interval < 0 || now - binding.lastPoll < binding.interval))
+                continue;
+            binding.lastPoll = now;
+            updated += binding.update();
+        }
+        return updated;
+    }
+
+    /**
+     * \brief Re-synchronize the widget of a single variable right away.
+     *
+     * Intended for push-style updates: call this after modifying a variable
+     * whose widget has a long or negative refresh interval.
+     *
+     * \return
+     *     Whether the widget was updated.
+     */
+    bool notify(Widget *widget) {
+        for (auto &binding : mBindings) {
+            if (binding.widget != widget)
+                continue;
+            binding.lastPoll = glfwGetTime();
+            return binding.update() > 0;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Re-synchronize the widgets of a struct added by \ref addStruct()
+     * right away.
+     *
+     * \return
+     *     Whether any widget was updated.
+     */
+    bool notifyStruct(const void *object) {
+        for (auto &binding : mBindings) {
+            if (binding.object != object)
+                continue;
+            binding.lastPoll = glfwGetTime();
+            return binding.update() > 0;
+        }
+        return false;
+    }
+
+    /// The minimum number of seconds between two polls of newly added variables.
+    double refreshInterval() const { return mRefreshInterval; }
+
+    /**
+     * \brief Set the minimum number of seconds between two polls of newly
+     * added variables by \ref refresh().
+     *
+     * Zero (the default) polls on every call; a negative interval only
+     * updates the widget through \ref notify() or a forced refresh.
+     */
+    void setRefreshInterval(double seconds) { mRefreshInterval = seconds; }
+
+    /// Set the refresh interval of the variable shown by the given widget.
+    void setRefreshInterval(Widget *widget, double seconds) {
+        for (auto &binding : mBindings)
+            if (binding.widget == widget)
+                binding.interval = seconds;
+    }
+
+    /// Set the refresh interval of a struct added by \ref addStruct().
+    void setStructRefreshInterval(const void *object, double seconds) {
+        for (auto &binding : mBindings)
+            if (binding.object == object)
+                binding.interval = seconds;
     }
 
     /// Access the currently active \ref Window instance
@@ -267,6 +375,104 @@ public:
     void setWidgetFontSize(int value) { mWidgetFontSize = value; }
 
 protected:
+    /**
+     * \struct Binding formhelper.h nanogui/formhelper.h
+     *
+     * A variable exposed by the form and the widget showing it.
+     */
+    struct Binding {
+        /// The widget that shows the variable (``nullptr`` for structs)
+        Widget *widget;
+        /// The struct added by \ref addStruct() (``nullptr`` for single variables)
+        const void *object;
+        /// Pushes changed values into the widgets and returns the number of updated widgets
+        std::function<int()> update;
+        /// Minimum number of seconds between two polls (negative: push-only)
+        double interval;
+        /// Time of the last poll
+        double lastPoll;
+    };
+
+    /**
+     * \struct StructAdder formhelper.h nanogui/formhelper.h
+     *
+     * Creates the widget of each field of a struct (see \ref addStruct()).
+     */
+    template <typename T> struct StructAdder {
+        FormHelper *helper;
+        T *object;
+        std::shared_ptr<T> cache;
+        bool editable;
+        std::vector<Widget *> &widgets;
+
+        template <typename Type> void operator()(const Field<T, Type> &field) {
+            auto widget = helper->createVariableWidget<Type>(field.name, editable);
+            widget->setValue(field.get(*object));
+            T *target = object;
+            std::shared_ptr<T> copy = cache;
+            Type T::*member = field.member;
+            widget->setCallback([target, copy, member](const Type &value) {
+                (*copy).*member = value;
+                target->*member = value;
+            });
+            widgets.push_back(widget);
+        }
+    };
+
+    /**
+     * \struct StructUpdater formhelper.h nanogui/formhelper.h
+     *
+     * Pushes the changed fields of a struct into their widgets (see
+     * \ref addStruct()).
+     */
+    template <typename T> struct StructUpdater {
+        T *object;
+        std::shared_ptr<T> cache;
+        std::vector<Widget *> widgets;
+
+        struct Visitor {
+            const T &object;
+            T &cache;
+            Widget * const *widget;
+            int updated;
+
+            template <typename Type> void operator()(const Field<T, Type> &field) {
+                auto formWidget = static_cast<detail::FormWidget<Type> *>(*widget++);
+                const Type &value = field.get(object);
+                Type &cached = field.get(cache);
+                if (value == cached)
+                    return;
+                cached = value;
+                formWidget->setValue(value);
+                updated++;
+            }
+        };
+
+        int operator()() {
+            Visitor visitor { *object, *cache, widgets.data(), 0 };
+            forEachField<T>(visitor);
+            return visitor.updated;
+        }
+    };
+
+    /// Create a labeled data widget and append it to the layout.
+    template <typename Type> detail::FormWidget<Type> *
+    createVariableWidget(const std::string &label, bool editable) {
+        Label *labelW = new Label(mWindow, label, mLabelFontName, mLabelFontSize);
+        auto widget = new detail::FormWidget<Type>(mWindow);
+        widget->setEditable(editable);
+        widget->setFontSize(mWidgetFontSize);
+        Vector2i fs = widget->fixedSize();
+        widget->setFixedSize(Vector2i(fs.x() != 0 ? fs.x() : mFixedSize.x(),
+                                      fs.y() != 0 ? fs.y() : mFixedSize.y()));
+        if (mLayout->rowCount() > 0)
+            mLayout->appendRow(mVariableSpacing);
+        mLayout->appendRow(0);
+        mLayout->setAnchor(labelW, AdvancedGridLayout::Anchor(1, mLayout->rowCount()-1));
+        mLayout->setAnchor(widget, AdvancedGridLayout::Anchor(3, mLayout->rowCount()-1));
+        return widget;
+    }
+
     /// A reference to the \ref nanogui::Screen this FormHelper is assisting.
     ref<Screen> mScreen;
 
@@ -276,8 +482,11 @@ protected:
     /// A reference to the \ref nanogui::AdvancedGridLayout this FormHelper is using.
     ref<AdvancedGridLayout> mLayout;
 
-    /// The callbacks associated with all widgets this FormHelper is managing.
-    std::vector<std::function<void()>> mRefreshCallbacks;
+    /// The variables associated with all widgets this FormHelper is managing.
+    std::vector<Binding> mBindings;
+
+    /// The refresh interval for newly added variables.
+    double mRefreshInterval = 0;
 
     /// The group header font name.
     std::string mGroupFontName = "sans-bold";
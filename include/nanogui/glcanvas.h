@@ -20,6 +20,10 @@
 #include <nanogui/widget.h>
 #include <nanogui/opengl.h>
 #include <nanogui/glutil.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -31,8 +35,14 @@ NAMESPACE_BEGIN(nanogui)
  *
  * Canvas widget that can be used to display arbitrary OpenGL content. This is
  * useful to display and manipulate 3D objects as part of an interactive
- * application. The implementation uses scissoring to ensure that rendered
- * objects don't spill into neighboring widgets.
+ * application. The content is rendered into an offscreen target, which is
+ * then composited along with the other widgets. This ensures that rendered
+ * objects don't spill into neighboring widgets and keeps overlapping
+ * windows, popups and tooltips on top of the canvas.
+ *
+ * A canvas can optionally render on a dedicated thread (see
+ * \ref setThreaded()), in which case a slow \ref drawGL() no longer holds
+ * up the rest of the user interface.
  *
  * \rst
  * **Usage**
@@ -43,6 +53,30 @@ NAMESPACE_BEGIN(nanogui)
  */
 class NANOGUI_EXPORT GLCanvas : public Widget {
 public:
+    /**
+     * \struct FrameStats glcanvas.h nanogui/glcanvas.h
+     *
+     * \brief Frame pacing statistics of the render or user interface thread.
+     *
+     * Times are exponential moving averages in seconds.
+     */
+    struct FrameStats {
+        /// Number of frames produced (render thread) or composited (UI thread)
+        uint64_t frames = 0;
+
+        /// Number of rendered frames that were replaced before they could be displayed
+        uint64_t dropped = 0;
+
+        /// Average time between two consecutive frames
+        double frameTime = 0.0;
+
+        /// Average time spent in \ref drawGL() (render thread) or waiting for a new frame (UI thread)
+        double workTime = 0.0;
+
+        /// Average number of frames per second
+        double fps() const { return frameTime > 0.0 ? 1.0 / frameTime : 0.0; }
+    };
+
     /**
      * Creates a GLCanvas attached to the specified parent.
      *
@@ -51,11 +85,18 @@ public:
      */
     GLCanvas(Widget *parent);
 
+    /// Release the offscreen render target
+    virtual ~GLCanvas();
+
     /// Returns the background color.
     const Color &backgroundColor() const { return mBackgroundColor; }
 
     /// Sets the background color.
-    void setBackgroundColor(const Color &backgroundColor) { mBackgroundColor = backgroundColor; }
+    void setBackgroundColor(const Color &backgroundColor) {
+        std::lock_guard<std::mutex> guard(mThreadMutex);
+        mBackgroundColor = backgroundColor;
+        mSceneDirty = true;
+    }
 
     /// Set whether to draw the widget border or not.
     void setDrawBorder(const bool bDrawBorder) { mDrawBorder = bDrawBorder; }
@@ -63,12 +104,75 @@ public:
     /// Return whether the widget border gets drawn or not.
     const bool &drawBorder() const { return mDrawBorder; }
 
+    /**
+     * \brief Set whether the rendered scene is cached between frames.
+     *
+     * When enabled, \ref drawGL() only runs after \ref markSceneDirty() was
+     * called or when the size or pixel ratio of the canvas changed. All other
+     * frames composite the previous result, so redrawing unrelated widgets
+     * does not pay for re-rendering a static scene.
+     */
+    void setCacheScene(bool cacheScene) { mCacheScene = cacheScene; mSceneDirty = true; }
+
+    /// Return whether the rendered scene is cached between frames.
+    bool cacheScene() const { return mCacheScene; }
+
+    /// Request that \ref drawGL() is invoked again during the next frame.
+    void markSceneDirty() { mSceneDirty = true; }
+
+    /// Return whether the scene will be rendered again during the next frame.
+    bool sceneDirty() const { return mSceneDirty; }
+
+    /**
+     * \brief Render the scene on a dedicated thread.
+     *
+     * The thread owns an OpenGL context that shares objects with the
+     * screen's context and renders into a ring of ``bufferCount`` (2 or 3)
+     * offscreen targets. The user interface composites whichever frame was
+     * completed most recently and never waits for \ref drawGL(), so the
+     * remaining widgets stay responsive while the scene renders at its own
+     * pace. With two buffers, the render thread waits until each frame has
+     * been displayed; with three, it keeps going and older frames are dropped.
+     *
+     * In this mode \ref drawGL() is invoked on the render thread. Any state
+     * it shares with the user interface must be synchronized by the caller.
+     * Vertex array and framebuffer objects are not shared between contexts,
+     * so shaders must be created from within \ref drawGL() (e.g. on the first
+     * call) and released in \ref freeGL().
+     *
+     * Must be called on the thread that owns the screen's OpenGL context.
+     * Subclasses must call ``setThreaded(false)`` in their destructor (or
+     * earlier): the render thread invokes their \ref drawGL() and
+     * \ref freeGL() overrides, so it has to stop while they still exist.
+     * \ref freeGL() is then invoked on the calling thread with the render
+     * thread's context made current.
+     */
+    void setThreaded(bool threaded, int bufferCount = 3);
+
+    /// Return whether the scene is rendered on a dedicated thread.
+    bool threaded() const { return mThreaded; }
+
+    /// Return frame pacing statistics of the render thread.
+    FrameStats renderStats() const;
+
+    /// Return frame pacing statistics of the user interface thread.
+    FrameStats compositeStats() const;
+
     /// Draw the canvas.
     virtual void draw(NVGcontext *ctx) override;
 
-    /// Draw the GL scene. Override this method to draw the actual GL content.
+    /**
+     * \brief Draw the GL scene. Override this method to draw the actual GL content.
+     *
+     * This is invoked after all widgets have been traversed, with an
+     * offscreen framebuffer of the canvas' size (in hardware pixels) bound
+     * and the viewport set to cover it.
+     */
     virtual void drawGL() {}
 
+    /// Release OpenGL objects created by \ref drawGL() when the render thread shuts down (see \ref setThreaded()).
+    virtual void freeGL() {}
+
     /// Save the state of this GLCanvas to the specified Serializer.
     virtual void save(Serializer &s) const override;
 
@@ -79,6 +183,27 @@ protected:
     /// Internal helper function for drawing the widget border
     void drawWidgetBorder(NVGcontext* ctx) const;
 
+    /// Draw the child widgets above the canvas image (see \ref PrimitiveBatch::suspend())
+    void drawChildren(NVGcontext *ctx);
+
+    /// Render the GL scene into the offscreen target (deferred until the end of the frame)
+    void drawOffscreen();
+
+    /// Composite the newest frame produced by the render thread
+    void drawThreaded(NVGcontext *ctx, const Vector2i &size);
+
+    /// Create the shared context and start the render thread
+    void startThread();
+
+    /// Terminate the render thread and release its resources
+    void stopThread();
+
+    /// Main loop of the render thread
+    void renderThread();
+
+    /// Update a moving average with a new sample
+    static void updateStats(double &average, double sample, uint64_t count);
+
 protected:
     /// The background color (what is used with ``glClearColor``).
     Color mBackgroundColor;
@@ -86,6 +211,46 @@ protected:
     /// Whether to draw the widget border or not.
     bool mDrawBorder;
 
+    /// Offscreen target that receives the output of \ref drawGL().
+    GLRenderTarget mRenderTarget;
+
+    /// Whether the contents of the render target are reused across frames.
+    bool mCacheScene;
+
+    /// Whether the render target needs to be updated during the next frame.
+    bool mSceneDirty;
+
+    /// Pixel ratio that was used for the contents of the render target.
+    float mPixelRatio;
+
+    /**
+     * \struct Slot glcanvas.h nanogui/glcanvas.h
+     *
+     * An offscreen target owned by the render thread along with its fences.
+     */
+    struct Slot {
+        GLRenderTarget target;
+        GLsync ready = nullptr;   ///< Signaled when rendering has finished
+        GLsync released = nullptr; ///< Signaled when the UI has stopped sampling the texture
+    };
+
+    /// Whether threaded rendering is enabled.
+    bool mThreaded;
+
+    /// Hidden window providing the render thread's shared context.
+    GLFWwindow *mThreadWindow;
+
+    /// The render thread, its targets and their state (protected by \ref mThreadMutex).
+    std::thread mThread;
+    mutable std::mutex mThreadMutex;
+    std::condition_variable mThreadCond;
+    std::vector<std::unique_ptr<Slot>> mSlots;
+    int mDisplaySlot, mReadySlot, mSamples;
+    bool mThreadStop, mFrameRequested;
+    Vector2i mThreadSize;
+    FrameStats mRenderStats, mCompositeStats;
+    double mLastRenderTime, mLastCompositeTime;
+
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
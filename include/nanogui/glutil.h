@@ -15,6 +15,7 @@
 #include <nanogui/opengl.h>
 #include <Eigen/Geometry>
 #include <map>
+#include <cstring>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace half_float { class half; }
@@ -277,6 +278,9 @@ public:
     /// Initialize a uniform buffer with a uniform buffer object
     void setUniform(const std::string &name, const GLUniformBuffer &buf, bool warn = true);
 
+    /// Associate a named uniform block with a binding point (e.g. one used by \ref GLUniformRing::bind)
+    void setUniformBlockBinding(const std::string &name, int bindingPoint, bool warn = true);
+
     /// Return the size of all registered buffers in bytes
     size_t bufferSize() const {
         size_t size = 0;
@@ -328,7 +332,7 @@ protected:
 class NANOGUI_EXPORT GLUniformBuffer {
 public:
     /// Default constructor: unusable until you call the ``init()`` method
-    GLUniformBuffer() : mID(0), mBindingPoint(0) { }
+    GLUniformBuffer() : mID(0), mBindingPoint(0), mSize(0) { }
 
     /// Create a new uniform buffer
     void init();
@@ -343,13 +347,22 @@ public:
     void release();
 
     /// Update content on the GPU using data
-    void update(const std::vector<uint8_t> &data);
+    void update(const std::vector<uint8_t> &data) { update(data.data(), data.size()); }
+
+    /**
+     * \brief Update content on the GPU using data
+     *
+     * Storage is only re-specified when the size changes; otherwise the
+     * existing buffer is overwritten in place.
+     */
+    void update(const void *data, size_t size);
 
     /// Return the binding point of this uniform buffer
     int getBindingPoint() const { return mBindingPoint; }
 private:
     GLuint mID;
     int mBindingPoint;
+    size_t mSize;
 };
 
 //  ----------------------------------------------------
@@ -359,6 +372,10 @@ private:
  *
  * \brief Helper class for accumulating uniform buffer data following the
  *        'std140' packing format.
+ *
+ * Call ``clear()`` and refill the same instance to avoid reallocating
+ * memory every frame. For fixed layouts, \ref UniformLayoutStd140 computes
+ * all offsets at compile time and writes directly into mapped memory.
  */
 class UniformBufferStd140 : public std::vector<uint8_t> {
 public:
@@ -368,9 +385,8 @@ public:
 
     template <typename T, typename std::enable_if<std::is_pod<T>::value, int>::type = 0>
     void push_back(T value) {
-        uint8_t *tmp = (uint8_t*) &value;
-        for (int i = 0; i < sizeof(T); i++)
-            Parent::push_back(tmp[i]);
+        const uint8_t *tmp = (const uint8_t *) &value;
+        Parent::insert(Parent::end(), tmp, tmp + sizeof(T));
     }
 
     template <typename Derived, typename std::enable_if<Derived::IsVectorAtCompileTime, int>::type = 0>
@@ -402,6 +418,362 @@ public:
 
 //  ----------------------------------------------------
 
+// bypass template specializations
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+NAMESPACE_BEGIN(detail)
+
+constexpr size_t std140_align(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/* Size, alignment and writer for each type permitted in a std140 block */
+template <typename T> struct std140_traits;
+
+template <typename T> struct std140_scalar {
+    static constexpr size_t size() { return 4; }
+    static constexpr size_t align() { return 4; }
+    static void write(uint8_t *dst, const T &value) { memcpy(dst, &value, 4); }
+};
+template <> struct std140_traits<float> : std140_scalar<float> { };
+template <> struct std140_traits<int32_t> : std140_scalar<int32_t> { };
+template <> struct std140_traits<uint32_t> : std140_scalar<uint32_t> { };
+template <> struct std140_traits<bool> {
+    static constexpr size_t size() { return 4; }
+    static constexpr size_t align() { return 4; }
+    static void write(uint8_t *dst, bool value) {
+        int32_t tmp = value ? 1 : 0;
+        memcpy(dst, &tmp, 4);
+    }
+};
+
+template <typename Scalar, int N> struct std140_traits<Eigen::Matrix<Scalar, N, 1>> {
+    static_assert(sizeof(Scalar) == 4 && N >= 2 && N <= 4,
+                  "std140: only 2-4 component vectors with 32 bit components are supported");
+    static constexpr size_t size() { return N * 4; }
+    static constexpr size_t align() { return N == 2 ? 8 : 16; }
+    static void write(uint8_t *dst, const Eigen::Matrix<Scalar, N, 1> &value) {
+        memcpy(dst, value.data(), N * 4);
+    }
+};
+
+template <> struct std140_traits<Color> : std140_traits<Eigen::Vector4f> { };
+
+/* Matrices are stored as arrays of column vectors, each padded to a vec4 */
+template <int N> struct std140_traits<Eigen::Matrix<float, N, N>> {
+    static_assert(N >= 2 && N <= 4, "std140: unsupported matrix size");
+    static constexpr size_t size() { return N * 16; }
+    static constexpr size_t align() { return 16; }
+    static void write(uint8_t *dst, const Eigen::Matrix<float, N, N> &value) {
+        for (int i = 0; i < N; ++i)
+            memcpy(dst + i * 16, value.col(i).data(), N * 4);
+    }
+};
+
+template <size_t Offset, typename... Ts> struct std140_layout;
+
+template <size_t Offset> struct std140_layout<Offset> {
+    static constexpr size_t end() { return Offset; }
+    static void write(uint8_t *) { }
+};
+
+template <size_t Offset, typename T, typename... Ts> struct std140_layout<Offset, T, Ts...> {
+    static constexpr size_t offset() { return std140_align(Offset, std140_traits<T>::align()); }
+    using Next = std140_layout<offset() + std140_traits<T>::size(), Ts...>;
+    static constexpr size_t end() { return Next::end(); }
+    static void write(uint8_t *dst, const T &value, const Ts &... rest) {
+        std140_traits<T>::write(dst + offset(), value);
+        Next::write(dst, rest...);
+    }
+};
+
+template <size_t Index, typename Layout> struct std140_member {
+    using type = typename std140_member<Index - 1, typename Layout::Next>::type;
+};
+template <typename Layout> struct std140_member<0, Layout> { using type = Layout; };
+
+NAMESPACE_END(detail)
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * \struct UniformLayoutStd140 glutil.h nanogui/glutil.h
+ *
+ * \brief Compile-time description of a uniform block following the 'std140'
+ *        packing format.
+ *
+ * The template arguments list the members of the block in declaration order.
+ * Supported member types are ``float``, ``int32_t``, ``uint32_t``, ``bool``,
+ * 2-4 component vectors, \ref Color, and square ``float`` matrices.
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    // layout(std140) uniform Object { mat4 mvp; vec4 color; float time; };
+ *    using ObjectBlock = UniformLayoutStd140<Matrix4f, Color, float>;
+ *    ObjectBlock::write(ptr, mvp, color, time);
+ *
+ * \endrst
+ */
+template <typename... Ts> struct UniformLayoutStd140 {
+    using Layout = detail::std140_layout<0, Ts...>;
+
+    /// Size of the block in bytes (padded to a multiple of 16 bytes)
+    static constexpr size_t size() { return detail::std140_align(Layout::end(), 16); }
+
+    /// Byte offset of the member with the given index
+    template <size_t Index> static constexpr size_t offset() {
+        return detail::std140_member<Index, Layout>::type::offset();
+    }
+
+    /// Write all members to ``dst``, which must provide at least \ref size() bytes
+    static void write(uint8_t *dst, const Ts &... values) { Layout::write(dst, values...); }
+};
+
+//  ----------------------------------------------------
+
+/**
+ * \class GLUniformRing glutil.h nanogui/glutil.h
+ *
+ * \brief Streaming allocator that suballocates uniform blocks from a single
+ *        large ring buffer.
+ *
+ * Each allocation is aligned to ``GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT``,
+ * written through an unsynchronized mapping and bound with
+ * ``glBindBufferRange``, so per-draw uniform updates never cause the driver
+ * to reallocate storage. Call \ref fence() once per frame after issuing the
+ * draw calls that use the current allocations; memory is only reused after
+ * the GPU has passed the corresponding fence.
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    using ObjectBlock = UniformLayoutStd140<Matrix4f, Color>;
+ *    shader.setUniformBlockBinding("Object", 0);
+ *    for (auto &obj : objects) {
+ *        ring.bind(0, ring.write<ObjectBlock>(obj.mvp, obj.color));
+ *        shader.drawIndexed(GL_TRIANGLES, obj.offset, obj.count);
+ *    }
+ *    ring.fence();
+ *
+ * \endrst
+ */
+class NANOGUI_EXPORT GLUniformRing {
+public:
+    /// A region of the ring buffer
+    struct Range {
+        size_t offset;
+        size_t size;
+    };
+
+    /// Default constructor: unusable until you call the ``init()`` method
+    GLUniformRing()
+        : mID(0), mCapacity(0), mAlignment(256), mHead(0), mAllocated(0),
+          mReleased(0), mMapped(false) { }
+
+    /// Allocate a ring buffer with the given capacity in bytes
+    void init(size_t capacity = 4 * 1024 * 1024);
+
+    /// Release the underlying OpenGL objects
+    void free();
+
+    /// Return whether or not the ring has been initialized
+    bool ready() const { return mID != 0; }
+
+    /// Return the OpenGL name of the buffer object
+    GLuint buffer() const { return mID; }
+
+    /// Return the capacity of the ring in bytes
+    size_t capacity() const { return mCapacity; }
+
+    /// Return the offset alignment required by the OpenGL implementation
+    size_t alignment() const { return mAlignment; }
+
+    /**
+     * \brief Reserve ``size`` bytes and map them for writing.
+     *
+     * The returned pointer remains valid until \ref unmap() is called, which
+     * must happen before the block is used for drawing.
+     */
+    uint8_t *map(size_t size, Range &range);
+
+    /// Unmap the block returned by the last call to \ref map()
+    void unmap();
+
+    /// Copy ``size`` bytes into a new block
+    Range upload(const void *data, size_t size);
+
+    /// Write a block described by \ref UniformLayoutStd140 directly into the ring
+    template <typename Layout, typename... Args> Range write(const Args &... args) {
+        Range range;
+        uint8_t *ptr = map(Layout::size(), range);
+        Layout::write(ptr, args...);
+        unmap();
+        return range;
+    }
+
+    /// Bind a block to a uniform buffer binding point using ``glBindBufferRange``
+    void bind(int bindingPoint, const Range &range);
+
+    /// Mark the end of a frame: blocks allocated so far are recycled once the GPU passes this point
+    void fence();
+
+protected:
+    /// Wait for the oldest fence (or only check it if ``wait == false``)
+    bool retire(bool wait);
+
+    GLuint mID;
+    size_t mCapacity, mAlignment;
+    size_t mHead, mAllocated, mReleased;
+    bool mMapped;
+    std::vector<std::pair<GLsync, size_t>> mFences;
+};
+
+//  ----------------------------------------------------
+
+/**
+ * \class GLTexture glutil.h nanogui/glutil.h
+ *
+ * \brief Helper class for creating 2D textures with immutable storage.
+ *
+ * Storage for all mipmap levels is allocated once in ``init()``. Updates of
+ * arbitrary regions are staged through a pixel unpack buffer that is orphaned
+ * on every upload, so the caller never waits for the GPU to finish using the
+ * previous contents.
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    GLTexture texture;
+ *    texture.init<uint8_t>(Vector2i(512, 512), 4, 0);  // RGBA8, full mip chain
+ *    texture.update(pixels);
+ *    texture.generateMipmaps();
+ *    imageView->bindImage(texture.texture());
+ *
+ * \endrst
+ */
+class NANOGUI_EXPORT GLTexture {
+// this friendship breaks the documentation
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    template <typename T> friend struct detail::serialization_helper;
+#endif
+public:
+    /// Default constructor: unusable until you call the ``init()`` method
+    GLTexture()
+        : mID(0), mInternalFormat(0), mFormat(0), mType(0), mChannels(0),
+          mComponentSize(0), mLevels(0), mSize(Vector2i::Zero()), mPBO(0),
+          mPBOSize(0), mMapped(false), mMapLevel(0) { }
+
+    /**
+     * \brief Allocate storage for a texture with the given OpenGL internal format.
+     *
+     * \param levels
+     *     Number of mipmap levels. The value ``0`` allocates the full chain.
+     */
+    void init(const Vector2i &size, GLenum internalFormat, int levels = 1);
+
+    /**
+     * \brief Allocate storage for a texture whose texels consist of
+     * ``channels`` (1-4) components of type ``Scalar``.
+     *
+     * Integer components are sampled as normalized floating point values
+     * unless ``normalized`` is set to ``false``. 32 bit integer textures
+     * are always unnormalized.
+     */
+    template <typename Scalar>
+    void init(const Vector2i &size, int channels, int levels = 1, bool normalized = true) {
+        init(size, internalFormat((GLenum) detail::type_traits<Scalar>::type, channels,
+                                  normalized && detail::type_traits<Scalar>::integral),
+             levels);
+    }
+
+    /// Release all associated resources
+    void free();
+
+    /// Return whether or not the texture has been initialized
+    bool ready() const { return mID != 0; }
+
+    /// Return the OpenGL name of the texture
+    GLuint texture() const { return mID; }
+
+    /// Return the size of the base level
+    const Vector2i &size() const { return mSize; }
+
+    /// Return the size of the given mipmap level
+    Vector2i size(int level) const {
+        return Vector2i(std::max(1, mSize.x() >> level), std::max(1, mSize.y() >> level));
+    }
+
+    /// Return the number of mipmap levels
+    int levels() const { return mLevels; }
+
+    /// Return the number of channels per texel
+    int channels() const { return mChannels; }
+
+    /// Return the OpenGL internal format
+    GLenum internalFormat() const { return mInternalFormat; }
+
+    /// Return the OpenGL type of the components of the client-side data
+    GLenum type() const { return mType; }
+
+    /// Return the size of a single texel of the client-side data in bytes
+    size_t pixelSize() const { return (size_t) mChannels * (size_t) mComponentSize; }
+
+    /// Bind the texture to the given texture unit
+    void bind(int unit = 0);
+
+    /// Release/unbind the texture from the given texture unit
+    void release(int unit = 0);
+
+    /// Set the minification and magnification filters
+    void setFilter(GLenum minFilter, GLenum magFilter);
+
+    /// Set the wrap mode for both texture coordinates
+    void setWrap(GLenum wrap);
+
+    /// Upload the entire base level
+    void update(const void *data) { update(Vector2i::Zero(), mSize, data, 0); }
+
+    /// Upload a region of the given mipmap level (``data`` is tightly packed)
+    void update(const Vector2i &offset, const Vector2i &size, const void *data, int level = 0);
+
+    /**
+     * \brief Map staging memory for a region of the given mipmap level.
+     *
+     * The caller writes ``size.x() * size.y() * pixelSize()`` tightly packed
+     * bytes into the returned pointer and then calls \ref unmap() to start the
+     * transfer. This avoids the extra copy made by \ref update().
+     */
+    uint8_t *map(const Vector2i &offset, const Vector2i &size, int level = 0);
+
+    /// Transfer the region mapped by \ref map() into the texture
+    void unmap();
+
+    /// Regenerate mipmap levels 1 and above from the base level
+    void generateMipmaps();
+
+    /// Download the given mipmap level (stalls until the GPU has finished rendering)
+    void download(std::vector<uint8_t> &data, int level = 0) const;
+
+    /// Return the internal format for ``channels`` components of the given OpenGL type
+    static GLenum internalFormat(GLenum type, int channels, bool normalized);
+
+protected:
+    GLuint mID;
+    GLenum mInternalFormat, mFormat, mType;
+    int mChannels, mComponentSize, mLevels;
+    Vector2i mSize;
+    GLuint mPBO;
+    size_t mPBOSize;
+    bool mMapped;
+    Vector2i mMapOffset, mMapSize;
+    int mMapLevel;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//  ----------------------------------------------------
+
 /**
  * \class GLFramebuffer glutil.h nanogui/glutil.h
  *
@@ -433,7 +805,19 @@ public:
     /// Return the number of MSAA samples
     int samples() const { return mSamples; }
 
-    /// Quick and dirty method to write a TGA (32bpp RGBA) file of the framebuffer contents for debugging
+    /// Return the size of the framebuffer object
+    const Vector2i &size() const { return mSize; }
+
+    /// Return the OpenGL name of the framebuffer object
+    GLuint framebuffer() const { return mFramebuffer; }
+
+    /**
+     * \brief Quick and dirty method to write a TGA (32bpp RGBA) file of the
+     * framebuffer contents for debugging.
+     *
+     * This stalls until the GPU has finished rendering. Use \ref GLFrameCapture
+     * to record frames continuously.
+     */
     void downloadTGA(const std::string &filename);
 protected:
     GLuint mFramebuffer, mDepth, mColor;
@@ -445,6 +829,58 @@ public:
 
 //  ----------------------------------------------------
 
+/**
+ * \class GLRenderTarget glutil.h nanogui/glutil.h
+ *
+ * \brief Offscreen framebuffer whose color contents are resolved into a texture.
+ *
+ * Used by widgets that issue raw OpenGL draw calls: they render into a
+ * target from a callback registered with \ref Screen::deferGL() and then
+ * composite the resulting texture through NanoVG (see
+ * \ref Screen::textureImage()), so the frame needs a single NanoVG flush.
+ */
+class NANOGUI_EXPORT GLRenderTarget {
+public:
+    /// Default constructor: unusable until you call the ``init()`` method
+    GLRenderTarget() : mResolve(0) { }
+
+    /// Create a target of the given size with a depth/stencil buffer and ``nSamples`` MSAA samples
+    void init(const Vector2i &size, int nSamples);
+
+    /// Release all associated resources
+    void free();
+
+    /// Return whether or not the target has been initialized
+    bool ready() const { return mResolve != 0; }
+
+    /// Return the size of the target in pixels
+    const Vector2i &size() const { return mTexture.size(); }
+
+    /// Return the number of MSAA samples
+    int samples() const { return mFramebuffer.samples(); }
+
+    /// Bind the target for rendering and set the viewport to cover it
+    void bind();
+
+    /// Resolve the rendered contents into the texture and bind the default framebuffer
+    void release();
+
+    /// Return the texture which receives the resolved color contents
+    GLTexture &texture() { return mTexture; }
+
+    /// Return the texture which receives the resolved color contents
+    const GLTexture &texture() const { return mTexture; }
+
+protected:
+    GLFramebuffer mFramebuffer;
+    GLTexture mTexture;
+    GLuint mResolve;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//  ----------------------------------------------------
+
 /**
  * \struct Arcball glutil.h nanogui/glutil.h
  *
@@ -137,6 +137,7 @@ private:
     void updateImageParameters();
 
     // Helper drawing methods.
+    void drawOffscreen();
     void drawWidgetBorder(NVGcontext* ctx) const;
     void drawImageBorder(NVGcontext* ctx) const;
     void drawHelpers(NVGcontext* ctx) const;
@@ -150,6 +151,7 @@ private:
     GLShader mShader;
     GLuint mImageID;
     Vector2i mImageSize;
+    GLRenderTarget mRenderTarget;
 
     // Image display parameters.
     float mScale;
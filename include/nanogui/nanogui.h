@@ -15,6 +15,8 @@
 #include <nanogui/widget.h>
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
+#include <nanogui/primitives.h>
 #include <nanogui/window.h>
 #include <nanogui/layout.h>
 #include <nanogui/label.h>
@@ -28,12 +30,14 @@
 #include <nanogui/entypo.h>
 #include <nanogui/messagedialog.h>
 #include <nanogui/textbox.h>
+#include <nanogui/textarea.h>
 #include <nanogui/slider.h>
 #include <nanogui/imagepanel.h>
 #include <nanogui/imageview.h>
 #include <nanogui/vscrollpanel.h>
 #include <nanogui/colorwheel.h>
 #include <nanogui/graph.h>
+#include <nanogui/reflection.h>
 #include <nanogui/formhelper.h>
 #include <nanogui/stackedwidget.h>
 #include <nanogui/tabheader.h>
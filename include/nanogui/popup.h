@@ -38,12 +38,12 @@ public:
     const Vector2i &anchorPos() const { return mAnchorPos; }
 
     /// Set the anchor height; this determines the vertical shift relative to the anchor position
-    void setAnchorHeight(int anchorHeight) { mAnchorHeight = anchorHeight; }
+    void setAnchorHeight(int anchorHeight) { mAnchorHeight = anchorHeight; markDirty(); }
     /// Return the anchor height; this determines the vertical shift relative to the anchor position
     int anchorHeight() const { return mAnchorHeight; }
 
     /// Set the side of the parent window at which popup will appear
-    void setSide(Side popupSide) { mSide = popupSide; }
+    void setSide(Side popupSide) { mSide = popupSide; markDirty(); }
     /// Return the side of the parent window at which popup will appear
     Side side() const { return mSide; }
 
@@ -63,6 +63,8 @@ public:
 protected:
     /// Internal helper function to maintain nested window position values
     virtual void refreshRelativePlacement() override;
+    /// The layer also has to cover the anchor arrow
+    virtual int layerMargin() const override;
 
 protected:
     Window *mParentWindow;
@@ -0,0 +1,280 @@
+/*
+    nanogui/primitives.h -- Instanced signed-distance renderer for rounded
+    rectangles, circles and gradients
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/glutil.h>
+#include <functional>
+#include <array>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class PrimitiveBatch primitives.h nanogui/primitives.h
+ *
+ * \brief Batches rounded rectangles and circles into a single instanced draw call.
+ *
+ * Each primitive is rendered analytically from the signed distance to its
+ * outline, using the same antialiasing, gradient (linear, box and radial
+ * paints created by ``nvgLinearGradient()`` and friends), global alpha and
+ * scissoring rules as NanoVG. This avoids CPU tessellation and stencil
+ * passes for the shapes that make up most widgets.
+ *
+ * While a batch is active (see \ref Screen::setPrimitiveBatching()), the
+ * static drawing functions of this class record primitives instead of
+ * issuing NanoVG paths; otherwise they fall back to NanoVG. Widgets opt in
+ * by replacing e.g.
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    nvgBeginPath(ctx);
+ *    nvgRoundedRect(ctx, x, y, w, h, r);
+ *    nvgFillPaint(ctx, paint);
+ *    nvgFill(ctx);
+ *
+ * with
+ *
+ * .. code-block:: cpp
+ *
+ *    PrimitiveBatch::fillRoundedRect(ctx, x, y, w, h, r, paint);
+ *
+ * \endrst
+ *
+ * Within a top-level window, primitives are drawn beneath all NanoVG
+ * content. This is correct as long as no NanoVG shape is meant to be covered
+ * by a primitive, i.e. as long as backgrounds and frames are primitives and
+ * text, icons and images are NanoVG content. Widgets that paint NanoVG
+ * content beneath their children (e.g. \ref GLCanvas) must draw the children
+ * while recording is suspended (see \ref suspend()). The screen splits the
+ * frame only where top-level windows overlap (see \ref layer()), so that
+ * their stacking order is preserved without flushing once per window.
+ *
+ * Scissor rectangles that should apply to primitives must be set through
+ * \ref save(), \ref intersectScissor() and friends instead of the NanoVG
+ * functions. Only translations and uniform scaling of the NanoVG transform
+ * are supported.
+ */
+class NANOGUI_EXPORT PrimitiveBatch {
+public:
+    /// Default constructor: unusable until you call the ``init()`` method
+    PrimitiveBatch();
+
+    /// Compile the shader and allocate the instance buffer
+    void init();
+
+    /// Release all associated resources
+    void free();
+
+    /// Return whether or not the batch has been initialized
+    bool ready() const { return mInstanceBuffer != 0; }
+
+    /**
+     * \brief Start recording primitives for a NanoVG frame.
+     *
+     * \param ctx
+     *     The NanoVG context whose frame has just begun.
+     *
+     * \param size
+     *     Size of the frame in logical pixels (as passed to ``nvgBeginFrame()``).
+     *
+     * \param pixelRatio
+     *     Ratio between framebuffer and logical pixels.
+     *
+     * \param prepare
+     *     Optional callback that is invoked before the batch is flushed by
+     *     \ref split(), e.g. to run deferred OpenGL work of the frame so far.
+     */
+    void begin(NVGcontext *ctx, const Vector2i &size, float pixelRatio,
+               const std::function<void()> &prepare = std::function<void()>());
+
+    /// Draw all recorded primitives and stop recording (call right before ``nvgEndFrame()``)
+    void end();
+
+    /**
+     * \brief Flush the primitives and the NanoVG content recorded so far and
+     * start a new NanoVG frame.
+     *
+     * Used between overlapping top-level windows so that the primitives of a
+     * window are drawn above the NanoVG content of the windows behind it.
+     * Resets the NanoVG state stack and may therefore only be called at the
+     * top level.
+     */
+    void split();
+
+    /**
+     * \brief Start drawing a top-level widget covering the given rectangle
+     * (in the coordinates of the current NanoVG transform).
+     *
+     * Calls \ref split() if the rectangle overlaps one of the top-level
+     * widgets drawn since the last flush, and does nothing otherwise.
+     *
+     * \return
+     *     Whether the frame was split.
+     */
+    bool layer(float x, float y, float w, float h);
+
+    /// Return the number of primitives recorded since the last flush
+    size_t size() const { return mInstances.size(); }
+
+    /// Return the number of instanced draw calls issued since \ref begin()
+    int drawCalls() const { return mDrawCalls; }
+
+    /**
+     * \brief Record a textured rectangle, e.g. a slice of a \ref Skin atlas.
+     *
+     * \param texture
+     *     OpenGL texture with premultiplied alpha. Consecutive rectangles
+     *     that use the same texture share a draw call.
+     *
+     * \param uv
+     *     Texture coordinates of the top left and bottom right corners of
+     *     the rectangle (``u0, v0, u1, v1``).
+     */
+    void addTexture(GLuint texture, float x, float y, float w, float h,
+                    const float *uv);
+
+    /// Return the batch that is currently recording for the given context (or ``nullptr``)
+    static PrimitiveBatch *active(NVGcontext *ctx);
+
+    /**
+     * \brief Stop recording for the given context until \ref resume() is called.
+     *
+     * While suspended, the drawing functions issue NanoVG calls, which keeps
+     * them above the NanoVG content drawn before. Returns the suspended batch
+     * (or ``nullptr`` if none was recording).
+     */
+    static PrimitiveBatch *suspend(NVGcontext *ctx);
+
+    /// Resume recording after \ref suspend()
+    static void resume(PrimitiveBatch *batch);
+
+    /* Drawing functions: they record into the active batch of ``ctx`` if
+       there is one, and otherwise issue the equivalent NanoVG calls */
+
+    /// Fill a rounded rectangle with a paint (``nvgRoundedRect()`` + ``nvgFillPaint()`` + ``nvgFill()``)
+    static void fillRoundedRect(NVGcontext *ctx, float x, float y, float w,
+                                float h, float r, const NVGpaint &paint);
+
+    /// Fill a rounded rectangle with a solid color
+    static void fillRoundedRect(NVGcontext *ctx, float x, float y, float w,
+                                float h, float r, const NVGcolor &color);
+
+    /// Stroke the outline of a rounded rectangle with a paint
+    static void strokeRoundedRect(NVGcontext *ctx, float x, float y, float w,
+                                  float h, float r, float strokeWidth,
+                                  const NVGpaint &paint);
+
+    /// Stroke the outline of a rounded rectangle with a solid color
+    static void strokeRoundedRect(NVGcontext *ctx, float x, float y, float w,
+                                  float h, float r, float strokeWidth,
+                                  const NVGcolor &color);
+
+    /// Fill a circle with a paint
+    static void fillCircle(NVGcontext *ctx, float cx, float cy, float r,
+                           const NVGpaint &paint);
+
+    /// Fill a circle with a solid color
+    static void fillCircle(NVGcontext *ctx, float cx, float cy, float r,
+                           const NVGcolor &color);
+
+    /// Stroke the outline of a circle with a paint
+    static void strokeCircle(NVGcontext *ctx, float cx, float cy, float r,
+                             float strokeWidth, const NVGpaint &paint);
+
+    /// Stroke the outline of a circle with a solid color
+    static void strokeCircle(NVGcontext *ctx, float cx, float cy, float r,
+                             float strokeWidth, const NVGcolor &color);
+
+    /// Fill a rectangle except for a rounded rectangular hole (e.g. a drop shadow)
+    static void fillRectWithHole(NVGcontext *ctx, float x, float y, float w,
+                                 float h, float hx, float hy, float hw,
+                                 float hh, float hr, const NVGpaint &paint);
+
+    /// ``nvgSave()`` that also saves the scissor and alpha state of the active batch
+    static void save(NVGcontext *ctx);
+
+    /// ``nvgRestore()`` that also restores the scissor and alpha state of the active batch
+    static void restore(NVGcontext *ctx);
+
+    /// ``nvgIntersectScissor()`` that also applies to primitives of the active batch
+    static void intersectScissor(NVGcontext *ctx, float x, float y, float w, float h);
+
+    /// ``nvgResetScissor()`` that also applies to primitives of the active batch
+    static void resetScissor(NVGcontext *ctx);
+
+    /// ``nvgGlobalAlpha()`` that also applies to primitives of the active batch
+    static void globalAlpha(NVGcontext *ctx, float alpha);
+
+protected:
+    /**
+     * \struct Instance primitives.h nanogui/primitives.h
+     *
+     * Per-instance vertex data (framebuffer pixels, top left origin).
+     */
+    struct Instance {
+        /// Shape rectangle (x, y, w, h)
+        float shape[4];
+        /// Corner radius, stroke width (0: fill), hole radius, textured (0 or 1)
+        float params[4];
+        /// Rectangle of the hole (x, y, w, h); zero size if there is none
+        float hole[4];
+        /// Inverse paint transform: 2x2 matrix (column major), or the texture rectangle
+        float paintMat[4];
+        /// Inverse paint transform: translation, followed by the paint extent
+        float paintOffset[4];
+        /// Paint radius and feather, unused
+        float paintParams[4];
+        /// Premultiplied inner and outer paint colors
+        float innerColor[4], outerColor[4];
+        /// Scissor rectangle (x0, y0, x1, y1)
+        float scissor[4];
+    };
+
+    /**
+     * \struct State primitives.h nanogui/primitives.h
+     *
+     * Scissor and alpha state mirroring the NanoVG state stack.
+     */
+    struct State {
+        float scissor[4];
+        float alpha;
+    };
+
+    /// Record a primitive (coordinates refer to the current NanoVG transform)
+    void add(float x, float y, float w, float h, float r, float strokeWidth,
+             const float *hole, float holeRadius, const NVGpaint &paint);
+
+    /// Issue the instanced draw call for all recorded primitives
+    void flush();
+
+    /// Query the NanoVG transform, including the pixel ratio
+    void transform(float *xform) const;
+
+protected:
+    GLShader mShader;
+    GLuint mInstanceBuffer;
+    GLuint mTexture;
+    NVGcontext *mContext;
+    Vector2i mSize;
+    float mPixelRatio;
+    int mDrawCalls;
+    std::function<void()> mPrepare;
+    std::vector<Instance> mInstances;
+    std::vector<State> mStates;
+    std::vector<std::array<float, 4>> mLayers;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+NAMESPACE_END(nanogui)
@@ -14,63 +14,136 @@
 
 #include <nanogui/common.h>
 #include <pybind11/pybind11.h>
+#include <atomic>
 
-/// Provides a ``PYBIND11_OVERLOAD`` for any relevant Widget items that need to be bound.
+NAMESPACE_BEGIN(nanogui)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \class PyOverrides python.h nanogui/python.h
+ *
+ * \brief Remembers which virtual methods of a trampoline instance are
+ * overridden in Python.
+ *
+ * The first call of each method looks up the Python override (with the GIL
+ * held). Afterwards, methods without an override are dispatched straight to
+ * the C++ implementation, so that plain widgets created from Python neither
+ * acquire the GIL nor consult the interpreter while they are drawn or
+ * receive events. Overrides that are attached to an instance after the
+ * first call of a method are not noticed.
+ */
+class PyOverrides {
+public:
+    PyOverrides() : mCount(0) { }
+
+    /// Return whether the Python object wrapping ``self`` overrides the given method
+    template <typename T> bool has(const T *self, const char *name) {
+        int count = mCount.load(std::memory_order_acquire);
+        for (int i = 0; i < count; ++i)
+            if (mNames[i] == name)
+                return mOverridden[i];
+
+        pybind11::gil_scoped_acquire gil;
+        count = mCount.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; ++i)
+            if (mNames[i] == name)
+                return mOverridden[i];
+        /* Unlike pybind11::get_overload(), ignore the calling frame so that
+           a ``super()`` call from within the override is not cached */
+        pybind11::object obj = pybind11::cast(self, pybind11::return_value_policy::reference);
+        pybind11::function overload = pybind11::getattr(obj, name, pybind11::function());
+        bool overridden = overload && !overload.is_cpp_function();
+        if (count == Capacity)
+            return true; /* Uncached: let PYBIND11_OVERLOAD decide */
+        mNames[count] = name;
+        mOverridden[count] = overridden;
+        mCount.store(count + 1, std::memory_order_release);
+        return overridden;
+    }
+
+private:
+    static const int Capacity = 24;
+    const char *mNames[Capacity];
+    bool mOverridden[Capacity];
+    std::atomic<int> mCount;
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(nanogui)
+
+/**
+ * \brief ``PYBIND11_OVERLOAD`` that calls the C++ implementation directly
+ * unless the method is overridden in Python (see \ref nanogui::detail::PyOverrides).
+ *
+ * Requires an ``mPyOverrides`` member, as declared by
+ * ``NANOGUI_WIDGET_OVERLOADS`` and ``NANOGUI_LAYOUT_OVERLOADS``.
+ */
+#define NANOGUI_OVERLOAD(ret_type, Parent, fn, ...) \
+    if (!mPyOverrides.has(static_cast<const Parent *>(this), #fn)) \
+        return Parent::fn(__VA_ARGS__); \
+    PYBIND11_OVERLOAD(ret_type, Parent, fn, __VA_ARGS__)
+
+/// Provides a ``NANOGUI_OVERLOAD`` for any relevant Widget items that need to be bound.
 #define NANOGUI_WIDGET_OVERLOADS(Parent) \
+    mutable ::nanogui::detail::PyOverrides mPyOverrides; \
     bool mouseButtonEvent(const ::nanogui::Vector2i &p, int button, bool down, int modifiers) { \
-        PYBIND11_OVERLOAD(bool, Parent, mouseButtonEvent, p, button, down, modifiers); \
+        NANOGUI_OVERLOAD(bool, Parent, mouseButtonEvent, p, button, down, modifiers); \
     } \
     bool mouseMotionEvent(const ::nanogui::Vector2i &p, const ::nanogui::Vector2i &rel, int button, int modifiers) { \
-        PYBIND11_OVERLOAD(bool, Parent, mouseMotionEvent, p, rel, button, modifiers); \
+        NANOGUI_OVERLOAD(bool, Parent, mouseMotionEvent, p, rel, button, modifiers); \
     } \
     bool mouseDragEvent(const ::nanogui::Vector2i &p, const ::nanogui::Vector2i &rel, int button, int modifiers) { \
-        PYBIND11_OVERLOAD(bool, Parent, mouseDragEvent, p, rel, button, modifiers); \
+        NANOGUI_OVERLOAD(bool, Parent, mouseDragEvent, p, rel, button, modifiers); \
     } \
     bool mouseEnterEvent(const ::nanogui::Vector2i &p, bool enter) { \
-        PYBIND11_OVERLOAD(bool, Parent, mouseEnterEvent, p, enter); \
+        NANOGUI_OVERLOAD(bool, Parent, mouseEnterEvent, p, enter); \
     } \
     bool scrollEvent(const ::nanogui::Vector2i &p, const ::nanogui::Vector2f &rel) { \
-        PYBIND11_OVERLOAD(bool, Parent, scrollEvent, p, rel); \
+        NANOGUI_OVERLOAD(bool, Parent, scrollEvent, p, rel); \
     } \
     bool focusEvent(bool focused) { \
-        PYBIND11_OVERLOAD(bool, Parent, focusEvent, focused); \
+        NANOGUI_OVERLOAD(bool, Parent, focusEvent, focused); \
     } \
     bool keyboardEvent(int key, int scancode, int action, int modifiers) { \
-        PYBIND11_OVERLOAD(bool, Parent, keyboardEvent, key, scancode, action, modifiers); \
+        NANOGUI_OVERLOAD(bool, Parent, keyboardEvent, key, scancode, action, modifiers); \
     } \
     bool keyboardCharacterEvent(unsigned int codepoint) { \
-        PYBIND11_OVERLOAD(bool, Parent, keyboardCharacterEvent, codepoint); \
+        NANOGUI_OVERLOAD(bool, Parent, keyboardCharacterEvent, codepoint); \
     } \
     ::nanogui::Vector2i preferredSize(NVGcontext *ctx) const { \
-        PYBIND11_OVERLOAD(::nanogui::Vector2i, Parent, preferredSize, ctx); \
+        NANOGUI_OVERLOAD(::nanogui::Vector2i, Parent, preferredSize, ctx); \
     } \
     void performLayout(NVGcontext *ctx) { \
-        PYBIND11_OVERLOAD(void, Parent, performLayout, ctx); \
+        NANOGUI_OVERLOAD(void, Parent, performLayout, ctx); \
     } \
     void draw(NVGcontext *ctx) { \
-        PYBIND11_OVERLOAD(void, Parent, draw, ctx); \
+        NANOGUI_OVERLOAD(void, Parent, draw, ctx); \
     }
 
-/// Provides a ``PYBIND11_OVERLOAD`` for any relevant Layout items that need to be bound.
+/// Provides a ``NANOGUI_OVERLOAD`` for any relevant Layout items that need to be bound.
 #define NANOGUI_LAYOUT_OVERLOADS(Parent) \
+    mutable ::nanogui::detail::PyOverrides mPyOverrides; \
     ::nanogui::Vector2i preferredSize(NVGcontext *ctx, const ::nanogui::Widget *widget) const { \
-        PYBIND11_OVERLOAD(::nanogui::Vector2i, Parent, preferredSize, ctx, widget); \
+        NANOGUI_OVERLOAD(::nanogui::Vector2i, Parent, preferredSize, ctx, widget); \
     } \
     void performLayout(NVGcontext *ctx, ::nanogui::Widget *widget) const { \
-        PYBIND11_OVERLOAD(void, Parent, performLayout, ctx, widget); \
+        NANOGUI_OVERLOAD(void, Parent, performLayout, ctx, widget); \
     }
 
-/// Provides a ``PYBIND11_OVERLOAD`` for any relevant Screen items that need to be bound.
+/**
+ * \brief Provides a ``NANOGUI_OVERLOAD`` for any relevant Screen items that
+ * need to be bound (in addition to ``NANOGUI_WIDGET_OVERLOADS``).
+ */
 #define NANOGUI_SCREEN_OVERLOADS(Parent) \
     virtual void drawAll() { \
-        PYBIND11_OVERLOAD(void, Parent, drawAll); \
+        NANOGUI_OVERLOAD(void, Parent, drawAll); \
     } \
     virtual void drawContents() { \
-        PYBIND11_OVERLOAD(void, Parent, drawContents); \
+        NANOGUI_OVERLOAD(void, Parent, drawContents); \
     } \
     virtual bool dropEvent(const std::vector<std::string> &filenames) { \
-        PYBIND11_OVERLOAD(bool, Parent, dropEvent, filenames); \
+        NANOGUI_OVERLOAD(bool, Parent, dropEvent, filenames); \
     } \
     virtual bool resizeEvent(const ::nanogui::Vector2i &size) { \
-        PYBIND11_OVERLOAD(bool, Parent, resizeEvent, size); \
+        NANOGUI_OVERLOAD(bool, Parent, resizeEvent, size); \
     }
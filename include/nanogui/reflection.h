@@ -0,0 +1,176 @@
+/*
+    nanogui/reflection.h -- Compile-time description of the fields of a struct
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <tuple>
+#include <type_traits>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \struct Field reflection.h nanogui/reflection.h
+ *
+ * \brief Name and member pointer of a field of a reflected struct (see
+ * \ref NANOGUI_REFLECT).
+ *
+ * \tparam Class
+ *     The struct containing the field.
+ *
+ * \tparam Type
+ *     The type of the field.
+ */
+template <typename Class, typename Type> struct Field {
+    /// The type of the field
+    using type = Type;
+
+    /// The name of the field (as written in the struct declaration)
+    const char *name;
+
+    /// Pointer to the field
+    Type Class::*member;
+
+    constexpr Field(const char *name, Type Class::*member)
+        : name(name), member(member) { }
+
+    /// Access the field of an object
+    Type &get(Class &object) const { return object.*member; }
+
+    /// Access the field of an object
+    const Type &get(const Class &object) const { return object.*member; }
+};
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \struct is_reflected reflection.h nanogui/reflection.h
+ *
+ * \brief Detects whether the fields of a type were declared with
+ * \ref NANOGUI_REFLECT.
+ */
+template <typename T> struct is_reflected {
+private:
+    template <typename U> static std::true_type test(decltype(nanoguiFields((const U *) nullptr)) *);
+    template <typename U> static std::false_type test(...);
+public:
+    static constexpr bool value = decltype(test<T>(nullptr))::value;
+};
+
+// bypass template recursion for now
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <size_t Index, typename Tuple, typename Func>
+typename std::enable_if<Index == std::tuple_size<Tuple>::value>::type
+visitFields(const Tuple &, Func &) { }
+
+template <size_t Index, typename Tuple, typename Func>
+typename std::enable_if<Index < std::tuple_size<Tuple>::value>::type
+visitFields(const Tuple &fields, Func &func) {
+    func(std::get<Index>(fields));
+    visitFields<Index + 1>(fields, func);
+}
+#endif
+
+NAMESPACE_END(detail)
+
+/// Return the tuple of \ref Field descriptions of a reflected struct
+template <typename T> auto fields() -> decltype(nanoguiFields((const T *) nullptr)) {
+    return nanoguiFields((const T *) nullptr);
+}
+
+/**
+ * \brief Invoke a function object on the \ref Field description of every
+ * field of a reflected struct, in declaration order.
+ *
+ * The function object must accept ``const Field<T, Type> &`` for each field
+ * type (e.g. by a templated ``operator()``). The loop is unrolled at compile
+ * time, so every call is made with the static type of the field.
+ */
+template <typename T, typename Func> void forEachField(Func &func) {
+    detail::visitFields<0>(fields<T>(), func);
+}
+
+NAMESPACE_END(nanogui)
+
+// bypass the macro machinery for now
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#define NANOGUI_REFLECT_EXPAND(x) x
+#define NANOGUI_REFLECT_CAT(a, b) NANOGUI_REFLECT_CAT2(a, b)
+#define NANOGUI_REFLECT_CAT2(a, b) a ## b
+#define NANOGUI_REFLECT_FIELD(Class, name) \
+    ::nanogui::Field<Class, decltype(Class::name)>(#name, &Class::name)
+#define NANOGUI_REFLECT_1(C, a) NANOGUI_REFLECT_FIELD(C, a)
+#define NANOGUI_REFLECT_2(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_1(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_3(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_2(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_4(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_3(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_5(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_4(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_6(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_5(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_7(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_6(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_8(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_7(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_9(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_8(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_10(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_9(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_11(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_10(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_12(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_11(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_13(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_12(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_14(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_13(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_15(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_14(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_16(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_15(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_17(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_16(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_18(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_17(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_19(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_18(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_20(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_19(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_21(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_20(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_22(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_21(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_23(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_22(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_24(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_23(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_25(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_24(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_26(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_25(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_27(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_26(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_28(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_27(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_29(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_28(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_30(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_29(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_31(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_30(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_32(C, a, ...) NANOGUI_REFLECT_FIELD(C, a), NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_31(C, __VA_ARGS__))
+#define NANOGUI_REFLECT_ARG_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define NANOGUI_REFLECT_COUNT(...) \
+    NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_ARG_N(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define NANOGUI_REFLECT_FIELDS(Class, ...) \
+    NANOGUI_REFLECT_EXPAND(NANOGUI_REFLECT_CAT(NANOGUI_REFLECT_, NANOGUI_REFLECT_COUNT(__VA_ARGS__))(Class, __VA_ARGS__))
+#endif
+
+/**
+ * \brief Declare the fields of a struct for \ref FormHelper::addStruct() and
+ * the \ref Serializer.
+ *
+ * Place the macro behind the struct declaration, in the same namespace (the
+ * field list is found by argument-dependent lookup). Up to 32 public fields
+ * can be listed. The serializer also stores fields that are themselves
+ * reflected structs (as nested records).
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    struct Settings {
+ *        int iterations;
+ *        float scale;
+ *        std::string name;
+ *    };
+ *
+ *    NANOGUI_REFLECT(Settings, iterations, scale, name)
+ *
+ * \endrst
+ */
+#define NANOGUI_REFLECT(Class, ...) \
+    inline auto nanoguiFields(const Class *) \
+        -> decltype(std::make_tuple(NANOGUI_REFLECT_FIELDS(Class, __VA_ARGS__))) { \
+        return std::make_tuple(NANOGUI_REFLECT_FIELDS(Class, __VA_ARGS__)); \
+    }
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <map>
+#include <tuple>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -113,6 +115,57 @@ public:
     /// Return the ratio between pixel and device coordinates (e.g. >= 2 on Mac Retina displays)
     float pixelRatio() const { return mPixelRatio; }
 
+    /// Return the size of the framebuffer in hardware pixels
+    const Vector2i &framebufferSize() const { return mFBSize; }
+
+    /**
+     * \brief Record every frame drawn by \ref drawAll() using the given capture object.
+     *
+     * The back buffer is read back asynchronously right before it is
+     * presented. The capture object is resized automatically when the
+     * framebuffer size changes. Pass ``nullptr`` to stop recording.
+     */
+    void setFrameCapture(GLFrameCapture *capture) { mFrameCapture = capture; }
+
+    /// Return the capture object used to record frames (if any)
+    GLFrameCapture *frameCapture() { return mFrameCapture; }
+
+    /**
+     * \brief Draw rounded rectangles, circles and gradients of widgets with
+     * a single instanced draw call per top-level window.
+     *
+     * Widgets that draw through the static functions of \ref PrimitiveBatch
+     * (e.g. \ref Window, \ref Button, \ref CheckBox, \ref Slider and
+     * \ref ProgressBar) then no longer tessellate these shapes with NanoVG.
+     * Disabled by default.
+     */
+    void setPrimitiveBatching(bool primitiveBatching) { mPrimitiveBatching = primitiveBatching; }
+
+    /// Return whether widget primitives are drawn by an instanced renderer
+    bool primitiveBatching() const { return mPrimitiveBatching; }
+
+    /**
+     * \brief Queue a callback that issues raw OpenGL draw calls.
+     *
+     * Must be called from within a widget's ``draw()`` method. The callbacks
+     * run after all widgets have been traversed and before NanoVG flushes
+     * its command buffer, so mixing OpenGL content with widgets does not
+     * split the frame into several NanoVG batches. Callbacks should render
+     * into an offscreen target (e.g. \ref GLRenderTarget) that is composited
+     * through \ref textureImage(). The default framebuffer and viewport are
+     * restored afterwards.
+     */
+    void deferGL(const std::function<void()> &callback) { mDeferredGL.push_back(callback); }
+
+    /**
+     * \brief Return a NanoVG image handle referring to an existing OpenGL texture.
+     *
+     * Handles are cached and released automatically once the texture has
+     * not been requested during a full frame. The texture is not owned by
+     * NanoVG. Only valid while drawing.
+     */
+    int textureImage(uint32_t texture, const Vector2i &size, int imageFlags = 0);
+
     /// Handle a file drop event
     virtual bool dropEvent(const std::vector<std::string> & /* filenames */) { return false; /* To be overridden */ }
 
@@ -132,6 +185,9 @@ public:
     /// Return the last observed mouse position value
     Vector2i mousePos() const { return mMousePos; }
 
+    /// Return the time (see \c glfwGetTime()) of the most recent user interaction
+    double lastInteraction() const { return mLastInteraction; }
+
     /// Return a pointer to the underlying GLFW window data structure
     GLFWwindow *glfwWindow() { return mGLFWWindow; }
 
@@ -184,6 +240,22 @@ public:
     void moveWindowToFront(Window *window);
     void drawWidgets();
 
+protected:
+    /// Run the callbacks queued by \ref deferGL()
+    void runDeferredGL();
+
+    /// Re-render outdated retained caches (see \ref Widget::setCached()) in the given subtree
+    void updateCaches(Widget *widget);
+
+    /// Regenerate outdated skins (see \ref Theme::setSkin()) of the themes of this screen
+    void updateSkins();
+
+    /// Release the skins of all themes while the OpenGL context still exists
+    void freeSkins();
+
+    /// Invalidate the caches containing the widget at the given position
+    void markDirtyAt(const Vector2i &p);
+
 protected:
     GLFWwindow *mGLFWWindow;
     NVGcontext *mNVGContext;
@@ -203,6 +275,11 @@ protected:
     bool mShutdownGLFWOnDestruct;
     bool mFullscreen;
     std::function<void(Vector2i)> mResizeCallback;
+    GLFrameCapture *mFrameCapture = nullptr;
+    bool mPrimitiveBatching = false;
+    PrimitiveBatch *mPrimitives = nullptr;
+    std::vector<std::function<void()>> mDeferredGL;
+    std::map<std::tuple<uint32_t, int, int, int>, std::pair<int, bool>> mTextureImages;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/reflection.h>
 #include <unordered_map>
 #include <fstream>
 #include <memory>
@@ -35,6 +36,7 @@ NAMESPACE_BEGIN(detail)
  * \endrst
  */
 template <typename T> struct serialization_helper;
+template <typename T> struct serialization_raw;
 NAMESPACE_END(detail)
 
 /**
@@ -49,6 +51,10 @@ NAMESPACE_END(detail)
  * sparse and dense Eigen matrices, as well as OpenGL shaders and buffer
  * objects.
  *
+ * Structs whose fields were declared with \ref NANOGUI_REFLECT are stored
+ * as a single record: one entry in the table of contents, followed by the
+ * fields in declaration order.
+ *
  * Note that this header file just provides the basics; the files
  * ``nanogui/serializer/opengl.h``, and ``nanogui/serializer/sparse.h`` must
  * be included to serialize the respective data types.
@@ -58,6 +64,7 @@ protected:
 // this friendship breaks the documentation
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     template <typename T> friend struct detail::serialization_helper;
+    template <typename T> friend struct detail::serialization_raw;
 #endif
 
 public:
@@ -171,7 +178,7 @@ template <typename T> struct serialization_traits<T> :
     serialization_traits<typename std::underlying_type<T>::type,
                          typename std::enable_if<std::is_enum<T>::value>::type> { };
 
-template <typename T> struct serialization_helper {
+template <typename T> struct serialization_raw {
     static std::string type_id() { return serialization_traits<T>().type_id; }
 
     static void write(Serializer &s, const T *value, size_t count) {
@@ -183,6 +190,57 @@ template <typename T> struct serialization_helper {
     }
 };
 
+template <typename T> struct serialization_record {
+    struct TypeId {
+        std::string result;
+        template <typename Type> void operator()(const Field<T, Type> &field) {
+            result += std::string(field.name) + ":" +
+                serialization_helper<Type>::type_id() + ";";
+        }
+    };
+
+    struct Writer {
+        Serializer &s;
+        const T *value;
+        template <typename Type> void operator()(const Field<T, Type> &field) {
+            serialization_helper<Type>::write(s, &field.get(*value), 1);
+        }
+    };
+
+    struct Reader {
+        Serializer &s;
+        T *value;
+        template <typename Type> void operator()(const Field<T, Type> &field) {
+            serialization_helper<Type>::read(s, &field.get(*value), 1);
+        }
+    };
+
+    static std::string type_id() {
+        TypeId typeId;
+        forEachField<T>(typeId);
+        return "R{" + typeId.result + "}";
+    }
+
+    static void write(Serializer &s, const T *value, size_t count) {
+        for (size_t i = 0; i<count; ++i) {
+            Writer writer { s, value++ };
+            forEachField<T>(writer);
+        }
+    }
+
+    static void read(Serializer &s, T *value, size_t count) {
+        for (size_t i = 0; i<count; ++i) {
+            Reader reader { s, value++ };
+            forEachField<T>(reader);
+        }
+    }
+};
+
+template <typename T> struct serialization_helper
+    : public std::conditional<is_reflected<T>::value,
+                              serialization_record<T>,
+                              serialization_raw<T>>::type { };
+
 template <> struct serialization_helper<std::string> {
     static std::string type_id() { return "Vc8"; }
 
@@ -1,5 +1,5 @@
 /*
-    nanogui/serializer/opengl.h -- serialization support for OpenGL buffers
+    nanogui/serializer/opengl.h -- serialization support for OpenGL buffers and textures
 
     NanoGUI was developed by Wenzel Jakob <wenzel@inf.ethz.ch>.
     The widget drawing code is based on the NanoVG demo application
@@ -113,6 +113,60 @@ struct serialization_helper<GLShader> {
     }
 };
 
+template<>
+struct serialization_helper<GLTexture> {
+    static std::string type_id() {
+        return "T";
+    }
+
+    static void write(Serializer &s, const GLTexture *value, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (count > 1)
+                s.push(std::to_string(i));
+            s.set("internalFormat", (uint32_t) value->mInternalFormat);
+            s.set("size", value->mSize);
+            s.set("levels", value->mLevels);
+            std::vector<uint8_t> temp;
+            for (int level = 0; level < value->mLevels; ++level) {
+                value->download(temp, level);
+                s.set("level" + std::to_string(level), temp);
+            }
+            if (count > 1)
+                s.pop();
+            ++value;
+        }
+    }
+
+    static void read(Serializer &s, GLTexture *value, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (count > 1)
+                s.push(std::to_string(i));
+            uint32_t internalFormat;
+            Vector2i size;
+            int levels;
+            s.get("internalFormat", internalFormat);
+            s.get("size", size);
+            s.get("levels", levels);
+
+            if (!value->ready() || value->mInternalFormat != internalFormat ||
+                value->mSize != size || value->mLevels != levels)
+                value->init(size, (GLenum) internalFormat, levels);
+
+            std::vector<uint8_t> temp;
+            for (int level = 0; level < levels; ++level) {
+                s.get("level" + std::to_string(level), temp);
+                Vector2i levelSize = value->size(level);
+                if (temp.size() != (size_t) levelSize.prod() * value->pixelSize())
+                    throw std::runtime_error("GLTexture: size mismatch in serialized data!");
+                value->update(Vector2i::Zero(), levelSize, temp.data(), level);
+            }
+            if (count > 1)
+                s.pop();
+            ++value;
+        }
+    }
+};
+
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 NAMESPACE_END(detail)
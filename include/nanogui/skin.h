@@ -0,0 +1,143 @@
+/*
+    nanogui/skin.h -- Pre-rendered nine-slice atlas of theme elements
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/glutil.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class Skin skin.h nanogui/skin.h
+ *
+ * \brief Nine-slice texture atlas of frequently drawn theme elements.
+ *
+ * Drop shadows, window frames, buttons, text boxes and scroll bars are built
+ * from box and linear gradients, which NanoVG evaluates per pixel (the drop
+ * shadows additionally require a stencil pass). A skin renders each of these
+ * elements once into a texture atlas and afterwards draws them as nine
+ * textured rectangles: the corners are copied verbatim, while the edges and
+ * the center are stretched. With primitive batching enabled (see
+ * \ref Screen::setPrimitiveBatching()), the rectangles are part of the
+ * instanced draw call of the \ref PrimitiveBatch; otherwise each of them is
+ * a NanoVG image fill. The atlas is regenerated only when a relevant color
+ * or size of the \ref Theme or the pixel ratio changes.
+ *
+ * The result matches the vector rendering exactly, except for the vertical
+ * gradient of buttons, which is stretched along with the button.
+ *
+ * \rst
+ * **Usage**
+ *
+ * .. code-block:: cpp
+ *
+ *    screen->theme()->setSkin(new Skin());
+ *
+ * \endrst
+ *
+ * Each theme should use its own skin instance. The \ref Screen keeps the
+ * skins of all themes created for its NanoVG context up to date before
+ * drawing.
+ */
+class NANOGUI_EXPORT Skin : public Object {
+public:
+    /// Elements contained in the atlas
+    enum class Element {
+        WindowShadow = 0,  ///< Drop shadow of a \ref Window or \ref Popup (covers the margin only)
+        WindowFill,        ///< Background of an unfocused \ref Window
+        WindowFillFocused, ///< Background of a \ref Window that has the mouse focus
+        WindowHeader,      ///< Title bar of a \ref Window (without the title)
+        ButtonNormal,      ///< Background and border of a \ref Button
+        ButtonFocused,     ///< Background and border of a \ref Button that has the mouse focus
+        ButtonPushed,      ///< Background and border of a pushed \ref Button
+        TextBoxNormal,     ///< Background and border of a \ref TextBox
+        TextBoxFocused,    ///< Background and border of a \ref TextBox that is being edited
+        TextBoxInvalid,    ///< Background and border of a \ref TextBox with invalid contents
+        ScrollTrack,       ///< Track of a \ref VScrollPanel scroll bar
+        ScrollThumb,       ///< Thumb of a \ref VScrollPanel scroll bar
+        ElementCount
+    };
+
+    /// Create an empty skin (it is populated by the first call to \ref update())
+    Skin();
+
+    /// Regenerate the atlas if the theme or the pixel ratio of the screen changed
+    void update(Screen *screen, const Theme *theme);
+
+    /// Release the atlas texture (called by the \ref Screen before its context is destroyed)
+    void free();
+
+    /// Return whether or not the atlas is available for drawing
+    bool ready() const { return mImage != 0; }
+
+    /// Return the number of times the atlas has been rendered so far
+    int generation() const { return mGeneration; }
+
+    /**
+     * \brief Draw an element of the atlas.
+     *
+     * The rectangle refers to the widget, i.e. a drop shadow is drawn around
+     * it. The slice boundaries are snapped to device pixels, which assumes
+     * that the current transform is an integer translation.
+     *
+     * \return
+     *     ``false`` if the atlas is not available, in which case the caller
+     *     should fall back to regular NanoVG drawing.
+     */
+    bool draw(NVGcontext *ctx, Element element, float x, float y, float w,
+              float h) const;
+
+protected:
+    /// Destructor: releases the atlas texture
+    virtual ~Skin();
+
+    /// Collect all theme values that affect the atlas contents
+    void signature(const Theme *theme, std::vector<float> &result) const;
+
+    /// Assign atlas positions to all elements for the given theme
+    Vector2i layout(const Theme *theme);
+
+    /// Render a single element at the origin of its cell
+    void renderElement(NVGcontext *ctx, const Theme *theme, Element element,
+                       float w, float h) const;
+
+    /**
+     * \struct Cell skin.h nanogui/skin.h
+     *
+     * Placement of an element within the atlas (in logical pixels).
+     */
+    struct Cell {
+        /// Top left corner of the element rectangle within the atlas
+        Vector2f pos;
+        /// Size of the element rectangle
+        Vector2f size;
+        /// Size of the corner slices within the element rectangle
+        Vector2f inset;
+        /// Extent of the element beyond its rectangle (e.g. a drop shadow)
+        float margin;
+        /// Whether the center slice is empty and can be skipped
+        bool hollow;
+    };
+
+    Cell mCells[(int) Element::ElementCount];
+    std::vector<float> mSignature;
+    GLRenderTarget mTarget;
+    Vector2i mAtlasSize;
+    float mPixelRatio;
+    int mImage;
+    int mGeneration;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+NAMESPACE_END(nanogui)
@@ -16,9 +16,66 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <functional>
 
 NAMESPACE_BEGIN(nanogui)
 
+/**
+ * \class LazyPage stackedwidget.h nanogui/stackedwidget.h
+ *
+ * \brief A page of a \ref StackedWidget whose contents are created on demand.
+ *
+ * The factory is invoked to populate the page right before it is drawn for
+ * the first time, so pages that are never shown cost no more than an empty
+ * widget. A \ref StackedWidget with a release timeout removes the contents of
+ * pages that have not been shown for a while, which frees their textures and
+ * retained caches; they are recreated by the factory when the page is shown
+ * again. Applications that must preserve the state of the released widgets
+ * can store it from the release callback, e.g. using \ref Widget::save().
+ */
+class NANOGUI_EXPORT LazyPage : public Widget {
+public:
+    /// Callback that creates the contents of a page (with the page as parent)
+    using Factory = std::function<void(Widget *)>;
+
+    LazyPage(Widget *parent, const Factory &factory);
+
+    /// Return the callback that creates the contents of the page
+    const Factory &factory() const { return mFactory; }
+    /// Set the callback that creates the contents of the page
+    void setFactory(const Factory &factory) { mFactory = factory; }
+
+    /// Return the callback that is invoked before the contents are released
+    const std::function<void(Widget *)> &releaseCallback() const { return mReleaseCallback; }
+    /// Set the callback that is invoked before the contents are released
+    void setReleaseCallback(const std::function<void(Widget *)> &callback) { mReleaseCallback = callback; }
+
+    /// Return whether the contents of the page currently exist
+    bool populated() const { return mPopulated; }
+
+    /// Create the contents of the page unless they already exist
+    void populate();
+
+    /// Remove the contents of the page (they are recreated when it is shown again)
+    void release();
+
+    /// Return the time (as reported by ``glfwGetTime()``) at which the page was last drawn
+    double lastDrawn() const { return mLastDrawn; }
+
+    virtual Vector2i preferredSize(NVGcontext *ctx) const override;
+    virtual void performLayout(NVGcontext *ctx) override;
+    virtual void draw(NVGcontext *ctx) override;
+
+protected:
+    Factory mFactory;
+    std::function<void(Widget *)> mReleaseCallback;
+    bool mPopulated;
+    bool mNeedsLayout;
+    double mLastDrawn;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
 /**
  * \class StackedWidget stackedwidget.h nanogui/stackedwidget.h
  *
@@ -31,12 +88,25 @@ public:
     void setSelectedIndex(int index);
     int selectedIndex() const;
 
+    /**
+     * \brief Release the contents of \ref LazyPage children that have not
+     * been shown for the given number of seconds.
+     *
+     * A negative value (the default) keeps the contents of all pages alive.
+     */
+    void setReleaseTimeout(double seconds) { mReleaseTimeout = seconds; }
+    /// Return the number of seconds after which hidden \ref LazyPage contents are released
+    double releaseTimeout() const { return mReleaseTimeout; }
+
     virtual void performLayout(NVGcontext* ctx) override;
     virtual Vector2i preferredSize(NVGcontext* ctx) const override;
     virtual void addChild(int index, Widget* widget) override;
+    virtual void draw(NVGcontext* ctx) override;
 
 private:
     int mSelectedIndex = -1;
+    double mReleaseTimeout = -1.0;
+    double mLastReleaseCheck = 0.0;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
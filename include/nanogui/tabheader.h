@@ -27,6 +27,11 @@ NAMESPACE_BEGIN(nanogui)
  * \class TabHeader tabheader.h nanogui/tabheader.h
  *
  * \brief A Tab navigable widget.
+ *
+ * The measured widths of the tab buttons are cached along with their prefix
+ * sums, so that visibility queries and hit testing take logarithmic time in
+ * the number of tabs. Labels are only measured again when the font, the font
+ * size or the tab metrics of the theme change.
  */
 class NANOGUI_EXPORT TabHeader : public Widget {
 public:
@@ -111,11 +116,16 @@ private:
 
         TabButton(TabHeader& header, const std::string& label);
 
-        void setLabel(const std::string& label) { mLabel = label; }
+        void setLabel(const std::string& label) { mLabel = label; mMeasured = false; }
         const std::string& label() const { return mLabel; }
         void setSize(const Vector2i& size) { mSize = size; }
         const Vector2i& size() const { return mSize; }
 
+        /// Whether the cached result of \ref preferredSize() is up to date
+        bool measured() const { return mMeasured; }
+        /// Discard the cached result of \ref preferredSize()
+        void invalidate() const { mMeasured = false; }
+
         Vector2i preferredSize(NVGcontext* ctx) const;
         void calculateVisibleString(NVGcontext* ctx);
         void drawAtPosition(NVGcontext* ctx, const Vector2i& position, bool active);
@@ -126,17 +136,14 @@ private:
         TabHeader* mHeader;
         std::string mLabel;
         Vector2i mSize;
-
-        /**
-         * \struct StringView tabheader.h nanogui/tabheader.h
-         *
-         * \brief Helper struct to represent the TabButton.
-         */
-        struct StringView {
-            const char* first = nullptr;
-            const char* last = nullptr;
-        };
-        StringView mVisibleText;
+        mutable Vector2i mPreferredSize = Vector2i::Zero();
+        mutable bool mMeasured = false;
+
+        /* Byte range of the label that is displayed. Offsets instead of
+           pointers remain valid when the buttons are moved in memory. */
+        int mVisibleBegin = 0;
+        /// Number of displayed bytes in front of the dots (-1 if the label is not truncated)
+        int mVisibleLength = -1;
         int mVisibleWidth = 0;
     };
 
@@ -161,6 +168,15 @@ private:
     /// Given the beginning of the visible tabs, calculate the end.
     void calculateVisibleEnd();
 
+    /// Discard the measured tab sizes if the font or the tab metrics changed.
+    void checkTabMetrics() const;
+
+    /// Preferred size of a tab button, clamped to the limits of the theme.
+    Vector2i clampedTabSize(NVGcontext* ctx, const TabButton& tab) const;
+
+    /// Rebuild the prefix sums of the tab button widths.
+    void updateTabOffsets();
+
     void drawControls(NVGcontext* ctx);
     ClickLocation locateClick(const Vector2i& p);
     void onArrowLeft();
@@ -173,6 +189,16 @@ private:
     int mActiveTab = 0;
     bool mOverflowing = false;
 
+    /// Total width of the tab buttons in front of each tab (``tabCount() + 1`` entries)
+    std::vector<int> mTabOffsets = std::vector<int>(1, 0);
+    /// Whether tab buttons must be measured or resized by \ref performLayout()
+    mutable bool mTabsDirty = true;
+    mutable bool mPreferredSizeDirty = true;
+    mutable Vector2i mPreferredSize = Vector2i::Zero();
+    /// Font and metrics the tab buttons were measured with
+    mutable std::string mMeasuredFont;
+    mutable std::vector<int> mMeasuredMetrics;
+
     std::string mFont;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
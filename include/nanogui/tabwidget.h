@@ -45,6 +45,20 @@ public:
     Widget* createTab(const std::string &label);
     Widget* createTab(int index, const std::string &label);
 
+    /**
+     * Creates a new tab whose contents are created by the provided callback
+     * right before the tab is shown for the first time (see \ref LazyPage).
+     */
+    LazyPage* createLazyTab(const std::string &label, const std::function<void(Widget *)> &factory);
+    LazyPage* createLazyTab(int index, const std::string &label, const std::function<void(Widget *)> &factory);
+
+    /**
+     * Release the contents of lazy tabs that have not been shown for the
+     * given number of seconds. A negative value (the default) disables this.
+     */
+    void setReleaseTimeout(double seconds);
+    double releaseTimeout() const;
+
     /// Inserts a tab at the end of the tabs collection and associates it with the provided widget.
     void addTab(const std::string &label, Widget *tab);
 
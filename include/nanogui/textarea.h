@@ -0,0 +1,359 @@
+/*
+    nanogui/textarea.h -- Multi-line text editor backed by a piece table
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/widget.h>
+#include <functional>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TextDocument textarea.h nanogui/textarea.h
+ *
+ * \brief Editable text stored as a piece table, with a line index and an
+ * undo history of deltas.
+ *
+ * The original text is never modified: edits append the inserted text to a
+ * separate buffer and split the list of pieces that refer to the two
+ * buffers. Together with the sorted offsets of all line starts, this
+ * makes edits of multi-megabyte documents independent of the size of the
+ * text (apart from shifting the line and piece offsets behind the edit).
+ *
+ * Lines are separated by ``'\n'``. All positions are byte offsets into the
+ * UTF-8 encoded text.
+ */
+class NANOGUI_EXPORT TextDocument {
+public:
+    /**
+     * \brief Callback invoked after every modification.
+     *
+     * The arguments are the first affected line and the number of line
+     * breaks that were removed and inserted; lines behind the edit are
+     * shifted by the difference.
+     */
+    using ChangeCallback = std::function<void(size_t, size_t, size_t)>;
+
+    TextDocument(const std::string &text = "");
+
+    /// Replace the contents (clears the undo history)
+    void setText(const std::string &text);
+
+    /// Return the contents as a single string
+    std::string text() const { return substr(0, mLength); }
+
+    /// Return the length of the text in bytes
+    size_t length() const { return mLength; }
+
+    /// Return the number of lines (at least one)
+    size_t lineCount() const { return mLineStarts.size(); }
+
+    /// Return the offset of the first character of a line
+    size_t lineStart(size_t line) const { return mLineStarts[line]; }
+
+    /// Return the offset of the end of a line (excluding the line break)
+    size_t lineEnd(size_t line) const;
+
+    /// Return the line that contains the given offset
+    size_t lineOf(size_t offset) const;
+
+    /// Return the contents of a line (excluding the line break)
+    std::string line(size_t line) const;
+
+    /// Return the byte at the given offset
+    char at(size_t offset) const;
+
+    /// Return ``length`` bytes starting at ``offset``
+    std::string substr(size_t offset, size_t length) const;
+
+    /// Return the number of pieces the text currently consists of
+    size_t pieceCount() const { return mPieces.size(); }
+
+    /// Insert text at the given offset
+    void insert(size_t offset, const std::string &text);
+
+    /// Remove ``length`` bytes starting at ``offset``
+    void erase(size_t offset, size_t length);
+
+    /// Replace ``length`` bytes starting at ``offset`` by the given text (a single undo step)
+    void replace(size_t offset, size_t length, const std::string &text);
+
+    /// Return whether there is an edit that can be undone
+    bool canUndo() const { return !mUndo.empty(); }
+
+    /// Return whether there is an undone edit that can be redone
+    bool canRedo() const { return !mRedo.empty(); }
+
+    /**
+     * \brief Revert the most recent group of edits.
+     *
+     * \param caret
+     *     If not ``nullptr``, receives the offset right after the restored text.
+     *
+     * \return
+     *     ``false`` if there was nothing to undo.
+     */
+    bool undo(size_t *caret = nullptr);
+
+    /// Reapply the most recently undone group of edits (see \ref undo())
+    bool redo(size_t *caret = nullptr);
+
+    /// Prevent the next edit from being merged with the previous one in the history
+    void closeUndoGroup() { mCoalesce = false; }
+
+    /// Discard the undo and redo history
+    void clearHistory();
+
+    /// Return the callback that is invoked after every modification
+    const ChangeCallback &changeCallback() const { return mChangeCallback; }
+
+    /// Set the callback that is invoked after every modification
+    void setChangeCallback(const ChangeCallback &callback) { mChangeCallback = callback; }
+
+protected:
+    /**
+     * \struct Piece textarea.h nanogui/textarea.h
+     *
+     * A contiguous range of the original or the appended buffer.
+     */
+    struct Piece {
+        /// Whether the piece refers to \ref mAdded (or else to \ref mOriginal)
+        bool added;
+        /// Offset of the piece within its buffer
+        size_t start;
+        /// Length of the piece in bytes
+        size_t length;
+    };
+
+    /**
+     * \struct Delta textarea.h nanogui/textarea.h
+     *
+     * An entry of the undo history: ``removed`` was replaced by ``inserted``
+     * at ``offset``.
+     */
+    struct Delta {
+        size_t offset;
+        std::string removed;
+        std::string inserted;
+    };
+
+    /// Return the buffer a piece refers to
+    const std::string &buffer(const Piece &piece) const {
+        return piece.added ? mAdded : mOriginal;
+    }
+
+    /// Return the index of the piece that contains the given offset
+    size_t findPiece(size_t offset) const;
+
+    /// Split pieces so that one starts at ``offset`` and return its index
+    size_t splitAt(size_t offset);
+
+    /// Recompute the document offsets of all pieces starting at ``index``
+    void updatePieceOffsets(size_t index);
+
+    /// Insert text without recording it in the history
+    void rawInsert(size_t offset, const std::string &text);
+
+    /// Remove text without recording it in the history
+    void rawErase(size_t offset, size_t length);
+
+    /// Record an edit in the undo history, merging it with the previous one if possible
+    void record(size_t offset, const std::string &removed, const std::string &inserted);
+
+protected:
+    std::string mOriginal;
+    std::string mAdded;
+    std::vector<Piece> mPieces;
+    std::vector<size_t> mPieceOffsets;
+    std::vector<size_t> mLineStarts;
+    size_t mLength;
+    std::vector<Delta> mUndo;
+    std::vector<Delta> mRedo;
+    bool mCoalesce;
+    ChangeCallback mChangeCallback;
+};
+
+/**
+ * \class TextArea textarea.h nanogui/textarea.h
+ *
+ * \brief Multi-line text editor for large documents.
+ *
+ * The text is kept in a \ref TextDocument. Only the visible lines are
+ * extracted, measured and drawn in each frame. The glyph positions of a line
+ * are cached until the line is edited, the font changes, or the line scrolls
+ * far out of view. Lines are not wrapped; the editor scrolls horizontally
+ * instead.
+ *
+ * The editor supports mouse and keyboard selection, the clipboard, and undo
+ * (``Ctrl+Z``) and redo (``Ctrl+Y`` or ``Ctrl+Shift+Z``) of groups of edits.
+ * Read-only editors (see \ref setEditable()) still allow selecting and
+ * copying text.
+ */
+class NANOGUI_EXPORT TextArea : public Widget {
+public:
+    TextArea(Widget *parent, const std::string &value = "");
+
+    /// Return the contents of the editor as a single string
+    std::string value() const { return mDocument.text(); }
+
+    /// Replace the contents of the editor (clears the undo history)
+    void setValue(const std::string &value);
+
+    /// Return the underlying document
+    const TextDocument &document() const { return mDocument; }
+
+    /// Return whether the contents can be modified by the user
+    bool editable() const { return mEditable; }
+
+    /// Set whether the contents can be modified by the user
+    void setEditable(bool editable);
+
+    /// Return the font used to draw the text
+    const std::string &font() const { return mFont; }
+
+    /// Set the font used to draw the text (e.g. a monospaced font registered with NanoVG)
+    void setFont(const std::string &font) { mFont = font; markDirty(); }
+
+    /// Return the text color (a transparent color selects the theme's text color)
+    const Color &textColor() const { return mTextColor; }
+
+    /// Set the text color (a transparent color selects the theme's text color)
+    void setTextColor(const Color &color) { mTextColor = color; markDirty(); }
+
+    /// Return the offset of the caret
+    size_t caretPosition() const { return mCaret; }
+
+    /// Move the caret to the given offset and clear the selection
+    void setCaretPosition(size_t offset);
+
+    /// Select the given range (the caret is placed at ``end``)
+    void select(size_t begin, size_t end);
+
+    /// Return the selected text
+    std::string selectedText() const;
+
+    /// Replace the selection with the given text (as if it was typed)
+    void insert(const std::string &text);
+
+    /// Revert the most recent group of edits
+    bool undo();
+
+    /// Reapply the most recently undone group of edits
+    bool redo();
+
+    /// Scroll so that the given line is visible
+    void scrollToLine(size_t line);
+
+    /// Set the \ref Theme used to draw this widget
+    virtual void setTheme(Theme *theme) override;
+
+    /// The callback that is invoked whenever the user modifies the contents
+    const std::function<void()> &callback() const { return mCallback; }
+
+    /// Set the callback that is invoked whenever the user modifies the contents
+    void setCallback(const std::function<void()> &callback) { mCallback = callback; }
+
+    virtual bool mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) override;
+    virtual bool mouseDragEvent(const Vector2i &p, const Vector2i &rel, int button, int modifiers) override;
+    virtual bool scrollEvent(const Vector2i &p, const Vector2f &rel) override;
+    virtual bool focusEvent(bool focused) override;
+    virtual bool keyboardEvent(int key, int scancode, int action, int modifiers) override;
+    virtual bool keyboardCharacterEvent(unsigned int codepoint) override;
+
+    virtual Vector2i preferredSize(NVGcontext *ctx) const override;
+    virtual void draw(NVGcontext *ctx) override;
+    virtual void save(Serializer &s) const override;
+    virtual bool load(Serializer &s) override;
+
+protected:
+    /**
+     * \struct LineLayout textarea.h nanogui/textarea.h
+     *
+     * Cached horizontal caret positions of a line.
+     */
+    struct LineLayout {
+        /// Caret position in front of each byte, followed by the line width
+        std::vector<float> x;
+    };
+
+    /// Return the height of a line in pixels
+    float lineHeight() const { return std::round(fontSize() * 1.3f); }
+
+    /// Return the width of the text viewport
+    float viewWidth() const;
+
+    /// Return the height of the text viewport
+    float viewHeight() const;
+
+    /// Return whether the vertical scroll bar is shown
+    bool scrollBarVisible() const;
+
+    /// Return the (cached) caret positions of a line
+    const LineLayout &layoutLine(NVGcontext *ctx, size_t line);
+
+    /// Update the line layout cache after an edit of the document
+    void invalidateLines(size_t line, size_t removedLines, size_t insertedLines);
+
+    /// Drop cached line layouts that are far away from the visible lines
+    void trimLayoutCache(size_t firstVisible, size_t lastVisible);
+
+    /// Return the offset closest to a position (in parent coordinates)
+    size_t hitTest(const Vector2i &p);
+
+    /// Return the horizontal caret position of an offset within its line
+    float caretX(NVGcontext *ctx, size_t offset);
+
+    /// Return the offset of a line closest to a horizontal caret position
+    size_t offsetAtX(NVGcontext *ctx, size_t line, float x);
+
+    /// Return the offset of the previous character (UTF-8 aware)
+    size_t prevChar(size_t offset) const;
+
+    /// Return the offset of the next character (UTF-8 aware)
+    size_t nextChar(size_t offset) const;
+
+    /// Move the caret, extending the selection if ``extend`` is set
+    void moveCaret(size_t offset, bool extend);
+
+    /// Replace a range of the document and place the caret behind the new text
+    void replaceRange(size_t begin, size_t end, const std::string &text);
+
+    /// Limit the scroll offsets to the extent of the document
+    void clampScroll();
+
+    bool copySelection();
+    void pasteFromClipboard();
+    bool deleteSelection();
+
+protected:
+    TextDocument mDocument;
+    bool mEditable;
+    std::string mFont;
+    Color mTextColor;
+    size_t mCaret;
+    size_t mAnchor;
+    float mPreferredX;
+    bool mScrollToCaret;
+    Vector2f mScroll;
+    float mContentWidth;
+    bool mDragScrollBar;
+    double mLastClick;
+    std::function<void()> mCallback;
+    std::unordered_map<size_t, LineLayout> mLayouts;
+    std::string mLayoutFont;
+    float mLayoutFontSize;
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+NAMESPACE_END(nanogui)
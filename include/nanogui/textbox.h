@@ -26,6 +26,11 @@ NAMESPACE_BEGIN(nanogui)
  *
  * \brief Fancy text box with builtin regular expression-based validation.
  *
+ * The format is compiled once when it is set, rather than on every edit.
+ * The formats used by \ref IntBox and \ref FloatBox are recognized and
+ * checked by hand-written scanners, and arbitrary validation logic can be
+ * supplied through \ref setValidator().
+ *
  * \remark
  *     This class overrides \ref nanogui::Widget::mIconExtraScale to be ``0.8f``,
  *     which affects all subclasses of this Widget.  Subclasses must explicitly
@@ -63,10 +68,18 @@ public:
     int unitsImage() const { return mUnitsImage; }
     void setUnitsImage(int image) { mUnitsImage = image; }
 
+    /// Function that decides whether the (nonempty) contents of the text box are valid
+    using Validator = std::function<bool(const std::string &)>;
+
     /// Return the underlying regular expression specifying valid formats
     const std::string &format() const { return mFormat; }
-    /// Specify a regular expression specifying valid formats
-    void setFormat(const std::string &format) { mFormat = format; }
+    /// Specify a regular expression specifying valid formats (compiles a new \ref validator())
+    void setFormat(const std::string &format);
+
+    /// Return the function that validates the contents (empty if any input is accepted)
+    const Validator &validator() const { return mValidator; }
+    /// Specify a custom validation function (clears the \ref format())
+    void setValidator(const Validator &validator) { mFormat.clear(); mValidator = validator; }
 
     /// Set the \ref Theme used to draw this widget
     virtual void setTheme(Theme *theme) override;
@@ -90,16 +103,19 @@ public:
     virtual bool load(Serializer &s) override;
 protected:
     bool checkFormat(const std::string& input,const std::string& format);
+    /// Check the given input against the current validator
+    bool validate(const std::string &input) const;
+    /// Create a validator for the given regular expression
+    static Validator compileFormat(const std::string &format);
     bool copySelection();
     void pasteFromClipboard();
     bool deleteSelection();
 
-    void updateCursor(NVGcontext *ctx, float lastx,
-                      const NVGglyphPosition *glyphs, int size);
-    float cursorIndex2Position(int index, float lastx,
-                               const NVGglyphPosition *glyphs, int size);
-    int position2CursorIndex(float posx, float lastx,
-                             const NVGglyphPosition *glyphs, int size);
+    /// Measure the caret positions of the edited text, unless they are cached already
+    void updateGlyphPositions(NVGcontext *ctx);
+    void updateCursor(NVGcontext *ctx, float originX);
+    float cursorIndex2Position(int index, float originX) const;
+    int position2CursorIndex(float posx, float originX) const;
 
     /// The location (if any) for the spin area.
     enum class SpinArea { None, Top, Bottom };
@@ -114,6 +130,7 @@ protected:
     Alignment mAlignment;
     std::string mUnits;
     std::string mFormat;
+    Validator mValidator;
     int mUnitsImage;
     std::function<bool(const std::string& str)> mCallback;
     bool mValidFormat;
@@ -126,6 +143,11 @@ protected:
     int mMouseDownModifier;
     float mTextOffset;
     double mLastClick;
+    std::vector<float> mGlyphX;
+    std::string mGlyphText;
+    float mGlyphFontSize;
+    Alignment mGlyphAlignment;
+    float mGlyphLineHeight;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
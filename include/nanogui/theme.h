@@ -223,9 +223,33 @@ public:
     /// Icon to use when a TextBox has a down toggle (e.g. IntBox) (default: ``ENTYPO_ICON_CHEVRON_DOWN``).
     int mTextBoxDownIcon;
 
+    /**
+     * Set an optional atlas of pre-rendered theme elements (default:
+     * ``nullptr``). Widgets draw shadows, frames and backgrounds from it when
+     * present; see \ref nanogui::Skin.
+     */
+    void setSkin(Skin *skin);
+
+    /// Return the atlas of pre-rendered theme elements (or ``nullptr``).
+    Skin *skin() { return mSkin; }
+
+    /// Return the atlas of pre-rendered theme elements (or ``nullptr``).
+    const Skin *skin() const { return mSkin.get(); }
+
+    /**
+     * Return the themes of the given NanoVG context that currently have a
+     * skin. The \ref Screen keeps their atlases up to date before drawing.
+     */
+    static std::vector<Theme *> skinnedThemes(NVGcontext *ctx);
+
 protected:
-    /// Default destructor does nothing; allows for inheritance.
-    virtual ~Theme() { };
+    /// Removes the theme from the list of skinned themes; allows for inheritance.
+    virtual ~Theme();
+
+    /// The NanoVG context that the fonts were created for
+    NVGcontext *mContext;
+    /// The atlas of pre-rendered theme elements (see \ref setSkin())
+    ref<Skin> mSkin;
 
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -22,6 +22,12 @@ NAMESPACE_BEGIN(nanogui)
  *
  * \brief Adds a vertical scrollbar around a widget that is too big to fit into
  *        a certain area.
+ *
+ * Scrolling only translates the child widget; its layout is recomputed when
+ * the size of the panel changes or when \ref performLayout() is called, e.g.
+ * after widgets were added to or removed from the scrolled content. Scroll
+ * wheel input is applied smoothly over the following frames unless
+ * \ref setSmoothScrolling() is used to disable this.
  */
 class NANOGUI_EXPORT VScrollPanel : public Widget {
 public:
@@ -30,7 +36,12 @@ public:
     /// Return the current scroll amount as a value between 0 and 1. 0 means scrolled to the top and 1 to the bottom.
     float scroll() const { return mScroll; }
     /// Set the scroll amount to a value between 0 and 1. 0 means scrolled to the top and 1 to the bottom.
-    void setScroll(float scroll) { mScroll = scroll; }
+    void setScroll(float scroll) { mScroll = scroll; mScrollVelocity = 0.f; markDirty(); }
+
+    /// Return whether scroll wheel input glides to a halt instead of jumping
+    bool smoothScrolling() const { return mSmoothScrolling; }
+    /// Set whether scroll wheel input glides to a halt instead of jumping
+    void setSmoothScrolling(bool smoothScrolling) { mSmoothScrolling = smoothScrolling; }
 
     virtual void performLayout(NVGcontext *ctx) override;
     virtual Vector2i preferredSize(NVGcontext *ctx) const override;
@@ -39,10 +50,18 @@ public:
     virtual void draw(NVGcontext *ctx) override;
     virtual void save(Serializer &s) const override;
     virtual bool load(Serializer &s) override;
+protected:
+    /// Advance an ongoing inertial scroll motion to the current time
+    void updateScrollMotion();
+
 protected:
     int mChildPreferredHeight;
     float mScroll;
     bool mUpdateLayout;
+    Vector2i mLayoutSize;
+    bool mSmoothScrolling;
+    float mScrollVelocity;
+    double mLastScrollTime;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
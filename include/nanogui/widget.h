@@ -58,7 +58,13 @@ public:
     /// Return the position relative to the parent widget
     const Vector2i &position() const { return mPos; }
     /// Set the position relative to the parent widget
-    void setPosition(const Vector2i &pos) { mPos = pos; }
+    void setPosition(const Vector2i &pos) {
+        if (mPos == pos)
+            return;
+        mPos = pos;
+        if (mParent)
+            mParent->markDirty();
+    }
 
     /// Return the absolute position on screen
     Vector2i absolutePosition() const {
@@ -69,7 +75,12 @@ public:
     /// Return the size of the widget
     const Vector2i &size() const { return mSize; }
     /// set the size of the widget
-    void setSize(const Vector2i &size) { mSize = size; }
+    void setSize(const Vector2i &size) {
+        if (mSize == size)
+            return;
+        mSize = size;
+        markDirty();
+    }
 
     /// Return the width of the widget
     int width() const { return mSize.x(); }
@@ -107,7 +118,12 @@ public:
     /// Return whether or not the widget is currently visible (assuming all parents are visible)
     bool visible() const { return mVisible; }
     /// Set whether or not the widget is currently visible (assuming all parents are visible)
-    void setVisible(bool visible) { mVisible = visible; }
+    void setVisible(bool visible) {
+        if (mVisible == visible)
+            return;
+        mVisible = visible;
+        markDirty();
+    }
 
     /// Check if this widget is currently visible, taking parent widgets into account
     bool visibleRecursive() const {
@@ -174,7 +190,12 @@ public:
     /// Return whether or not this widget is currently enabled
     bool enabled() const { return mEnabled; }
     /// Set whether or not this widget is currently enabled
-    void setEnabled(bool enabled) { mEnabled = enabled; }
+    void setEnabled(bool enabled) {
+        if (mEnabled == enabled)
+            return;
+        mEnabled = enabled;
+        markDirty();
+    }
 
     /// Return whether or not this widget is currently focused
     bool focused() const { return mFocused; }
@@ -243,6 +264,39 @@ public:
     /// Handle text input (UTF-32 format) (default implementation: do nothing)
     virtual bool keyboardCharacterEvent(unsigned int codepoint);
 
+    /**
+     * \brief Set whether this widget and its children are drawn from a retained cache.
+     *
+     * A cached subtree is rendered into an offscreen texture, which is then
+     * composited with a single textured rectangle. The texture is only
+     * redrawn when the \ref stateVersion() of the widget changes or when its
+     * size or the pixel ratio changes; moving the widget merely translates
+     * the texture. This makes large, mostly static panels nearly free to
+     * redraw.
+     *
+     * The version is bumped automatically by input events routed to widgets
+     * in the subtree, focus changes, layout changes and changes to the
+     * visibility or enabled state. Programmatic changes of other widget state
+     * (e.g. the caption of a label) must be followed by a call to
+     * \ref markDirty(). Subtrees containing widgets that change every frame
+     * should not be cached.
+     *
+     * \param margin
+     *     Additional space around the widget that is included in the cache,
+     *     e.g. for the drop shadow of a \ref Window. The margin is not clipped
+     *     by the parent widgets.
+     */
+    void setCached(bool cached, int margin = 0);
+
+    /// Return whether this widget and its children are drawn from a retained cache
+    bool cached() const { return mCached; }
+
+    /// Record a change of this widget's appearance, invalidating caches of it and its parents
+    void markDirty();
+
+    /// Return a counter which is incremented whenever this widget or one of its children changes
+    uint32_t stateVersion() const { return mStateVersion; }
+
     /// Compute the preferred size of the widget
     virtual Vector2i preferredSize(NVGcontext *ctx) const;
 
@@ -262,6 +316,9 @@ protected:
     /// Free all resources used by the widget and any children
     virtual ~Widget();
 
+    /// Composite the retained cache of this widget (see \ref setCached())
+    virtual void drawCached(NVGcontext *ctx);
+
     /**
      * Convenience definition for subclasses to get the full icon scale for this
      * class of Widget.  It simple returns the value
@@ -335,6 +392,25 @@ protected:
      */
     float mIconExtraScale;
     Cursor mCursor;
+
+    /// Whether this subtree is drawn from a retained cache (see \ref setCached()).
+    bool mCached;
+
+    /// Extra space around the widget that is included in the cache.
+    int mCacheMargin;
+
+    /// Incremented whenever the appearance of this widget or a child changes.
+    uint32_t mStateVersion;
+
+    /// State version and pixel ratio the retained cache was rendered with.
+    uint32_t mCacheVersion;
+    float mCachePixelRatio;
+
+    /// Offscreen target holding the retained cache.
+    GLRenderTarget *mCacheTarget;
+
+private:
+    friend class Screen;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
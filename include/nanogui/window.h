@@ -23,19 +23,46 @@ NAMESPACE_BEGIN(nanogui)
  */
 class NANOGUI_EXPORT Window : public Widget {
     friend class Popup;
+    friend class Screen;
 public:
     Window(Widget *parent, const std::string &title = "Untitled");
 
     /// Return the window title
     const std::string &title() const { return mTitle; }
     /// Set the window title
-    void setTitle(const std::string &title) { mTitle = title; }
+    void setTitle(const std::string &title) { mTitle = title; markDirty(); }
 
     /// Is this a model dialog?
     bool modal() const { return mModal; }
     /// Set whether or not this is a modal dialog
     void setModal(bool modal) { mModal = modal; }
 
+    /**
+     * \brief Set whether the window is drawn from its own compositing layer.
+     *
+     * A layered window renders itself, its drop shadow and all of its
+     * children into a texture (see \ref Widget::setCached()). The texture is
+     * only redrawn when the contents of the window change; moving the window,
+     * changing its stacking order or fading it via \ref setOpacity() merely
+     * composites the existing texture at a new position.
+     */
+    void setLayered(bool layered) { setCached(layered, layerMargin()); }
+
+    /// Return whether the window is drawn from its own compositing layer
+    bool layered() const { return mCached; }
+
+    /**
+     * \brief Set the opacity of the window (between 0 and 1).
+     *
+     * For layered windows, this blends the layer as a whole and does not
+     * require it to be redrawn. Otherwise, the opacity is applied to every
+     * shape separately, so overlapping shapes will show through each other.
+     */
+    void setOpacity(float opacity) { mOpacity = opacity; }
+
+    /// Return the opacity of the window
+    float opacity() const { return mOpacity; }
+
     /// Return the panel used to house window buttons
     Widget *buttonPanel();
 
@@ -62,11 +89,16 @@ public:
 protected:
     /// Internal helper function to maintain nested window position values; overridden in \ref Popup
     virtual void refreshRelativePlacement();
+    /// Space around the window that is covered by its layer; overridden in \ref Popup
+    virtual int layerMargin() const;
+    /// Composite the layer of the window using the current opacity
+    virtual void drawCached(NVGcontext *ctx) override;
 protected:
     std::string mTitle;
     Widget *mButtonPanel;
     bool mModal;
     bool mDrag;
+    float mOpacity;
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
@@ -60,7 +60,9 @@ void register_basics(py::module &m) {
     py::class_<VScrollPanel, Widget, ref<VScrollPanel>, PyVScrollPanel>(m, "VScrollPanel", D(VScrollPanel))
         .def(py::init<Widget *>(), py::arg("parent"), D(VScrollPanel, VScrollPanel))
         .def("scroll", &VScrollPanel::scroll, D(VScrollPanel, scroll))
-        .def("setScroll", &VScrollPanel::setScroll, D(VScrollPanel, setScroll));
+        .def("setScroll", &VScrollPanel::setScroll, D(VScrollPanel, setScroll))
+        .def("smoothScrolling", &VScrollPanel::smoothScrolling, D(VScrollPanel, smoothScrolling))
+        .def("setSmoothScrolling", &VScrollPanel::setSmoothScrolling, D(VScrollPanel, setSmoothScrolling));
 
     py::class_<ComboBox, Widget, ref<ComboBox>, PyComboBox>(m, "ComboBox", D(ComboBox))
         .def(py::init<Widget *>(), py::arg("parent"), D(ComboBox, ComboBox))
@@ -77,7 +79,13 @@ void register_basics(py::module &m) {
         .def("setItems", (void(ComboBox::*)(const std::vector<std::string>&,
                           const std::vector<std::string>&)) &ComboBox::setItems/*, D(ComboBox, setItems, 2)*/)
         .def("items", &ComboBox::items, D(ComboBox, items))
-        .def("itemsShort", &ComboBox::itemsShort, D(ComboBox, itemsShort));
+        .def("itemsShort", &ComboBox::itemsShort, D(ComboBox, itemsShort))
+        .def("virtualized", &ComboBox::virtualized, D(ComboBox, virtualized))
+        .def("setVirtualized", &ComboBox::setVirtualized, D(ComboBox, setVirtualized))
+        .def("visibleRows", &ComboBox::visibleRows, D(ComboBox, visibleRows))
+        .def("setVisibleRows", &ComboBox::setVisibleRows, D(ComboBox, setVisibleRows))
+        .def("filter", &ComboBox::filter, D(ComboBox, filter))
+        .def("setFilter", &ComboBox::setFilter, D(ComboBox, setFilter));
 
     py::class_<ProgressBar, Widget, ref<ProgressBar>, PyProgressBar>(m, "ProgressBar", D(ProgressBar))
         .def(py::init<Widget *>(), py::arg("parent"), D(ProgressBar, ProgressBar))
@@ -0,0 +1,414 @@
+#ifdef NANOGUI_PYTHON
+
+#include "python.h"
+#include <pybind11/numpy.h>
+#include <unordered_map>
+#include <functional>
+#include <cctype>
+
+typedef FloatBox<double> DoubleBox;
+typedef IntBox<int64_t> Int64Box;
+
+using NumberArray = py::array_t<double, py::array::forcecast | py::array::c_style>;
+
+/* Native setters of numeric widget properties. Each one receives 'arity'
+   numbers and returns false if the widget does not have the property; when
+   the numbers are 'nullptr', it only checks whether the widget has it */
+struct NumberProperty {
+    size_t arity;
+    bool (*set)(Widget *widget, const double *value);
+};
+
+/* Native setters of textual widget properties (same convention) */
+typedef bool (*TextProperty)(Widget *widget, const std::string *value);
+
+/* Invoke 'f' on the widget cast to T unless only checking ('value' is
+   nullptr). Returns whether the widget is a T */
+template <typename T, typename Value, typename Func>
+static bool apply(Widget *widget, const Value *value, Func f) {
+    T *t = dynamic_cast<T *>(widget);
+    if (t && value)
+        f(t);
+    return t != nullptr;
+}
+
+static Color toColor(const double *v) {
+    return Color((float) v[0], (float) v[1], (float) v[2], (float) v[3]);
+}
+
+static const std::unordered_map<std::string, NumberProperty> numberProperties = {
+    { "position", { 2, [](Widget *w, const double *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setPosition(Vector2i((int) v[0], (int) v[1])); });
+    }}},
+    { "size", { 2, [](Widget *w, const double *v) {
+        return apply<Screen>(w, v, [&](Screen *s) { s->setSize(Vector2i((int) v[0], (int) v[1])); }) ||
+               apply<Widget>(w, v, [&](Widget *t) { t->setSize(Vector2i((int) v[0], (int) v[1])); });
+    }}},
+    { "fixedSize", { 2, [](Widget *w, const double *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setFixedSize(Vector2i((int) v[0], (int) v[1])); });
+    }}},
+    { "fixedWidth", { 1, [](Widget *w, const double *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setFixedWidth((int) v[0]); });
+    }}},
+    { "fixedHeight", { 1, [](Widget *w, const double *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setFixedHeight((int) v[0]); });
+    }}},
+    { "visible", { 1, [](Widget *w, const double *v) {
+        return apply<Screen>(w, v, [&](Screen *s) { s->setVisible(v[0] != 0); }) ||
+               apply<Widget>(w, v, [&](Widget *t) { t->setVisible(v[0] != 0); });
+    }}},
+    { "enabled", { 1, [](Widget *w, const double *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setEnabled(v[0] != 0); });
+    }}},
+    { "fontSize", { 1, [](Widget *w, const double *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setFontSize((int) v[0]); });
+    }}},
+    { "value", { 1, [](Widget *w, const double *v) {
+        return apply<Slider>(w, v, [&](Slider *s) { s->setValue((float) v[0]); }) ||
+               apply<ProgressBar>(w, v, [&](ProgressBar *p) { p->setValue((float) v[0]); }) ||
+               apply<Int64Box>(w, v, [&](Int64Box *b) { b->setValue((int64_t) v[0]); }) ||
+               apply<DoubleBox>(w, v, [&](DoubleBox *b) { b->setValue(v[0]); });
+    }}},
+    { "checked", { 1, [](Widget *w, const double *v) {
+        return apply<CheckBox>(w, v, [&](CheckBox *c) { c->setChecked(v[0] != 0); });
+    }}},
+    { "pushed", { 1, [](Widget *w, const double *v) {
+        return apply<Button>(w, v, [&](Button *b) { b->setPushed(v[0] != 0); }) ||
+               apply<CheckBox>(w, v, [&](CheckBox *c) { c->setPushed(v[0] != 0); });
+    }}},
+    { "selectedIndex", { 1, [](Widget *w, const double *v) {
+        return apply<ComboBox>(w, v, [&](ComboBox *c) { c->setSelectedIndex((int) v[0]); });
+    }}},
+    { "opacity", { 1, [](Widget *w, const double *v) {
+        return apply<Window>(w, v, [&](Window *window) { window->setOpacity((float) v[0]); });
+    }}},
+    { "color", { 4, [](Widget *w, const double *v) {
+        return apply<Label>(w, v, [&](Label *l) { l->setColor(toColor(v)); }) ||
+               apply<ColorPicker>(w, v, [&](ColorPicker *c) { c->setColor(toColor(v)); }) ||
+               apply<ColorWheel>(w, v, [&](ColorWheel *c) { c->setColor(toColor(v)); });
+    }}},
+    { "backgroundColor", { 4, [](Widget *w, const double *v) {
+        return apply<Button>(w, v, [&](Button *b) { b->setBackgroundColor(toColor(v)); }) ||
+               apply<Graph>(w, v, [&](Graph *g) { g->setBackgroundColor(toColor(v)); }) ||
+               apply<Screen>(w, v, [&](Screen *s) { s->setBackground(toColor(v)); });
+    }}},
+    { "textColor", { 4, [](Widget *w, const double *v) {
+        return apply<Button>(w, v, [&](Button *b) { b->setTextColor(toColor(v)); }) ||
+               apply<Graph>(w, v, [&](Graph *g) { g->setTextColor(toColor(v)); });
+    }}}
+};
+
+static const std::unordered_map<std::string, TextProperty> textProperties = {
+    { "caption", [](Widget *w, const std::string *v) {
+        return apply<Label>(w, v, [&](Label *l) { l->setCaption(*v); }) ||
+               apply<Button>(w, v, [&](Button *b) { b->setCaption(*v); }) ||
+               apply<CheckBox>(w, v, [&](CheckBox *c) { c->setCaption(*v); }) ||
+               apply<Graph>(w, v, [&](Graph *g) { g->setCaption(*v); }) ||
+               apply<Screen>(w, v, [&](Screen *s) { s->setCaption(*v); });
+    }},
+    { "title", [](Widget *w, const std::string *v) {
+        return apply<Window>(w, v, [&](Window *window) { window->setTitle(*v); });
+    }},
+    { "tooltip", [](Widget *w, const std::string *v) {
+        return apply<Widget>(w, v, [&](Widget *t) { t->setTooltip(*v); });
+    }},
+    { "value", [](Widget *w, const std::string *v) {
+        return apply<TextBox>(w, v, [&](TextBox *t) { t->setValue(*v); }) ||
+               apply<TextArea>(w, v, [&](TextArea *t) { t->setValue(*v); });
+    }},
+    { "units", [](Widget *w, const std::string *v) {
+        return apply<TextBox>(w, v, [&](TextBox *t) { t->setUnits(*v); });
+    }},
+    { "font", [](Widget *w, const std::string *v) {
+        return apply<Label>(w, v, [&](Label *l) { l->setFont(*v); });
+    }},
+    { "header", [](Widget *w, const std::string *v) {
+        return apply<Graph>(w, v, [&](Graph *g) { g->setHeader(*v); });
+    }},
+    { "footer", [](Widget *w, const std::string *v) {
+        return apply<Graph>(w, v, [&](Graph *g) { g->setFooter(*v); });
+    }}
+};
+
+static bool isText(py::handle value) {
+    return PyUnicode_Check(value.ptr()) || PyBytes_Check(value.ptr());
+}
+
+/* Name of the Python setter of a property, e.g. "setCaption" */
+static std::string setterName(const std::string &name) {
+    std::string result = "set" + name;
+    if (name.size() > 0)
+        result[3] = (char) std::toupper(name[0]);
+    return result;
+}
+
+/* Apply a single property value natively, or only check whether that is
+   possible if 'check' is set. Returns false if there is no native setter for
+   this widget and value (e.g. a Color instance) */
+static bool setNative(Widget *widget, const std::string &name, py::handle value,
+                      bool check = false) {
+    if (isText(value)) {
+        auto it = textProperties.find(name);
+        if (it == textProperties.end())
+            return false;
+        std::string str = value.cast<std::string>();
+        return it->second(widget, check ? nullptr : &str);
+    }
+
+    auto it = numberProperties.find(name);
+    if (it == numberProperties.end())
+        return false;
+
+    std::vector<double> numbers;
+    try {
+        if (PySequence_Check(value.ptr()))
+            numbers = value.cast<std::vector<double>>();
+        else
+            numbers.push_back(value.cast<double>());
+    } catch (const py::cast_error &) {
+        return false;
+    }
+    if (numbers.size() != it->second.arity)
+        return false;
+    return it->second.set(widget, check ? nullptr : numbers.data());
+}
+
+/* Check that a property can be set natively or via its Python setter, so
+   that no widget is modified if one of the updates would fail */
+static void checkProperty(const char *func, size_t index, Widget *widget,
+                          const std::string &name, py::handle value) {
+    if (!widget)
+        throw py::type_error(std::string(func) + "(): widget " + std::to_string(index) +
+                             " is None");
+    if (!setNative(widget, name, value, true) &&
+        !PyObject_HasAttrString(py::cast(widget).ptr(), setterName(name).c_str()))
+        throw std::runtime_error(std::string(func) + "(): widget " + std::to_string(index) +
+                                 " has no property \"" + name + "\"");
+}
+
+/* Apply a property natively if possible, and via its Python setter otherwise */
+static void setProperty(Widget *widget, const std::string &name, py::handle value) {
+    if (!setNative(widget, name, value))
+        py::cast(widget).attr(setterName(name).c_str())(value);
+    widget->markDirty();
+}
+
+/* Find the screen of the widget whose layout is recomputed at the end (before
+   any update is applied, since a detached widget cannot be laid out) */
+static Screen *layoutScreen(const char *func, Widget *layout) {
+    if (!layout)
+        return nullptr;
+    for (Widget *widget = layout; widget; widget = widget->parent()) {
+        if (Screen *screen = dynamic_cast<Screen *>(widget))
+            return screen;
+    }
+    throw std::runtime_error(std::string(func) +
+                             "(): the 'layout' widget is not part of a screen");
+}
+
+/* Lay out the given widget once all updates are done */
+static void performLayout(Widget *layout, Screen *screen) {
+    if (!layout)
+        return;
+    if (layout == screen)
+        screen->performLayout();
+    else
+        layout->performLayout(screen->nvgContext());
+}
+
+/* Set one property of many widgets. 'values' holds one entry per widget
+   (or a single entry for all of them): strings for textual properties, and
+   numbers or a NumPy array with one row per widget for numeric ones */
+static void setPropertyPy(const std::vector<Widget *> &widgets,
+                          const std::string &name, py::object values,
+                          Widget *layout) {
+    const char *func = "set_property";
+    Screen *screen = layoutScreen(func, layout);
+    size_t n = widgets.size();
+    auto textIt = textProperties.find(name);
+    auto numberIt = numberProperties.find(name);
+    bool text = isText(values) ||
+        (PySequence_Check(values.ptr()) && !isText(values) &&
+         py::len(values) > 0 && isText(values[py::int_(0)]));
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!widgets[i])
+            throw py::type_error(std::string(func) + "(): widget " + std::to_string(i) +
+                                 " is None");
+    }
+
+    /* The Python value for the i-th widget */
+    auto value = [&](size_t i, bool single) -> py::object {
+        return single ? values : (py::object) values[py::int_(i)];
+    };
+
+    /* Widgets without a native setter use their Python setter instead. All
+       widgets are checked before any of them is modified */
+    std::vector<size_t> native, fallback;
+    auto partition = [&](const std::function<bool(Widget *)> &has, bool single) {
+        for (size_t i = 0; i < n; ++i) {
+            if (has(widgets[i])) {
+                native.push_back(i);
+            } else {
+                checkProperty(func, i, widgets[i], name, value(i, single));
+                fallback.push_back(i);
+            }
+        }
+    };
+
+    if (text && textIt != textProperties.end()) {
+        std::vector<std::string> strings;
+        if (isText(values))
+            strings.push_back(values.cast<std::string>());
+        else
+            strings = values.cast<std::vector<std::string>>();
+        if (strings.size() != n && strings.size() != 1)
+            throw py::type_error("set_property(): expects one value per widget");
+        bool single = strings.size() == 1;
+        TextProperty set = textIt->second;
+        partition([set](Widget *w) { return set(w, nullptr); }, single);
+
+        {
+            py::gil_scoped_release release;
+            for (size_t i : native) {
+                set(widgets[i], &strings[single ? 0 : i]);
+                widgets[i]->markDirty();
+            }
+        }
+        for (size_t i : fallback)
+            setProperty(widgets[i], name, value(i, single));
+    } else if (!text && numberIt != numberProperties.end()) {
+        size_t arity = numberIt->second.arity;
+        NumberArray array(values);
+        size_t rows;
+        if (array.ndim() == 0 || (array.ndim() == 1 && arity > 1 &&
+                                  (size_t) array.shape(0) == arity))
+            rows = 1;
+        else if (array.ndim() == 1 && arity == 1)
+            rows = (size_t) array.shape(0);
+        else if (array.ndim() == 2 && (size_t) array.shape(1) == arity)
+            rows = (size_t) array.shape(0);
+        else
+            throw py::type_error("set_property(): property \"" + name + "\" expects " +
+                                 std::to_string(arity) + " values per widget");
+        if ((size_t) array.size() != rows * arity || (rows != n && rows != 1))
+            throw py::type_error("set_property(): expects one value per widget");
+        bool single = rows == 1;
+        auto set = numberIt->second.set;
+        partition([set](Widget *w) { return set(w, nullptr); }, single);
+
+        const double *data = array.data();
+        size_t stride = single ? 0 : arity;
+        {
+            py::gil_scoped_release release;
+            for (size_t i : native) {
+                set(widgets[i], data + i * stride);
+                widgets[i]->markDirty();
+            }
+        }
+        for (size_t i : fallback)
+            setProperty(widgets[i], name, value(i, single));
+    } else {
+        /* No native setter: invoke the Python setter of each widget */
+        bool single = !PySequence_Check(values.ptr()) || isText(values);
+        if (!single && py::len(values) != n)
+            throw py::type_error("set_property(): expects one value per widget");
+        for (size_t i = 0; i < n; ++i)
+            checkProperty(func, i, widgets[i], name, value(i, single));
+        for (size_t i = 0; i < n; ++i)
+            setProperty(widgets[i], name, value(i, single));
+    }
+
+    performLayout(layout, screen);
+}
+
+/* Create a widget subtree from a description of the form
+   (type, {property: value, ..}, [child, ..]) */
+static py::object buildPy(const py::module &m, py::object parent,
+                          py::handle description, py::object ids) {
+    if (!PySequence_Check(description.ptr()) || isText(description) ||
+        py::len(description) < 1 || py::len(description) > 3)
+        throw py::type_error("build(): expects a description of the form "
+                             "(type, properties, children)");
+    size_t size = py::len(description);
+
+    py::object type = description[py::int_(0)];
+    if (isText(type))
+        type = m.attr(type.cast<std::string>().c_str());
+
+    py::dict properties;
+    if (size > 1) {
+        py::object value = description[py::int_(1)];
+        if (value != py::none())
+            properties = py::dict(value);
+    }
+
+    py::tuple args;
+    py::object id;
+    for (auto item : properties) {
+        std::string name = item.first.cast<std::string>();
+        if (name == "args")
+            args = py::tuple(py::reinterpret_borrow<py::object>(item.second));
+        else if (name == "id")
+            id = py::reinterpret_borrow<py::object>(item.second);
+    }
+
+    py::object result = type(parent, *args);
+    Widget *widget = result.cast<Widget *>();
+
+    for (auto item : properties) {
+        std::string name = item.first.cast<std::string>();
+        if (name != "args" && name != "id")
+            setProperty(widget, name, item.second);
+    }
+
+    if (id && ids != py::none())
+        ids[id] = result;
+
+    if (size > 2) {
+        for (auto child : description[py::int_(2)])
+            buildPy(m, result, child, ids);
+    }
+
+    return result;
+}
+
+void register_bulk(py::module &m) {
+    m.def("set_property", &setPropertyPy, py::arg("widgets"), py::arg("name"),
+          py::arg("values"), py::arg("layout") = (Widget *) nullptr,
+          D(set_property));
+
+    m.def("set_properties",
+          [](py::object updates, Widget *layout) {
+              const char *func = "set_properties";
+              Screen *screen = layoutScreen(func, layout);
+              std::vector<py::object> items;
+              for (auto update : updates) {
+                  if (!PySequence_Check(update.ptr()) || py::len(update) != 3)
+                      throw py::type_error("set_properties(): expects a list of "
+                                           "(widget, name, value) tuples");
+                  checkProperty(func, items.size(), update[py::int_(0)].cast<Widget *>(),
+                                update[py::int_(1)].cast<std::string>(),
+                                update[py::int_(2)]);
+                  items.push_back(py::reinterpret_borrow<py::object>(update));
+              }
+              for (auto &update : items)
+                  setProperty(update[py::int_(0)].cast<Widget *>(),
+                              update[py::int_(1)].cast<std::string>(),
+                              update[py::int_(2)]);
+              performLayout(layout, screen);
+          }, py::arg("updates"), py::arg("layout") = (Widget *) nullptr,
+          D(set_properties));
+
+    m.def("build",
+          [m](py::object parent, py::object description, py::object ids,
+              Widget *layout) {
+              Screen *screen = layoutScreen("build", layout);
+              py::object result = buildPy(m, parent, description, ids);
+              performLayout(layout, screen);
+              return result;
+          }, py::arg("parent"), py::arg("description"), py::arg("ids") = py::none(),
+          py::arg("layout") = (Widget *) nullptr, D(build));
+}
+
+#endif
@@ -67,7 +67,11 @@ void register_formhelper(py::module &m) {
              py::arg("label"), py::arg("setter"), py::arg("getter"),
              py::arg("editable") = true)
         .def("addWidget", &FormHelper::addWidget, D(FormHelper, addWidget))
-        .def("refresh", &FormHelper::refresh, D(FormHelper, refresh))
+        .def("refresh", &FormHelper::refresh, py::arg("force") = false, D(FormHelper, refresh))
+        .def("notify", &FormHelper::notify, D(FormHelper, notify))
+        .def("refreshInterval", &FormHelper::refreshInterval, D(FormHelper, refreshInterval))
+        .def("setRefreshInterval", (void (FormHelper::*)(double)) &FormHelper::setRefreshInterval, D(FormHelper, setRefreshInterval))
+        .def("setRefreshInterval", (void (FormHelper::*)(Widget *, double)) &FormHelper::setRefreshInterval, D(FormHelper, setRefreshInterval, 2))
         .def("window", &FormHelper::window, D(FormHelper, window))
         .def("setWindow", &FormHelper::setWindow, D(FormHelper, setWindow))
         .def("fixedSize", &FormHelper::fixedSize, D(FormHelper, fixedSize))
@@ -7,8 +7,23 @@ public:
     using GLCanvas::GLCanvas;
     NANOGUI_WIDGET_OVERLOADS(GLCanvas);
 
+    ~PyGLCanvas() {
+        /* Stop the render thread while the overrides still exist. It needs
+           the GIL to call them, so release it while waiting */
+        if (PyGILState_Check()) {
+            py::gil_scoped_release release;
+            setThreaded(false);
+        } else {
+            setThreaded(false);
+        }
+    }
+
     void drawGL() {
-        PYBIND11_OVERLOAD(void, GLCanvas, drawGL);
+        NANOGUI_OVERLOAD(void, GLCanvas, drawGL);
+    }
+
+    void freeGL() {
+        NANOGUI_OVERLOAD(void, GLCanvas, freeGL);
     }
 };
 
@@ -20,7 +35,27 @@ void register_glcanvas(py::module &m) {
         .def("setBackgroundColor", &GLCanvas::setBackgroundColor, D(GLCanvas, setBackgroundColor))
         .def("drawBorder", &GLCanvas::drawBorder, D(GLCanvas, drawBorder))
         .def("setDrawBorder", &GLCanvas::setDrawBorder, D(GLCanvas, setDrawBorder))
+        .def("cacheScene", &GLCanvas::cacheScene, D(GLCanvas, cacheScene))
+        .def("setCacheScene", &GLCanvas::setCacheScene, D(GLCanvas, setCacheScene))
+        .def("markSceneDirty", &GLCanvas::markSceneDirty, D(GLCanvas, markSceneDirty))
+        .def("sceneDirty", &GLCanvas::sceneDirty, D(GLCanvas, sceneDirty))
+        .def("setThreaded", [](GLCanvas &canvas, bool threaded, int bufferCount) {
+                /* The render thread acquires the GIL to call drawGL() */
+                py::gil_scoped_release release;
+                canvas.setThreaded(threaded, bufferCount);
+             }, py::arg("threaded"), py::arg("bufferCount") = 3, D(GLCanvas, setThreaded))
+        .def("threaded", &GLCanvas::threaded, D(GLCanvas, threaded))
+        .def("renderStats", &GLCanvas::renderStats, D(GLCanvas, renderStats))
+        .def("compositeStats", &GLCanvas::compositeStats, D(GLCanvas, compositeStats))
+        .def("freeGL", &GLCanvas::freeGL, D(GLCanvas, freeGL))
         .def("drawGL", &GLCanvas::drawGL, D(GLCanvas, drawGL));
+
+    py::class_<GLCanvas::FrameStats>(glcanvas, "FrameStats", D(GLCanvas, FrameStats))
+        .def_readonly("frames", &GLCanvas::FrameStats::frames, D(GLCanvas, FrameStats, frames))
+        .def_readonly("dropped", &GLCanvas::FrameStats::dropped, D(GLCanvas, FrameStats, dropped))
+        .def_readonly("frameTime", &GLCanvas::FrameStats::frameTime, D(GLCanvas, FrameStats, frameTime))
+        .def_readonly("workTime", &GLCanvas::FrameStats::workTime, D(GLCanvas, FrameStats, workTime))
+        .def("fps", &GLCanvas::FrameStats::fps, D(GLCanvas, FrameStats, fps));
 }
 
 #endif
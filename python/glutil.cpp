@@ -2,45 +2,128 @@
 
 #include "python.h"
 #include <pybind11/numpy.h>
+#include <cstring>
 
-static void uploadAttribPy(GLShader &sh, const std::string &name, py::array M, int version) {
-    if (M.ndim() != 2)
-        throw py::type_error("uploadAttrib(): expects 2D array");
-
-    M = py::array::ensure(M, py::array::f_style);
-
-    py::dtype dtype = M.dtype();
-    GLuint glType;
-    bool integral = true;
-
+/// Return the OpenGL type matching a NumPy dtype
+static GLuint glTypePy(const py::dtype &dtype, bool &integral, const char *fn) {
+    integral = true;
     if (dtype.kind() == 'i') {
         switch (dtype.itemsize()) {
-            case 1: glType = GL_BYTE; break;
-            case 2: glType = GL_SHORT; break;
-            case 4: glType = GL_INT; break;
-            default: throw py::type_error("uploadAttrib(): Invalid integer type!");
+            case 1: return GL_BYTE;
+            case 2: return GL_SHORT;
+            case 4: return GL_INT;
+            default: throw py::type_error(std::string(fn) + "(): Invalid integer type!");
         }
     } else if (dtype.kind() == 'u') {
         switch (dtype.itemsize()) {
-            case 1: glType = GL_UNSIGNED_BYTE; break;
-            case 2: glType = GL_UNSIGNED_SHORT; break;
-            case 4: glType = GL_UNSIGNED_INT; break;
-            default: throw py::type_error("uploadAttrib(): Invalid unsigned integer type!");
+            case 1: return GL_UNSIGNED_BYTE;
+            case 2: return GL_UNSIGNED_SHORT;
+            case 4: return GL_UNSIGNED_INT;
+            default: throw py::type_error(std::string(fn) + "(): Invalid unsigned integer type!");
         }
     } else if (dtype.kind() == 'f') {
+        integral = false;
         switch (dtype.itemsize()) {
-            case 2: glType = GL_HALF_FLOAT; break;
-            case 4: glType = GL_FLOAT; break;
-            case 8: glType = GL_DOUBLE; break;
-            default: throw py::type_error("uploadAttrib(): Invalid floating point type!");
+            case 2: return GL_HALF_FLOAT;
+            case 4: return GL_FLOAT;
+            case 8: return GL_DOUBLE;
+            default: throw py::type_error(std::string(fn) + "(): Invalid floating point type!");
         }
-        integral = false;
     } else {
-        throw py::type_error("uploadAttrib(): Invalid type!");
+        throw py::type_error(std::string(fn) + "(): Invalid type!");
+    }
+}
+
+/**
+ * Copy a strided 2D block of ``rows`` x ``cols`` items into tightly packed
+ * memory (row-major, i.e. the items of a row are adjacent)
+ */
+static void copyStrided(uint8_t *dst, const uint8_t *src, size_t rows, size_t cols,
+                        std::ptrdiff_t rowStride, std::ptrdiff_t colStride, size_t itemSize) {
+    size_t rowSize = cols * itemSize;
+    for (size_t i = 0; i < rows; ++i) {
+        const uint8_t *row = src + (std::ptrdiff_t) i * rowStride;
+        if (colStride == (std::ptrdiff_t) itemSize) {
+            memcpy(dst, row, rowSize);
+            dst += rowSize;
+        } else {
+            for (size_t j = 0; j < cols; ++j) {
+                memcpy(dst, row + (std::ptrdiff_t) j * colStride, itemSize);
+                dst += itemSize;
+            }
+        }
+    }
+}
+
+/* Upload a 1D array or a 2D array with one column per vertex. Column-major
+   (e.g. the transpose of a C-contiguous ``(n, dim)`` array) and 1D
+   contiguous arrays are uploaded in place; other layouts are gathered
+   directly into the mapped buffer without an intermediate copy. */
+static void uploadAttribPy(GLShader &sh, const std::string &name, py::array M, int version) {
+    if (M.ndim() != 1 && M.ndim() != 2)
+        throw py::type_error("uploadAttrib(): expects 1D or 2D array");
+
+    bool integral;
+    GLuint glType = glTypePy(M.dtype(), integral, "uploadAttrib");
+    size_t itemSize = (size_t) M.itemsize();
+    size_t dim = M.ndim() == 2 ? (size_t) M.shape(0) : 1;
+    size_t count = M.ndim() == 2 ? (size_t) M.shape(1) : (size_t) M.shape(0);
+    std::ptrdiff_t dimStride = M.ndim() == 2 ? (std::ptrdiff_t) M.strides(0) : (std::ptrdiff_t) itemSize;
+    std::ptrdiff_t countStride = M.ndim() == 2 ? (std::ptrdiff_t) M.strides(1) : (std::ptrdiff_t) M.strides(0);
+
+    bool packed = dimStride == (std::ptrdiff_t) itemSize &&
+                  (countStride == (std::ptrdiff_t) (dim * itemSize) || count <= 1);
+    if (packed || dim * count == 0) {
+        sh.uploadAttrib(name, dim * count, (int) dim, (uint32_t) itemSize,
+                        glType, integral, M.data(), version);
+        return;
     }
 
-    sh.uploadAttrib(name, M.shape(0) * M.shape(1), (int) M.shape(0),
-                    (uint32_t)M.itemsize(), glType, integral, M.data(), version);
+    /* Allocate the buffer, then gather the vertices into mapped memory */
+    sh.uploadAttrib(name, dim * count, (int) dim, (uint32_t) itemSize,
+                    glType, integral, nullptr, version);
+    if (!sh.hasAttrib(name))
+        return;
+    GLenum target = name == "indices" ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    uint8_t *ptr = (uint8_t *) glMapBufferRange(target, 0, dim * count * itemSize,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!ptr)
+        throw std::runtime_error("uploadAttrib(): glMapBufferRange() failed!");
+    copyStrided(ptr, (const uint8_t *) M.data(), count, dim, countStride,
+                dimStride, itemSize);
+    glUnmapBuffer(target);
+}
+
+/* Upload a ``(height, width)`` or ``(height, width, channels)`` array into a
+   region of a texture. C-contiguous arrays are copied once into the staging
+   buffer; other layouts are gathered into it directly. */
+static void updateTexturePy(GLTexture &texture, py::array data, const Vector2i &offset, int level) {
+    if (data.ndim() != 2 && data.ndim() != 3)
+        throw py::type_error("GLTexture.update(): expects 2D or 3D array");
+    size_t channels = data.ndim() == 3 ? (size_t) data.shape(2) : 1;
+    bool integral;
+    if (glTypePy(data.dtype(), integral, "GLTexture.update") != texture.type() ||
+        channels != (size_t) texture.channels())
+        throw py::type_error("GLTexture.update(): array does not match the texture format!");
+
+    Vector2i size((int) data.shape(1), (int) data.shape(0));
+    size_t itemSize = (size_t) data.itemsize();
+    size_t pixelSize = channels * itemSize;
+    std::ptrdiff_t channelStride = data.ndim() == 3 ? (std::ptrdiff_t) data.strides(2) : (std::ptrdiff_t) itemSize;
+    uint8_t *ptr = texture.map(offset, size, level);
+
+    if (channelStride == (std::ptrdiff_t) itemSize) {
+        copyStrided(ptr, (const uint8_t *) data.data(), (size_t) size.y(), (size_t) size.x(),
+                    (std::ptrdiff_t) data.strides(0), (std::ptrdiff_t) data.strides(1), pixelSize);
+    } else {
+        for (int y = 0; y < size.y(); ++y) {
+            const uint8_t *row = (const uint8_t *) data.data() + (std::ptrdiff_t) y * (std::ptrdiff_t) data.strides(0);
+            copyStrided(ptr, row, (size_t) size.x(), channels, (std::ptrdiff_t) data.strides(1),
+                        channelStride, itemSize);
+            ptr += (size_t) size.x() * pixelSize;
+        }
+    }
+    texture.unmap();
 }
 
 static void setUniformPy(GLShader &sh, const std::string &name, py::object arg, bool warn = true) {
@@ -137,6 +220,41 @@ void register_glutil(py::module &m) {
         .def("setUniform", &setUniformPy, py::arg("name"),
              py::arg("value"), py::arg("warn") = true);
 
+    py::class_<GLTexture>(m, "GLTexture", D(GLTexture))
+        .def(py::init<>())
+        .def("init", (void (GLTexture::*)(const Vector2i &, GLenum, int)) &GLTexture::init,
+             py::arg("size"), py::arg("internalFormat"), py::arg("levels") = 1,
+             D(GLTexture, init))
+        .def("init", [](GLTexture &texture, py::array data, int levels, bool normalized) {
+                if (data.ndim() != 2 && data.ndim() != 3)
+                    throw py::type_error("GLTexture.init(): expects 2D or 3D array");
+                bool integral;
+                GLuint glType = glTypePy(data.dtype(), integral, "GLTexture.init");
+                int channels = data.ndim() == 3 ? (int) data.shape(2) : 1;
+                texture.init(Vector2i((int) data.shape(1), (int) data.shape(0)),
+                             GLTexture::internalFormat(glType, channels, normalized && integral),
+                             levels);
+                updateTexturePy(texture, data, Vector2i::Zero(), 0);
+             }, py::arg("data"), py::arg("levels") = 1, py::arg("normalized") = true,
+             D(GLTexture, init, 2))
+        .def("free", &GLTexture::free, D(GLTexture, free))
+        .def("ready", &GLTexture::ready, D(GLTexture, ready))
+        .def("texture", &GLTexture::texture, D(GLTexture, texture))
+        .def("size", (const Vector2i &(GLTexture::*)() const) &GLTexture::size, D(GLTexture, size))
+        .def("size", (Vector2i (GLTexture::*)(int) const) &GLTexture::size, D(GLTexture, size, 2))
+        .def("levels", &GLTexture::levels, D(GLTexture, levels))
+        .def("channels", &GLTexture::channels, D(GLTexture, channels))
+        .def("internalFormat", (GLenum (GLTexture::*)() const) &GLTexture::internalFormat,
+             D(GLTexture, internalFormat))
+        .def("type", &GLTexture::type, D(GLTexture, type))
+        .def("bind", &GLTexture::bind, py::arg("unit") = 0, D(GLTexture, bind))
+        .def("release", &GLTexture::release, py::arg("unit") = 0, D(GLTexture, release))
+        .def("setFilter", &GLTexture::setFilter, D(GLTexture, setFilter))
+        .def("setWrap", &GLTexture::setWrap, D(GLTexture, setWrap))
+        .def("update", &updateTexturePy, py::arg("data"),
+             py::arg("offset") = Vector2i(0, 0), py::arg("level") = 0, D(GLTexture, update, 2))
+        .def("generateMipmaps", &GLTexture::generateMipmaps, D(GLTexture, generateMipmaps));
+
     py::class_<Arcball>(m, "Arcball", D(Arcball))
         .def(py::init<float>(), py::arg("speedFactor") = 2.f, D(Arcball, Arcball))
         .def(py::init<const Quaternionf &>(), D(Arcball, Arcball, 2))
@@ -207,6 +325,12 @@ void register_glutil(py::module &m) {
     /* Remaining glEnable/glDisable enums */
     C(SCISSOR_TEST); C(STENCIL_TEST); C(PROGRAM_POINT_SIZE);
     C(LINE_SMOOTH); C(POLYGON_SMOOTH); C(CULL_FACE);
+
+    /* Texture formats and parameters */
+    C(R8); C(RG8); C(RGB8); C(RGBA8); C(SRGB8_ALPHA8); C(R16F); C(RG16F);
+    C(RGBA16F); C(R32F); C(RG32F); C(RGBA32F); C(NEAREST); C(LINEAR);
+    C(NEAREST_MIPMAP_NEAREST); C(LINEAR_MIPMAP_LINEAR); C(CLAMP_TO_EDGE);
+    C(REPEAT); C(MIRRORED_REPEAT);
 }
 
 #endif
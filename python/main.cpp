@@ -51,6 +51,7 @@ extern void register_formhelper(py::module &m);
 extern void register_misc(py::module &m);
 extern void register_glutil(py::module &m);
 extern void register_nanovg(py::module &m);
+extern void register_bulk(py::module &m);
 
 class MainloopHandle;
 static MainloopHandle *handle = nullptr;
@@ -102,6 +103,178 @@ public:
     }
 };
 
+/* State of a main loop that runs as a task on an asyncio event loop. GLFW
+   may only wait for events on the main thread, which would block the event
+   loop, so events are polled: once per frame while the user interacts, and
+   with a period that backs off up to 'idlePeriod' otherwise */
+struct AsyncMainloop {
+    py::object loop;
+    py::object future;
+    py::object tick;
+    py::object handle;
+    double framePeriod = 1.0 / 60.0;
+    double idlePeriod = 0.1;
+    double period = 1.0 / 60.0;
+    double refresh = 0.05;
+    double lastDraw = 0;
+    double lastInteraction = -1;
+    bool redraw = true;
+    bool active = true;
+};
+
+static AsyncMainloop *async_mainloop = nullptr;
+
+static void async_mainloop_finish(py::object exception = py::none()) {
+    AsyncMainloop *state = async_mainloop;
+    async_mainloop = nullptr;
+
+    if (!state->future.attr("done")().cast<bool>()) {
+        if (exception == py::none())
+            state->future.attr("set_result")(py::none());
+        else
+            state->future.attr("set_exception")(exception);
+    }
+    delete state;
+}
+
+/* Called on the event loop: processes the pending events without blocking,
+   and redraws if the user interacted with a screen, an asynchronous callback
+   finished, or the refresh interval elapsed */
+static void async_mainloop_tick() {
+    AsyncMainloop *state = async_mainloop;
+    if (!state)
+        return;
+
+    state->handle = py::object();
+    bool alive = state->active, busy = false;
+    try {
+        py::gil_scoped_release release;
+        if (alive)
+            alive = mainloop_iteration(0, false);
+
+        if (alive && state->active) {
+            double now = glfwGetTime(), interaction = last_interaction();
+
+            /* Keep drawing at the full frame rate for a moment after an
+               interaction so that animations triggered by it run smoothly */
+            busy = state->redraw || interaction != state->lastInteraction ||
+                   now - interaction < 1.0;
+            if (busy || (state->refresh > 0 && now - state->lastDraw >= state->refresh)) {
+                state->redraw = false;
+                state->lastInteraction = interaction;
+                state->lastDraw = now;
+                alive = mainloop_iteration(0, true);
+            }
+        }
+    } catch (const std::exception &e) {
+        py::object error = py::module::import("builtins").attr("RuntimeError");
+        async_mainloop_finish(error(py::str(e.what())));
+        return;
+    }
+
+    if (!alive || !state->active) {
+        async_mainloop_finish();
+        return;
+    }
+
+    /* Poll less often while idle, but not past the next refresh */
+    state->period = busy ? state->framePeriod
+                         : std::min(state->period * 2, state->idlePeriod);
+    double delay = state->period;
+    if (state->refresh > 0)
+        delay = std::min(delay, std::max(0.0, state->lastDraw + state->refresh - glfwGetTime()));
+    state->handle = state->loop.attr("call_later")(delay, state->tick);
+}
+
+/* Run the next tick right away, e.g. when an asynchronous callback finished */
+static void async_mainloop_wake() {
+    AsyncMainloop *state = async_mainloop;
+    if (!state || !state->handle)
+        return;
+    state->handle.attr("cancel")();
+    state->period = state->framePeriod;
+    state->handle = state->loop.attr("call_soon")(state->tick);
+}
+
+/* Schedule the coroutine returned by an 'async def' widget callback */
+static void async_schedule(py::object coro) {
+    py::module asyncio = py::module::import("asyncio");
+    py::object loop = asyncio.attr("get_event_loop")();
+
+    if (!loop.attr("is_running")().cast<bool>()) {
+        /* Invoked from the blocking main loop: run to completion */
+        loop.attr("run_until_complete")(coro);
+        return;
+    }
+
+    py::object task = asyncio.attr("ensure_future")(coro);
+    task.attr("add_done_callback")(py::cpp_function([](py::object task) {
+        if (async_mainloop) {
+            async_mainloop->redraw = true;
+            async_mainloop_wake();
+        }
+        /* Re-raise exceptions so that the event loop reports them */
+        if (!task.attr("cancelled")().cast<bool>())
+            task.attr("result")();
+    }));
+}
+
+/* Replace coroutine functions by a callable that schedules them */
+static py::object async_callback(py::object callback) {
+    py::object iscoroutinefunction =
+        py::module::import("inspect").attr("iscoroutinefunction");
+    if (!iscoroutinefunction(callback).cast<bool>())
+        return callback;
+    /* Callbacks that return a value (e.g. of a TextBox) accept the input */
+    return py::cpp_function([callback](py::args args) {
+        async_schedule(callback(*args));
+        return true;
+    });
+}
+
+/* Event callbacks that may be coroutine functions. Their C++ signatures
+   return 'void' or 'bool', so scheduling the coroutine and returning
+   immediately is safe. Callbacks whose result is consumed (e.g. the pixel
+   info callback of ImageView) or that must finish before returning (e.g.
+   the release callback of LazyPage) are deliberately left out. */
+static const char *async_callbacks[][2] = {
+    { "Button", "setCallback" },      { "Button", "setChangeCallback" },
+    { "CheckBox", "setCallback" },    { "ColorPicker", "setCallback" },
+    { "ColorPicker", "setFinalCallback" },
+    { "ColorWheel", "setCallback" },  { "ComboBox", "setCallback" },
+    { "ImagePanel", "setCallback" },  { "MessageDialog", "setCallback" },
+    { "Slider", "setCallback" },      { "Slider", "setFinalCallback" },
+    { "TabHeader", "setCallback" },   { "TabWidget", "setCallback" },
+    { "TextArea", "setCallback" },    { "TextBox", "setCallback" },
+    { "IntBox", "setCallback" },      { "FloatBox", "setCallback" },
+    { "Screen", "setResizeCallback" }
+};
+
+/* Let the event callback setters listed above accept coroutine functions */
+static void register_async_callbacks(py::module &m) {
+    for (auto &entry : async_callbacks) {
+        py::object cls = m.attr(entry[0]);
+        py::object method = cls.attr(entry[1]);
+        py::object docObj = method.attr("__doc__");
+        std::string doc = docObj.ptr() == Py_None ? "" : std::string(py::str(docObj));
+
+        /* Forward all arguments to keep the original keyword names */
+        cls.attr(entry[1]) = py::cpp_function(
+            [method](py::args args, py::kwargs kwargs) {
+                py::tuple tuple(args.size());
+                for (size_t i = 0; i < args.size(); ++i) {
+                    py::object arg = args[i];
+                    tuple[i] = i == 1 ? async_callback(arg) : arg;
+                }
+                py::dict dict;
+                for (auto item : kwargs)
+                    dict[item.first] = async_callback(
+                        py::reinterpret_borrow<py::object>(item.second));
+                return method(*tuple, **dict);
+            }, py::name(entry[1]), py::is_method(cls), doc.c_str());
+    }
+}
+
 #if defined(__APPLE__) || defined(__linux__)
 static void (*sigint_handler_prev)(int) = nullptr;
 static void sigint_handler(int sig) {
@@ -206,8 +379,36 @@ PYBIND11_PLUGIN(nanogui) {
     }, py::arg("refresh") = 50, py::arg("detach") = py::none(),
        D(mainloop), py::keep_alive<0, 2>());
 
-    m.def("leave", &nanogui::leave, D(leave));
-    m.def("active", &nanogui::active, D(active));
+    m.def("mainloop_iteration", [](double timeout, bool draw) {
+        py::gil_scoped_release release;
+        return mainloop_iteration(timeout, draw);
+    }, py::arg("timeout") = 0.0, py::arg("draw") = true, D(mainloop_iteration));
+    m.def("last_interaction", &nanogui::last_interaction, D(last_interaction));
+
+    m.def("mainloop_async", [](int refresh) -> py::object {
+        if (async_mainloop || nanogui::active())
+            throw std::runtime_error("Main loop is already running!");
+
+        py::object loop = py::module::import("asyncio").attr("get_event_loop")();
+        async_mainloop = new AsyncMainloop();
+        async_mainloop->loop = loop;
+        async_mainloop->future = loop.attr("create_future")();
+        async_mainloop->refresh = refresh / 1000.0;
+        async_mainloop->tick = py::cpp_function(&async_mainloop_tick);
+        async_mainloop->handle = loop.attr("call_soon")(async_mainloop->tick);
+        return async_mainloop->future;
+    }, py::arg("refresh") = 50, D(mainloop_async));
+
+    m.def("leave", []() {
+        nanogui::leave();
+        if (async_mainloop) {
+            async_mainloop->active = false;
+            async_mainloop_wake();
+        }
+    }, D(leave));
+    m.def("active", []() {
+        return nanogui::active() || async_mainloop != nullptr;
+    }, D(active));
     m.def("file_dialog", (std::string(*)(const std::vector<std::pair<std::string, std::string>> &, bool)) &nanogui::file_dialog, D(file_dialog));
     m.def("file_dialog", (std::vector<std::string>(*)(const std::vector<std::pair<std::string, std::string>> &, bool, bool)) &nanogui::file_dialog, D(file_dialog, 2));
     #if defined(__APPLE__)
@@ -248,6 +449,8 @@ PYBIND11_PLUGIN(nanogui) {
     register_misc(m);
     register_glutil(m);
     register_nanovg(m);
+    register_bulk(m);
+    register_async_callbacks(m);
 
     return m.ptr();
 }
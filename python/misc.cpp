@@ -1,6 +1,9 @@
 #ifdef NANOGUI_PYTHON
 
 #include "python.h"
+#include <pybind11/numpy.h>
+#include <cstring>
+#include <unordered_map>
 
 DECLARE_WIDGET(ColorWheel);
 DECLARE_WIDGET(ColorPicker);
@@ -8,6 +11,9 @@ DECLARE_WIDGET(Graph);
 DECLARE_WIDGET(ImageView);
 DECLARE_WIDGET(ImagePanel);
 
+/* Number of NumPy views returned by Graph.values() that are still alive */
+static std::unordered_map<const Graph *, int> graphViews;
+
 void register_misc(py::module &m) {
     py::class_<ColorWheel, Widget, ref<ColorWheel>, PyColorWheel>(m, "ColorWheel", D(ColorWheel))
         .def(py::init<Widget *>(), py::arg("parent"), D(ColorWheel, ColorWheel))
@@ -42,8 +48,46 @@ void register_misc(py::module &m) {
         .def("setForegroundColor", &Graph::setForegroundColor, D(Graph, setForegroundColor))
         .def("textColor", &Graph::textColor, D(Graph, textColor))
         .def("setTextColor", &Graph::setTextColor, D(Graph, setTextColor))
-        .def("values", (VectorXf &(Graph::*)(void)) &Graph::values, D(Graph, values))
-        .def("setValues", &Graph::setValues, D(Graph, setValues));
+        .def("values", [](Graph &graph) {
+                /* The view keeps the graph alive and is counted, so that
+                   setValues() can refuse to reallocate the storage */
+                graph.incRef();
+                graphViews[&graph]++;
+                py::capsule base(&graph, [](PyObject *o) {
+                    Graph *graph = (Graph *) PyCapsule_GetPointer(o, nullptr);
+                    if (--graphViews[graph] == 0)
+                        graphViews.erase(graph);
+                    graph->decRef();
+                });
+                VectorXf &values = graph.values();
+                return py::array_t<float>({ (size_t) values.size() }, { sizeof(float) },
+                                          values.data(), base);
+             }, D(Graph, values))
+        .def("setValues", [](Graph &graph, py::array_t<float, py::array::forcecast> values) {
+                if (values.ndim() != 1)
+                    throw py::type_error("Graph.setValues(): expects 1D array");
+                /* Copy straight from the (possibly strided) array */
+                size_t size = (size_t) values.shape(0);
+                std::ptrdiff_t stride = (std::ptrdiff_t) values.strides(0);
+                const uint8_t *src = (const uint8_t *) values.data();
+                VectorXf &dst = graph.values();
+                /* The storage is reused unless the number of values changes,
+                   which is refused while views of it exist (like the reference
+                   check of ndarray.resize()) */
+                if ((size_t) dst.size() != size && graphViews.count(&graph)) {
+                    PyErr_SetString(PyExc_ValueError,
+                                    "Graph.setValues(): cannot change the number of values "
+                                    "while arrays returned by Graph.values() are alive");
+                    throw py::error_already_set();
+                }
+                dst.resize((Eigen::Index) size);
+                if (stride == (std::ptrdiff_t) sizeof(float)) {
+                    memcpy(dst.data(), src, size * sizeof(float));
+                } else {
+                    for (size_t i = 0; i < size; ++i)
+                        dst[i] = *(const float *) (src + (std::ptrdiff_t) i * stride);
+                }
+             }, D(Graph, setValues));
 
     py::class_<ImageView, Widget, ref<ImageView>, PyImageView>(m, "ImageView", D(ImageView))
         .def(py::init<Widget *, GLuint>(), D(ImageView, ImageView))
@@ -1,7 +1,111 @@
 #include "python.h"
+#include <pybind11/numpy.h>
 
 using namespace pybind11::literals;
 
+using FloatArray = py::array_t<float, py::array::forcecast | py::array::c_style>;
+using CountArray = py::array_t<uint32_t, py::array::forcecast | py::array::c_style>;
+
+/* Return the number of rows of an array with shape (n, cols) */
+static size_t batchRows(const FloatArray &array, size_t cols, const char *name) {
+    if (array.ndim() != 2 || (size_t) array.shape(1) != cols)
+        throw py::type_error(std::string(name) + ": expects an array of shape (n, " +
+                             std::to_string(cols) + ")");
+    return (size_t) array.shape(0);
+}
+
+/* Optional per-item colors of a batched drawing call, given as an (n, 4)
+   array of RGBA values in [0, 1] */
+struct BatchColors {
+    FloatArray array;
+    bool present;
+
+    BatchColors(py::object colors, size_t n, const char *name)
+        : present(colors != py::none()) {
+        if (!present)
+            return;
+        array = FloatArray(colors);
+        if (batchRows(array, 4, name) != n)
+            throw py::type_error(std::string(name) + ": expects one color per item");
+    }
+
+    NVGcolor operator[](size_t i) const {
+        const float *c = array.data() + 4 * i;
+        return nvgRGBAf(c[0], c[1], c[2], c[3]);
+    }
+
+    bool same(size_t i, size_t j) const {
+        return std::equal(array.data() + 4 * i, array.data() + 4 * (i + 1),
+                          array.data() + 4 * j);
+    }
+};
+
+/* Emit 'n' shapes with the GIL released. Without colors, the shapes are
+   appended to the current path (to be filled or stroked by the caller).
+   Otherwise, each run of items sharing a color becomes one path that is
+   filled or stroked with that color. */
+template <typename Func>
+static void batchDraw(NVGcontext *ctx, size_t n, const BatchColors &colors,
+                      bool stroke, const Func &shape) {
+    py::gil_scoped_release release;
+
+    if (!colors.present) {
+        for (size_t i = 0; i < n; ++i)
+            shape(i);
+        return;
+    }
+
+    for (size_t i = 0; i < n; ) {
+        size_t j = i;
+        nvgBeginPath(ctx);
+        do {
+            shape(j++);
+        } while (j < n && colors.same(i, j));
+
+        if (stroke) {
+            nvgStrokeColor(ctx, colors[i]);
+            nvgStroke(ctx);
+        } else {
+            nvgFillColor(ctx, colors[i]);
+            nvgFill(ctx);
+        }
+        i = j;
+    }
+}
+
+/* Draw polylines stored back to back in 'points'; 'counts' holds the number
+   of vertices of each one (a single polyline if not specified) */
+static void polylinesPy(NVGcontext *ctx, FloatArray points, py::object counts_,
+                        bool closed, py::object colors_, bool stroke) {
+    size_t total = batchRows(points, 2, "Polylines()");
+    std::vector<size_t> offsets(1, 0);
+    if (counts_ == py::none()) {
+        offsets.push_back(total);
+    } else {
+        CountArray counts(counts_);
+        if (counts.ndim() != 1)
+            throw py::type_error("Polylines(): expects a 1D array of vertex counts");
+        for (size_t i = 0; i < (size_t) counts.shape(0); ++i)
+            offsets.push_back(offsets.back() + counts.data()[i]);
+        if (offsets.back() != total)
+            throw py::type_error("Polylines(): vertex counts do not match the number of points");
+    }
+
+    size_t n = offsets.size() - 1;
+    BatchColors colors(colors_, n, "Polylines()");
+    const float *p = points.data();
+    batchDraw(ctx, n, colors, stroke, [&](size_t i) {
+        size_t begin = offsets[i], end = offsets[i + 1];
+        if (begin == end)
+            return;
+        nvgMoveTo(ctx, p[2 * begin], p[2 * begin + 1]);
+        for (size_t k = begin + 1; k < end; ++k)
+            nvgLineTo(ctx, p[2 * k], p[2 * k + 1]);
+        if (closed)
+            nvgClosePath(ctx);
+    });
+}
+
 void register_nanovg(py::module &m) {
     /* NanoVG */
 
@@ -187,6 +291,68 @@ void register_nanovg(py::module &m) {
                  return std::make_tuple(bounds[0], bounds[1], bounds[2], bounds[3]);
              },
              "x"_a, "y"_a, "breakRowWidth"_a, "string"_a)
+        .def("Polylines", &polylinesPy, "points"_a, "counts"_a = py::none(),
+             "closed"_a = false, "colors"_a = py::none(), "stroke"_a = true,
+             "Add polylines given by an (n, 2) array of vertices (split by "
+             "'counts'); with per-item colors, stroke or fill them directly")
+        .def("Polygons",
+             [](NVGcontext *ctx, FloatArray points, py::object counts,
+                py::object colors, bool stroke) {
+                 polylinesPy(ctx, points, counts, true, colors, stroke);
+             }, "points"_a, "counts"_a = py::none(), "colors"_a = py::none(),
+             "stroke"_a = false,
+             "Add closed polygons given by an (n, 2) array of vertices (split "
+             "by 'counts'); with per-item colors, fill or stroke them directly")
+        .def("Circles",
+             [](NVGcontext *ctx, FloatArray centers, FloatArray radii,
+                py::object colors_, bool stroke) {
+                 size_t n = batchRows(centers, 2, "Circles()");
+                 size_t nr = (size_t) radii.size();
+                 if (nr != 1 && nr != n)
+                     throw py::type_error("Circles(): expects one radius or one per circle");
+                 BatchColors colors(colors_, n, "Circles()");
+                 const float *c = centers.data(), *r = radii.data();
+                 batchDraw(ctx, n, colors, stroke, [&](size_t i) {
+                     nvgCircle(ctx, c[2 * i], c[2 * i + 1], r[nr == 1 ? 0 : i]);
+                 });
+             }, "centers"_a, "radii"_a, "colors"_a = py::none(),
+             "stroke"_a = false,
+             "Add circles given by an (n, 2) array of centers and one or n "
+             "radii; with per-item colors, fill or stroke them directly")
+        .def("Rects",
+             [](NVGcontext *ctx, FloatArray rects, float radius,
+                py::object colors_, bool stroke) {
+                 size_t n = batchRows(rects, 4, "Rects()");
+                 BatchColors colors(colors_, n, "Rects()");
+                 const float *r = rects.data();
+                 batchDraw(ctx, n, colors, stroke, [&](size_t i) {
+                     if (radius > 0)
+                         nvgRoundedRect(ctx, r[4 * i], r[4 * i + 1], r[4 * i + 2], r[4 * i + 3], radius);
+                     else
+                         nvgRect(ctx, r[4 * i], r[4 * i + 1], r[4 * i + 2], r[4 * i + 3]);
+                 });
+             }, "rects"_a, "radius"_a = 0.f, "colors"_a = py::none(),
+             "stroke"_a = false,
+             "Add rectangles given by an (n, 4) array of (x, y, w, h) rows; "
+             "with per-item colors, fill or stroke them directly")
+        .def("Texts",
+             [](NVGcontext *ctx, FloatArray points,
+                const std::vector<std::string> &strings, py::object colors_) {
+                 size_t n = batchRows(points, 2, "Texts()");
+                 if (strings.size() != n)
+                     throw py::type_error("Texts(): expects one string per point");
+                 BatchColors colors(colors_, n, "Texts()");
+                 const float *p = points.data();
+
+                 py::gil_scoped_release release;
+                 for (size_t i = 0; i < n; ++i) {
+                     if (colors.present && (i == 0 || !colors.same(i - 1, i)))
+                         nvgFillColor(ctx, colors[i]);
+                     nvgText(ctx, p[2 * i], p[2 * i + 1], strings[i].c_str(), nullptr);
+                 }
+             }, "points"_a, "strings"_a, "colors"_a = py::none(),
+             "Draw one string at each row of an (n, 2) array of positions, "
+             "optionally with per-item colors")
         .def("BeginFrame", &nvgBeginFrame, "windowWidth"_a, "windowHeight"_a,
              "devicePixelRatio"_a)
         .def("CancelFrame", &nvgCancelFrame)
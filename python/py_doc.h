@@ -862,7 +862,15 @@ static const char *__doc_nanogui_Color_r = R"doc(Return a reference to the red c
 
 static const char *__doc_nanogui_Color_r_2 = R"doc(Return a reference to the red channel (const version))doc";
 
-static const char *__doc_nanogui_ComboBox = R"doc(Simple combo box widget based on a popup button.)doc";
+static const char *__doc_nanogui_ComboBox =
+R"doc(Simple combo box widget based on a popup button.
+
+By default, the popup contains one radio button per item. For long item
+lists, setVirtualized() replaces them by a single scrollable list that
+is drawn directly from items() and only draws the visible rows. Typing
+while the popup is open filters the list to the items that start with
+the typed text; the required prefix index is built on a worker thread
+whenever the items change.)doc";
 
 static const char *__doc_nanogui_ComboBox_ComboBox = R"doc(Create an empty combo box)doc";
 
@@ -872,22 +880,56 @@ static const char *__doc_nanogui_ComboBox_ComboBox_3 =
 R"doc(Create a new combo box with the given items, providing both short and
 long descriptive labels for each item)doc";
 
+static const char *__doc_nanogui_ComboBox_PrefixIndex =
+R"doc(Item labels in lower case along with their index, sorted for prefix search.)doc";
+
+static const char *__doc_nanogui_ComboBox_PrefixIndex_entries = R"doc()doc";
+
 static const char *__doc_nanogui_ComboBox_callback = R"doc(The callback to execute for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_filter = R"doc(The type-ahead filter of the virtualized list.)doc";
+
+static const char *__doc_nanogui_ComboBox_filteredCount = R"doc(The number of items that match the filter.)doc";
+
+static const char *__doc_nanogui_ComboBox_filteredItem = R"doc(The index of the item shown in the given row of the virtualized list.)doc";
+
 static const char *__doc_nanogui_ComboBox_items = R"doc(The items associated with this ComboBox.)doc";
 
 static const char *__doc_nanogui_ComboBox_itemsShort = R"doc(The short descriptions associated with this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_keyboardCharacterEvent = R"doc(Forwards text input to the virtualized list while the popup is open.)doc";
+
+static const char *__doc_nanogui_ComboBox_keyboardEvent = R"doc(Forwards key presses to the virtualized list while the popup is open.)doc";
+
 static const char *__doc_nanogui_ComboBox_load = R"doc(Sets the state of this ComboBox from the specified Serializer.)doc";
 
 static const char *__doc_nanogui_ComboBox_mCallback = R"doc(The callback for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_mFilter = R"doc(The type-ahead filter of the virtualized list.)doc";
+
+static const char *__doc_nanogui_ComboBox_mFilterActive =
+R"doc(Whether the filter is non-empty, in which case mFiltered lists the matching items.)doc";
+
+static const char *__doc_nanogui_ComboBox_mFiltered = R"doc(The indices of the items that match the filter, in ascending order.)doc";
+
+static const char *__doc_nanogui_ComboBox_mIndex =
+R"doc(Receives the prefix index of the items from the worker thread that
+builds it.)doc";
+
 static const char *__doc_nanogui_ComboBox_mItems = R"doc(The items associated with this ComboBox.)doc";
 
 static const char *__doc_nanogui_ComboBox_mItemsShort = R"doc(The short descriptions of items associated with this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_mList =
+R"doc(The virtualized list inside the popup (``nullptr`` unless virtualized).)doc";
+
 static const char *__doc_nanogui_ComboBox_mSelectedIndex = R"doc(The current index this ComboBox has selected.)doc";
 
+static const char *__doc_nanogui_ComboBox_mVisibleRows = R"doc(The number of rows shown at once by the virtualized list.)doc";
+
+static const char *__doc_nanogui_ComboBox_mouseButtonEvent =
+R"doc(Scrolls the virtualized list to the selected item when the popup opens.)doc";
+
 static const char *__doc_nanogui_ComboBox_operator_delete = R"doc()doc";
 
 static const char *__doc_nanogui_ComboBox_operator_delete_2 = R"doc()doc";
@@ -912,14 +954,24 @@ static const char *__doc_nanogui_ComboBox_operator_new_4 = R"doc()doc";
 
 static const char *__doc_nanogui_ComboBox_operator_new_5 = R"doc()doc";
 
+static const char *__doc_nanogui_ComboBox_rebuildPopup = R"doc(Recreates the popup contents for the current items.)doc";
+
 static const char *__doc_nanogui_ComboBox_save = R"doc(Saves the state of this ComboBox to the specified Serializer.)doc";
 
 static const char *__doc_nanogui_ComboBox_scrollEvent = R"doc(Handles mouse scrolling events for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_selectItem = R"doc(Selects an item, closes the popup and invokes the callback.)doc";
+
 static const char *__doc_nanogui_ComboBox_selectedIndex = R"doc(The current index this ComboBox has selected.)doc";
 
 static const char *__doc_nanogui_ComboBox_setCallback = R"doc(Sets the callback to execute for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_setFilter =
+R"doc(Sets the type-ahead filter of the virtualized list.
+
+Only items whose label starts with the filter are listed; the
+comparison ignores the case of ASCII characters.)doc";
+
 static const char *__doc_nanogui_ComboBox_setItems =
 R"doc(Sets the items for this ComboBox, providing both short and long
 descriptive lables for each item.)doc";
@@ -928,6 +980,18 @@ static const char *__doc_nanogui_ComboBox_setItems_2 = R"doc(Sets the items for
 
 static const char *__doc_nanogui_ComboBox_setSelectedIndex = R"doc(Sets the current index this ComboBox has selected.)doc";
 
+static const char *__doc_nanogui_ComboBox_setVirtualized =
+R"doc(Sets whether the popup shows a virtualized list instead of one button per item.)doc";
+
+static const char *__doc_nanogui_ComboBox_setVisibleRows = R"doc(Sets the number of rows shown at once by the virtualized list.)doc";
+
+static const char *__doc_nanogui_ComboBox_updateFilter = R"doc(Recomputes the items matching the filter.)doc";
+
+static const char *__doc_nanogui_ComboBox_virtualized =
+R"doc(Whether the popup shows a virtualized list instead of one button per item.)doc";
+
+static const char *__doc_nanogui_ComboBox_visibleRows = R"doc(The number of rows shown at once by the virtualized list.)doc";
+
 static const char *__doc_nanogui_Cursor =
 R"doc(Cursor shapes available to use in GLFW. Shape of actual cursor
 determined by Operating System.)doc";
@@ -948,6 +1012,26 @@ static const char *__doc_nanogui_Cursor_IBeam = R"doc(< The I-beam cursor.)doc";
 
 static const char *__doc_nanogui_Cursor_VResize = R"doc(< The vertical resize cursor.)doc";
 
+static const char *__doc_nanogui_Field =
+R"doc(Name and member pointer of a field of a reflected struct (see
+NANOGUI_REFLECT).
+
+Template parameter ``Class``:
+    The struct containing the field.
+
+Template parameter ``Type``:
+    The type of the field.)doc";
+
+static const char *__doc_nanogui_Field_Field = R"doc()doc";
+
+static const char *__doc_nanogui_Field_get = R"doc(Access the field of an object)doc";
+
+static const char *__doc_nanogui_Field_get_2 = R"doc(Access the field of an object)doc";
+
+static const char *__doc_nanogui_Field_member = R"doc(Pointer to the field)doc";
+
+static const char *__doc_nanogui_Field_name = R"doc(The name of the field (as written in the struct declaration))doc";
+
 static const char *__doc_nanogui_FloatBox =
 R"doc(A specialization of TextBox representing floating point values.
 
@@ -1039,12 +1123,76 @@ h->addButton("Button", [&]() { std::cout << "Button pressed" << std::endl; });
 
 ```)doc";
 
+static const char *__doc_nanogui_FormHelper_Binding = R"doc(A variable exposed by the form and the widget showing it.)doc";
+
+static const char *__doc_nanogui_FormHelper_Binding_interval = R"doc(Minimum number of seconds between two polls (negative: push-only))doc";
+
+static const char *__doc_nanogui_FormHelper_Binding_lastPoll = R"doc(Time of the last poll)doc";
+
+static const char *__doc_nanogui_FormHelper_Binding_object = R"doc(The struct added by addStruct() (``nullptr`` for single variables))doc";
+
+static const char *__doc_nanogui_FormHelper_Binding_update = R"doc(Pushes changed values into the widgets and returns the number of updated widgets)doc";
+
+static const char *__doc_nanogui_FormHelper_Binding_widget = R"doc(The widget that shows the variable (``nullptr`` for structs))doc";
+
 static const char *__doc_nanogui_FormHelper_FormHelper = R"doc(Create a helper class to construct NanoGUI widgets on the given screen)doc";
 
+static const char *__doc_nanogui_FormHelper_StructAdder = R"doc(Creates the widget of each field of a struct (see addStruct()).)doc";
+
+static const char *__doc_nanogui_FormHelper_StructAdder_cache = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructAdder_editable = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructAdder_helper = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructAdder_object = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructAdder_operator_call = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructAdder_widgets = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater =
+R"doc(Pushes the changed fields of a struct into their widgets (see
+addStruct()).)doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_Visitor = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_Visitor_cache = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_Visitor_object = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_Visitor_operator_call = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_Visitor_updated = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_Visitor_widget = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_cache = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_object = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_operator_call = R"doc()doc";
+
+static const char *__doc_nanogui_FormHelper_StructUpdater_widgets = R"doc()doc";
+
 static const char *__doc_nanogui_FormHelper_addButton = R"doc(Add a button with a custom callback)doc";
 
 static const char *__doc_nanogui_FormHelper_addGroup = R"doc(Add a new group that may contain several sub-widgets)doc";
 
+static const char *__doc_nanogui_FormHelper_addStruct =
+R"doc(Add a data widget for every field of a struct whose fields were
+declared with NANOGUI_REFLECT.
+
+The widgets are labeled with the field names. Instead of a getter and
+setter per field, all fields share a single binding that compares the
+struct field by field against a cached copy (see refresh()) and
+accesses the fields through member pointers of their static type. Use
+notifyStruct() for push-style updates.
+
+Returns:
+    The widgets in the order of the fields (e.g. to set the items of
+    the ComboBox of an ``enum`` field).)doc";
+
 static const char *__doc_nanogui_FormHelper_addVariable = R"doc(Add a new data widget controlled using custom getter/setter functions)doc";
 
 static const char *__doc_nanogui_FormHelper_addVariable_2 = R"doc(Add a new data widget that exposes a raw variable in memory)doc";
@@ -1053,6 +1201,8 @@ static const char *__doc_nanogui_FormHelper_addWidget = R"doc(Add an arbitrary (
 
 static const char *__doc_nanogui_FormHelper_addWindow = R"doc(Add a new top-level window)doc";
 
+static const char *__doc_nanogui_FormHelper_createVariableWidget = R"doc(Create a labeled data widget and append it to the layout.)doc";
+
 static const char *__doc_nanogui_FormHelper_fixedSize = R"doc(The current fixed size being used for newly added widgets.)doc";
 
 static const char *__doc_nanogui_FormHelper_groupFontName = R"doc(The font name being used for group headers.)doc";
@@ -1063,6 +1213,8 @@ static const char *__doc_nanogui_FormHelper_labelFontName = R"doc(The font name
 
 static const char *__doc_nanogui_FormHelper_labelFontSize = R"doc(The size of the font being used for labels.)doc";
 
+static const char *__doc_nanogui_FormHelper_mBindings = R"doc(The variables associated with all widgets this FormHelper is managing.)doc";
+
 static const char *__doc_nanogui_FormHelper_mFixedSize = R"doc(The fixed size for newly added widgets.)doc";
 
 static const char *__doc_nanogui_FormHelper_mGroupFontName = R"doc(The group header font name.)doc";
@@ -1081,7 +1233,7 @@ static const char *__doc_nanogui_FormHelper_mPostGroupSpacing = R"doc(The spacin
 
 static const char *__doc_nanogui_FormHelper_mPreGroupSpacing = R"doc(The spacing used **before** new groups.)doc";
 
-static const char *__doc_nanogui_FormHelper_mRefreshCallbacks = R"doc(The callbacks associated with all widgets this FormHelper is managing.)doc";
+static const char *__doc_nanogui_FormHelper_mRefreshInterval = R"doc(The refresh interval for newly added variables.)doc";
 
 static const char *__doc_nanogui_FormHelper_mScreen = R"doc(A reference to the nanogui::Screen this FormHelper is assisting.)doc";
 
@@ -1091,6 +1243,22 @@ static const char *__doc_nanogui_FormHelper_mWidgetFontSize = R"doc(The font siz
 
 static const char *__doc_nanogui_FormHelper_mWindow = R"doc(A reference to the nanogui::Window this FormHelper is controlling.)doc";
 
+static const char *__doc_nanogui_FormHelper_notify =
+R"doc(Re-synchronize the widget of a single variable right away.
+
+Intended for push-style updates: call this after modifying a variable
+whose widget has a long or negative refresh interval.
+
+Returns:
+    Whether the widget was updated.)doc";
+
+static const char *__doc_nanogui_FormHelper_notifyStruct =
+R"doc(Re-synchronize the widgets of a struct added by addStruct() right
+away.
+
+Returns:
+    Whether any widget was updated.)doc";
+
 static const char *__doc_nanogui_FormHelper_operator_delete = R"doc()doc";
 
 static const char *__doc_nanogui_FormHelper_operator_delete_2 = R"doc()doc";
@@ -1115,7 +1283,22 @@ static const char *__doc_nanogui_FormHelper_operator_new_4 = R"doc()doc";
 
 static const char *__doc_nanogui_FormHelper_operator_new_5 = R"doc()doc";
 
-static const char *__doc_nanogui_FormHelper_refresh = R"doc(Cause all widgets to re-synchronize with the underlying variable state)doc";
+static const char *__doc_nanogui_FormHelper_refresh =
+R"doc(Cause all widgets to re-synchronize with the underlying variable
+state.
+
+Each getter is compared against the value that was last shown by its
+widget, and only widgets whose value changed are updated. Variables
+with a refresh interval (see setRefreshInterval()) are only polled
+once the interval has elapsed since their last update.
+
+Parameter ``force``:
+    Poll all variables, regardless of their refresh interval.
+
+Returns:
+    The number of widgets that were updated.)doc";
+
+static const char *__doc_nanogui_FormHelper_refreshInterval = R"doc(The minimum number of seconds between two polls of newly added variables.)doc";
 
 static const char *__doc_nanogui_FormHelper_setFixedSize = R"doc(Specify a fixed size for newly added widgets.)doc";
 
@@ -1127,6 +1310,17 @@ static const char *__doc_nanogui_FormHelper_setLabelFontName = R"doc(Sets the fo
 
 static const char *__doc_nanogui_FormHelper_setLabelFontSize = R"doc(Sets the size of the font being used for labels.)doc";
 
+static const char *__doc_nanogui_FormHelper_setRefreshInterval =
+R"doc(Set the minimum number of seconds between two polls of newly added
+variables by refresh().
+
+Zero (the default) polls on every call; a negative interval only
+updates the widget through notify() or a forced refresh.)doc";
+
+static const char *__doc_nanogui_FormHelper_setRefreshInterval_2 = R"doc(Set the refresh interval of the variable shown by the given widget.)doc";
+
+static const char *__doc_nanogui_FormHelper_setStructRefreshInterval = R"doc(Set the refresh interval of a struct added by addStruct().)doc";
+
 static const char *__doc_nanogui_FormHelper_setWidgetFontSize =
 R"doc(Sets the size of the font being used for non-group / non-label
 widgets.)doc";
@@ -1153,6 +1347,23 @@ custom drawing code.  See :ref:`nanogui_example_4`.
 
 ```)doc";
 
+static const char *__doc_nanogui_GLCanvas_FrameStats =
+R"doc(Frame pacing statistics of the render or user interface thread.
+
+Times are exponential moving averages in seconds.)doc";
+
+static const char *__doc_nanogui_GLCanvas_FrameStats_dropped = R"doc(Number of rendered frames that were replaced before they could be displayed)doc";
+
+static const char *__doc_nanogui_GLCanvas_FrameStats_fps = R"doc(Average number of frames per second)doc";
+
+static const char *__doc_nanogui_GLCanvas_FrameStats_frameTime = R"doc(Average time between two consecutive frames)doc";
+
+static const char *__doc_nanogui_GLCanvas_FrameStats_frames = R"doc(Number of frames produced (render thread) or composited (UI thread))doc";
+
+static const char *__doc_nanogui_GLCanvas_FrameStats_workTime =
+R"doc(Average time spent in drawGL() (render thread) or waiting for a new
+frame (UI thread))doc";
+
 static const char *__doc_nanogui_GLCanvas_GLCanvas =
 R"doc(Creates a GLCanvas attached to the specified parent.
 
@@ -1161,6 +1372,10 @@ Parameter ``parent``:
 
 static const char *__doc_nanogui_GLCanvas_backgroundColor = R"doc(Returns the background color.)doc";
 
+static const char *__doc_nanogui_GLCanvas_cacheScene = R"doc(Return whether the rendered scene is cached between frames.)doc";
+
+static const char *__doc_nanogui_GLCanvas_compositeStats = R"doc(Return frame pacing statistics of the user interface thread.)doc";
+
 static const char *__doc_nanogui_GLCanvas_draw = R"doc(Draw the canvas.)doc";
 
 static const char *__doc_nanogui_GLCanvas_drawBorder = R"doc(Return whether the widget border gets drawn or not.)doc";
@@ -1169,12 +1384,18 @@ static const char *__doc_nanogui_GLCanvas_drawGL = R"doc(Draw the GL scene. Over
 
 static const char *__doc_nanogui_GLCanvas_drawWidgetBorder = R"doc(Internal helper function for drawing the widget border)doc";
 
+static const char *__doc_nanogui_GLCanvas_freeGL =
+R"doc(Release OpenGL objects created by drawGL() when the render thread
+shuts down (see setThreaded()).)doc";
+
 static const char *__doc_nanogui_GLCanvas_load = R"doc(Set the state of this GLCanvas from the specified Serializer.)doc";
 
 static const char *__doc_nanogui_GLCanvas_mBackgroundColor = R"doc(The background color (what is used with ``glClearColor``).)doc";
 
 static const char *__doc_nanogui_GLCanvas_mDrawBorder = R"doc(Whether to draw the widget border or not.)doc";
 
+static const char *__doc_nanogui_GLCanvas_markSceneDirty = R"doc(Request that drawGL() is invoked again during the next frame.)doc";
+
 static const char *__doc_nanogui_GLCanvas_operator_delete = R"doc()doc";
 
 static const char *__doc_nanogui_GLCanvas_operator_delete_2 = R"doc()doc";
@@ -1199,12 +1420,50 @@ static const char *__doc_nanogui_GLCanvas_operator_new_4 = R"doc()doc";
 
 static const char *__doc_nanogui_GLCanvas_operator_new_5 = R"doc()doc";
 
+static const char *__doc_nanogui_GLCanvas_renderStats = R"doc(Return frame pacing statistics of the render thread.)doc";
+
 static const char *__doc_nanogui_GLCanvas_save = R"doc(Save the state of this GLCanvas to the specified Serializer.)doc";
 
+static const char *__doc_nanogui_GLCanvas_sceneDirty = R"doc(Return whether the scene will be rendered again during the next frame.)doc";
+
 static const char *__doc_nanogui_GLCanvas_setBackgroundColor = R"doc(Sets the background color.)doc";
 
+static const char *__doc_nanogui_GLCanvas_setCacheScene =
+R"doc(Set whether the rendered scene is cached between frames.
+
+When enabled, drawGL() only runs after markSceneDirty() was called or
+when the size or pixel ratio of the canvas changed. All other frames
+composite the previous result, so redrawing unrelated widgets does not
+pay for re-rendering a static scene.)doc";
+
 static const char *__doc_nanogui_GLCanvas_setDrawBorder = R"doc(Set whether to draw the widget border or not.)doc";
 
+static const char *__doc_nanogui_GLCanvas_setThreaded =
+R"doc(Render the scene on a dedicated thread.
+
+The thread owns an OpenGL context that shares objects with the screen's
+context and renders into a ring of ``bufferCount`` (2 or 3) offscreen
+targets. The user interface composites whichever frame was completed
+most recently and never waits for drawGL(), so the remaining widgets
+stay responsive while the scene renders at its own pace. With two
+buffers, the render thread waits until each frame has been displayed;
+with three, it keeps going and older frames are dropped.
+
+In this mode drawGL() is invoked on the render thread. Any state it
+shares with the user interface must be synchronized by the caller.
+Vertex array and framebuffer objects are not shared between contexts,
+so shaders must be created from within drawGL() (e.g. on the first
+call) and released in freeGL().
+
+Must be called on the thread that owns the screen's OpenGL context.
+Subclasses must call ``setThreaded(false)`` in their destructor (or
+earlier): the render thread invokes their drawGL() and freeGL()
+overrides, so it has to stop while they still exist. freeGL() is then
+invoked on the calling thread with the render thread's context made
+current.)doc";
+
+static const char *__doc_nanogui_GLCanvas_threaded = R"doc(Return whether the scene is rendered on a dedicated thread.)doc";
+
 static const char *__doc_nanogui_GLFramebuffer = R"doc(Helper class for creating framebuffer objects.)doc";
 
 static const char *__doc_nanogui_GLFramebuffer_GLFramebuffer = R"doc(Default constructor: unusable until you call the ``init()`` method)doc";
@@ -1409,6 +1668,133 @@ static const char *__doc_nanogui_GLShader_uploadAttrib_2 = R"doc()doc";
 
 static const char *__doc_nanogui_GLShader_uploadIndices = R"doc(Upload an index buffer)doc";
 
+static const char *__doc_nanogui_GLTexture =
+R"doc(Helper class for creating 2D textures with immutable storage.
+
+Storage for all mipmap levels is allocated once in ``init()``. Updates
+of arbitrary regions are staged through a pixel unpack buffer that is
+orphaned on every upload, so the caller never waits for the GPU to
+finish using the previous contents.)doc";
+
+static const char *__doc_nanogui_GLTexture_GLTexture = R"doc(Default constructor: unusable until you call the ``init()`` method)doc";
+
+static const char *__doc_nanogui_GLTexture_bind = R"doc(Bind the texture to the given texture unit)doc";
+
+static const char *__doc_nanogui_GLTexture_channels = R"doc(Return the number of channels per texel)doc";
+
+static const char *__doc_nanogui_GLTexture_download =
+R"doc(Download the given mipmap level (stalls until the GPU has finished
+rendering))doc";
+
+static const char *__doc_nanogui_GLTexture_free = R"doc(Release all associated resources)doc";
+
+static const char *__doc_nanogui_GLTexture_generateMipmaps = R"doc(Regenerate mipmap levels 1 and above from the base level)doc";
+
+static const char *__doc_nanogui_GLTexture_init =
+R"doc(Allocate storage for a texture with the given OpenGL internal format.
+
+Parameter ``levels``:
+    Number of mipmap levels. The value ``0`` allocates the full chain.)doc";
+
+static const char *__doc_nanogui_GLTexture_init_2 =
+R"doc(Allocate storage for a texture whose texels consist of ``channels``
+(1-4) components of type ``Scalar``.
+
+Integer components are sampled as normalized floating point values
+unless ``normalized`` is set to ``false``. 32 bit integer textures are
+always unnormalized.)doc";
+
+static const char *__doc_nanogui_GLTexture_internalFormat = R"doc(Return the OpenGL internal format)doc";
+
+static const char *__doc_nanogui_GLTexture_internalFormat_2 =
+R"doc(Return the internal format for ``channels`` components of the given
+OpenGL type)doc";
+
+static const char *__doc_nanogui_GLTexture_levels = R"doc(Return the number of mipmap levels)doc";
+
+static const char *__doc_nanogui_GLTexture_mChannels = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mComponentSize = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mFormat = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mID = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mInternalFormat = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mLevels = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mMapLevel = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mMapOffset = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mMapSize = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mMapped = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mPBO = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mPBOSize = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mSize = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_mType = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_map =
+R"doc(Map staging memory for a region of the given mipmap level.
+
+The caller writes ``size.x() * size.y() * pixelSize()`` tightly packed
+bytes into the returned pointer and then calls unmap() to start the
+transfer. This avoids the extra copy made by update().)doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete_2 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete_3 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete_4 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete_5 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete_6 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_delete_7 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_new = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_new_2 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_new_3 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_new_4 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_operator_new_5 = R"doc()doc";
+
+static const char *__doc_nanogui_GLTexture_pixelSize = R"doc(Return the size of a single texel of the client-side data in bytes)doc";
+
+static const char *__doc_nanogui_GLTexture_ready = R"doc(Return whether or not the texture has been initialized)doc";
+
+static const char *__doc_nanogui_GLTexture_release = R"doc(Release/unbind the texture from the given texture unit)doc";
+
+static const char *__doc_nanogui_GLTexture_setFilter = R"doc(Set the minification and magnification filters)doc";
+
+static const char *__doc_nanogui_GLTexture_setWrap = R"doc(Set the wrap mode for both texture coordinates)doc";
+
+static const char *__doc_nanogui_GLTexture_size = R"doc(Return the size of the base level)doc";
+
+static const char *__doc_nanogui_GLTexture_size_2 = R"doc(Return the size of the given mipmap level)doc";
+
+static const char *__doc_nanogui_GLTexture_texture = R"doc(Return the OpenGL name of the texture)doc";
+
+static const char *__doc_nanogui_GLTexture_type = R"doc(Return the OpenGL type of the components of the client-side data)doc";
+
+static const char *__doc_nanogui_GLTexture_unmap = R"doc(Transfer the region mapped by map() into the texture)doc";
+
+static const char *__doc_nanogui_GLTexture_update = R"doc(Upload the entire base level)doc";
+
+static const char *__doc_nanogui_GLTexture_update_2 = R"doc(Upload a region of the given mipmap level (``data`` is tightly packed))doc";
+
 static const char *__doc_nanogui_GLUniformBuffer = R"doc(Helper class for creating OpenGL Uniform Buffer objects.)doc";
 
 static const char *__doc_nanogui_GLUniformBuffer_GLUniformBuffer = R"doc(Default constructor: unusable until you call the ``init()`` method)doc";
@@ -1501,11 +1887,21 @@ static const char *__doc_nanogui_Graph_setHeader = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_setTextColor = R"doc()doc";
 
-static const char *__doc_nanogui_Graph_setValues = R"doc()doc";
+static const char *__doc_nanogui_Graph_setValues =
+R"doc(Set the values shown by the graph. The storage is reused if the number
+of values does not change. Changing the number of values raises a
+``ValueError`` while arrays returned by values() are still alive.)doc";
 
 static const char *__doc_nanogui_Graph_textColor = R"doc()doc";
 
-static const char *__doc_nanogui_Graph_values = R"doc()doc";
+static const char *__doc_nanogui_Graph_values =
+R"doc(Return the values shown by the graph.
+
+In Python, this is a NumPy view that aliases the values of the graph,
+so writing to it changes the graph, and it keeps the graph alive. While
+such a view exists, setValues() only accepts the same number of values
+and raises a ``ValueError`` otherwise; delete the views (or copy them)
+before changing the number of values.)doc";
 
 static const char *__doc_nanogui_Graph_values_2 = R"doc()doc";
 
@@ -2057,6 +2453,78 @@ Returns:
     The preferred size, accounting for things such as spacing, padding
     for icons, etc.)doc";
 
+static const char *__doc_nanogui_LazyPage =
+R"doc(A page of a StackedWidget whose contents are created on demand.
+
+The factory is invoked to populate the page right before it is drawn
+for the first time, so pages that are never shown cost no more than an
+empty widget. A StackedWidget with a release timeout removes the
+contents of pages that have not been shown for a while, which frees
+their textures and retained caches; they are recreated by the factory
+when the page is shown again. Applications that must preserve the state
+of the released widgets can store it from the release callback, e.g.
+using Widget::save().)doc";
+
+static const char *__doc_nanogui_LazyPage_LazyPage = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_draw = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_factory = R"doc(Return the callback that creates the contents of the page)doc";
+
+static const char *__doc_nanogui_LazyPage_lastDrawn = R"doc(Return the time (as reported by ``glfwGetTime()``) at which the page
+was last drawn)doc";
+
+static const char *__doc_nanogui_LazyPage_mFactory = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_mLastDrawn = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_mNeedsLayout = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_mPopulated = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_mReleaseCallback = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete_2 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete_3 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete_4 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete_5 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete_6 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_delete_7 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_new = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_new_2 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_new_3 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_new_4 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_operator_new_5 = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_performLayout = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_populate = R"doc(Create the contents of the page unless they already exist)doc";
+
+static const char *__doc_nanogui_LazyPage_populated = R"doc(Return whether the contents of the page currently exist)doc";
+
+static const char *__doc_nanogui_LazyPage_preferredSize = R"doc()doc";
+
+static const char *__doc_nanogui_LazyPage_release = R"doc(Remove the contents of the page (they are recreated when it is shown
+again))doc";
+
+static const char *__doc_nanogui_LazyPage_releaseCallback = R"doc(Return the callback that is invoked before the contents are released)doc";
+
+static const char *__doc_nanogui_LazyPage_setFactory = R"doc(Set the callback that creates the contents of the page)doc";
+
+static const char *__doc_nanogui_LazyPage_setReleaseCallback = R"doc(Set the callback that is invoked before the contents are released)doc";
+
 static const char *__doc_nanogui_MessageDialog = R"doc(Simple "OK" or "Yes/No"-style modal dialogs.)doc";
 
 static const char *__doc_nanogui_MessageDialog_MessageDialog = R"doc()doc";
@@ -2216,6 +2684,8 @@ popup is relative to it)doc";
 
 static const char *__doc_nanogui_Popup_draw = R"doc(Draw the popup window)doc";
 
+static const char *__doc_nanogui_Popup_layerMargin = R"doc(The layer also has to cover the anchor arrow)doc";
+
 static const char *__doc_nanogui_Popup_load = R"doc()doc";
 
 static const char *__doc_nanogui_Popup_mAnchorHeight = R"doc()doc";
@@ -2414,6 +2884,10 @@ static const char *__doc_nanogui_Screen_keyboardCharacterEvent = R"doc(Text inpu
 
 static const char *__doc_nanogui_Screen_keyboardEvent = R"doc(Default keyboard event handler)doc";
 
+static const char *__doc_nanogui_Screen_lastInteraction =
+R"doc(Return the time (see ``glfwGetTime()``) of the most recent user
+interaction)doc";
+
 static const char *__doc_nanogui_Screen_mBackground = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_mCaption = R"doc()doc";
@@ -2490,6 +2964,8 @@ static const char *__doc_nanogui_Screen_pixelRatio =
 R"doc(Return the ratio between pixel and device coordinates (e.g. >= 2 on
 Mac Retina displays))doc";
 
+static const char *__doc_nanogui_Screen_primitiveBatching = R"doc(Return whether widget primitives are drawn by an instanced renderer)doc";
+
 static const char *__doc_nanogui_Screen_resizeCallback = R"doc(Set the resize callback)doc";
 
 static const char *__doc_nanogui_Screen_resizeCallbackEvent = R"doc()doc";
@@ -2502,6 +2978,10 @@ static const char *__doc_nanogui_Screen_setBackground = R"doc(Set the screen's b
 
 static const char *__doc_nanogui_Screen_setCaption = R"doc(Set the window title bar caption)doc";
 
+static const char *__doc_nanogui_Screen_setPrimitiveBatching =
+R"doc(Draw rounded rectangles, circles and gradients of widgets with a single
+instanced draw call per top-level window. Disabled by default.)doc";
+
 static const char *__doc_nanogui_Screen_setResizeCallback = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_setShutdownGLFWOnDestruct = R"doc()doc";
@@ -2596,6 +3076,12 @@ static const char *__doc_nanogui_StackedWidget_StackedWidget = R"doc()doc";
 
 static const char *__doc_nanogui_StackedWidget_addChild = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_draw = R"doc()doc";
+
+static const char *__doc_nanogui_StackedWidget_mLastReleaseCheck = R"doc()doc";
+
+static const char *__doc_nanogui_StackedWidget_mReleaseTimeout = R"doc()doc";
+
 static const char *__doc_nanogui_StackedWidget_mSelectedIndex = R"doc()doc";
 
 static const char *__doc_nanogui_StackedWidget_operator_delete = R"doc()doc";
@@ -2626,11 +3112,26 @@ static const char *__doc_nanogui_StackedWidget_performLayout = R"doc()doc";
 
 static const char *__doc_nanogui_StackedWidget_preferredSize = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_releaseTimeout = R"doc(Return the number of seconds after which hidden LazyPage contents are
+released)doc";
+
 static const char *__doc_nanogui_StackedWidget_selectedIndex = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_setReleaseTimeout =
+R"doc(Release the contents of LazyPage children that have not been shown for
+the given number of seconds.
+
+A negative value (the default) keeps the contents of all pages alive.)doc";
+
 static const char *__doc_nanogui_StackedWidget_setSelectedIndex = R"doc()doc";
 
-static const char *__doc_nanogui_TabHeader = R"doc(A Tab navigable widget.)doc";
+static const char *__doc_nanogui_TabHeader =
+R"doc(A Tab navigable widget.
+
+The measured widths of the tab buttons are cached along with their
+prefix sums, so that visibility queries and hit testing take
+logarithmic time in the number of tabs. Labels are only measured again
+when the font, the font size or the tab metrics of the theme change.)doc";
 
 static const char *__doc_nanogui_TabHeader_ClickLocation = R"doc(The location in which the Widget will be facing.)doc";
 
@@ -2642,12 +3143,6 @@ static const char *__doc_nanogui_TabHeader_ClickLocation_TabButtons = R"doc()doc
 
 static const char *__doc_nanogui_TabHeader_TabButton = R"doc(Implementation class of the actual tab buttons.)doc";
 
-static const char *__doc_nanogui_TabHeader_TabButton_StringView = R"doc(Helper struct to represent the TabButton.)doc";
-
-static const char *__doc_nanogui_TabHeader_TabButton_StringView_first = R"doc()doc";
-
-static const char *__doc_nanogui_TabHeader_TabButton_StringView_last = R"doc()doc";
-
 static const char *__doc_nanogui_TabHeader_TabButton_TabButton = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_TabButton_calculateVisibleString = R"doc()doc";
@@ -2658,18 +3153,28 @@ static const char *__doc_nanogui_TabHeader_TabButton_drawAtPosition = R"doc()doc
 
 static const char *__doc_nanogui_TabHeader_TabButton_drawInactiveBorderAt = R"doc()doc";
 
+static const char *__doc_nanogui_TabHeader_TabButton_invalidate = R"doc(Discard the cached result of preferredSize())doc";
+
 static const char *__doc_nanogui_TabHeader_TabButton_label = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_TabButton_mHeader = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_TabButton_mLabel = R"doc()doc";
 
+static const char *__doc_nanogui_TabHeader_TabButton_mMeasured = R"doc()doc";
+
+static const char *__doc_nanogui_TabHeader_TabButton_mPreferredSize = R"doc()doc";
+
 static const char *__doc_nanogui_TabHeader_TabButton_mSize = R"doc()doc";
 
-static const char *__doc_nanogui_TabHeader_TabButton_mVisibleText = R"doc()doc";
+static const char *__doc_nanogui_TabHeader_TabButton_mVisibleBegin = R"doc()doc";
+
+static const char *__doc_nanogui_TabHeader_TabButton_mVisibleLength = R"doc(Number of displayed bytes in front of the dots (-1 if the label is not truncated))doc";
 
 static const char *__doc_nanogui_TabHeader_TabButton_mVisibleWidth = R"doc()doc";
 
+static const char *__doc_nanogui_TabHeader_TabButton_measured = R"doc(Whether the cached result of preferredSize() is up to date)doc";
+
 static const char *__doc_nanogui_TabHeader_TabButton_preferredSize = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_TabButton_setLabel = R"doc()doc";
@@ -2698,6 +3203,10 @@ static const char *__doc_nanogui_TabHeader_addTab_2 = R"doc(Inserts a tab into t
 
 static const char *__doc_nanogui_TabHeader_calculateVisibleEnd = R"doc(Given the beginning of the visible tabs, calculate the end.)doc";
 
+static const char *__doc_nanogui_TabHeader_checkTabMetrics = R"doc(Discard the measured tab sizes if the font or the tab metrics changed.)doc";
+
+static const char *__doc_nanogui_TabHeader_clampedTabSize = R"doc(Preferred size of a tab button, clamped to the limits of the theme.)doc";
+
 static const char *__doc_nanogui_TabHeader_callback = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_draw = R"doc()doc";
@@ -2722,10 +3231,22 @@ static const char *__doc_nanogui_TabHeader_mCallback = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_mFont = R"doc()doc";
 
+static const char *__doc_nanogui_TabHeader_mMeasuredFont = R"doc(Font and metrics the tab buttons were measured with)doc";
+
+static const char *__doc_nanogui_TabHeader_mMeasuredMetrics = R"doc()doc";
+
 static const char *__doc_nanogui_TabHeader_mOverflowing = R"doc()doc";
 
+static const char *__doc_nanogui_TabHeader_mPreferredSize = R"doc()doc";
+
+static const char *__doc_nanogui_TabHeader_mPreferredSizeDirty = R"doc()doc";
+
 static const char *__doc_nanogui_TabHeader_mTabButtons = R"doc()doc";
 
+static const char *__doc_nanogui_TabHeader_mTabOffsets = R"doc(Total width of the tab buttons in front of each tab (``tabCount() + 1`` entries))doc";
+
+static const char *__doc_nanogui_TabHeader_mTabsDirty = R"doc(Whether tab buttons must be measured or resized by performLayout())doc";
+
 static const char *__doc_nanogui_TabHeader_mVisibleEnd = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_mVisibleStart = R"doc()doc";
@@ -2793,6 +3314,8 @@ static const char *__doc_nanogui_TabHeader_tabIterator_2 = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_tabLabelAt = R"doc(Retrieves the label of the tab at a specific index.)doc";
 
+static const char *__doc_nanogui_TabHeader_updateTabOffsets = R"doc(Rebuild the prefix sums of the tab button widths.)doc";
+
 static const char *__doc_nanogui_TabHeader_visibleBegin = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader_visibleBegin_2 = R"doc()doc";
@@ -2824,6 +3347,12 @@ associates it with the provided widget.)doc";
 
 static const char *__doc_nanogui_TabWidget_callback = R"doc()doc";
 
+static const char *__doc_nanogui_TabWidget_createLazyTab =
+R"doc(Creates a new tab whose contents are created by the provided callback
+right before the tab is shown for the first time (see LazyPage).)doc";
+
+static const char *__doc_nanogui_TabWidget_createLazyTab_2 = R"doc()doc";
+
 static const char *__doc_nanogui_TabWidget_createTab =
 R"doc(Creates a new tab with the specified name and returns a pointer to the
 layer.)doc";
@@ -2874,6 +3403,8 @@ static const char *__doc_nanogui_TabWidget_performLayout = R"doc()doc";
 
 static const char *__doc_nanogui_TabWidget_preferredSize = R"doc()doc";
 
+static const char *__doc_nanogui_TabWidget_releaseTimeout = R"doc()doc";
+
 static const char *__doc_nanogui_TabWidget_removeTab =
 R"doc(Removes the tab with the specified label and returns the index of the
 label. Returns whether the removal was successful.)doc";
@@ -2886,6 +3417,10 @@ static const char *__doc_nanogui_TabWidget_setCallback =
 R"doc(Sets the callable objects which is invoked when a tab is changed. The
 argument provided to the callback is the index of the new active tab.)doc";
 
+static const char *__doc_nanogui_TabWidget_setReleaseTimeout =
+R"doc(Release the contents of lazy tabs that have not been shown for the
+given number of seconds. A negative value (the default) disables this.)doc";
+
 static const char *__doc_nanogui_TabWidget_tab = R"doc()doc";
 
 static const char *__doc_nanogui_TabWidget_tabCount = R"doc()doc";
@@ -2902,9 +3437,196 @@ if there is no such tab.)doc";
 
 static const char *__doc_nanogui_TabWidget_tab_2 = R"doc()doc";
 
+static const char *__doc_nanogui_TextArea =
+R"doc(Multi-line text editor for large documents.
+
+The text is kept in a TextDocument. Only the visible lines are
+extracted, measured and drawn in each frame. The glyph positions of a
+line are cached until the line is edited, the font changes, or the line
+scrolls far out of view. Lines are not wrapped; the editor scrolls
+horizontally instead.
+
+The editor supports mouse and keyboard selection, the clipboard, and
+undo (``Ctrl+Z``) and redo (``Ctrl+Y`` or ``Ctrl+Shift+Z``) of groups of
+edits. Read-only editors (see setEditable()) still allow selecting and
+copying text.)doc";
+
+static const char *__doc_nanogui_TextArea_LineLayout = R"doc(Cached horizontal caret positions of a line.)doc";
+
+static const char *__doc_nanogui_TextArea_LineLayout_x = R"doc(Caret position in front of each byte, followed by the line width)doc";
+
+static const char *__doc_nanogui_TextArea_TextArea = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_callback = R"doc(The callback that is invoked whenever the user modifies the contents)doc";
+
+static const char *__doc_nanogui_TextArea_caretPosition = R"doc(Return the offset of the caret)doc";
+
+static const char *__doc_nanogui_TextArea_caretX = R"doc(Return the horizontal caret position of an offset within its line)doc";
+
+static const char *__doc_nanogui_TextArea_clampScroll = R"doc(Limit the scroll offsets to the extent of the document)doc";
+
+static const char *__doc_nanogui_TextArea_copySelection = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_deleteSelection = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_document = R"doc(Return the underlying document)doc";
+
+static const char *__doc_nanogui_TextArea_draw = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_editable = R"doc(Return whether the contents can be modified by the user)doc";
+
+static const char *__doc_nanogui_TextArea_focusEvent = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_font = R"doc(Return the font used to draw the text)doc";
+
+static const char *__doc_nanogui_TextArea_hitTest = R"doc(Return the offset closest to a position (in parent coordinates))doc";
+
+static const char *__doc_nanogui_TextArea_insert = R"doc(Replace the selection with the given text (as if it was typed))doc";
+
+static const char *__doc_nanogui_TextArea_invalidateLines = R"doc(Update the line layout cache after an edit of the document)doc";
+
+static const char *__doc_nanogui_TextArea_keyboardCharacterEvent = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_keyboardEvent = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_layoutLine = R"doc(Return the (cached) caret positions of a line)doc";
+
+static const char *__doc_nanogui_TextArea_lineHeight = R"doc(Return the height of a line in pixels)doc";
+
+static const char *__doc_nanogui_TextArea_load = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mAnchor = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mCallback = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mCaret = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mContentWidth = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mDocument = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mDragScrollBar = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mEditable = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mFont = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mLastClick = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mLayoutFont = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mLayoutFontSize = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mLayouts = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mPreferredX = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mScroll = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mScrollToCaret = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mTextColor = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mouseButtonEvent = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_mouseDragEvent = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_moveCaret = R"doc(Move the caret, extending the selection if ``extend`` is set)doc";
+
+static const char *__doc_nanogui_TextArea_nextChar = R"doc(Return the offset of the next character (UTF-8 aware))doc";
+
+static const char *__doc_nanogui_TextArea_offsetAtX = R"doc(Return the offset of a line closest to a horizontal caret position)doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete_2 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete_3 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete_4 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete_5 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete_6 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_delete_7 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_new = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_new_2 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_new_3 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_new_4 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_operator_new_5 = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_pasteFromClipboard = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_preferredSize = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_prevChar = R"doc(Return the offset of the previous character (UTF-8 aware))doc";
+
+static const char *__doc_nanogui_TextArea_redo = R"doc(Reapply the most recently undone group of edits)doc";
+
+static const char *__doc_nanogui_TextArea_replaceRange =
+R"doc(Replace a range of the document and place the caret behind the new
+text)doc";
+
+static const char *__doc_nanogui_TextArea_save = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_scrollBarVisible = R"doc(Return whether the vertical scroll bar is shown)doc";
+
+static const char *__doc_nanogui_TextArea_scrollEvent = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_scrollToLine = R"doc(Scroll so that the given line is visible)doc";
+
+static const char *__doc_nanogui_TextArea_select = R"doc(Select the given range (the caret is placed at ``end``))doc";
+
+static const char *__doc_nanogui_TextArea_selectedText = R"doc(Return the selected text)doc";
+
+static const char *__doc_nanogui_TextArea_setCallback =
+R"doc(Set the callback that is invoked whenever the user modifies the
+contents)doc";
+
+static const char *__doc_nanogui_TextArea_setCaretPosition = R"doc(Move the caret to the given offset and clear the selection)doc";
+
+static const char *__doc_nanogui_TextArea_setEditable = R"doc(Set whether the contents can be modified by the user)doc";
+
+static const char *__doc_nanogui_TextArea_setFont =
+R"doc(Set the font used to draw the text (e.g. a monospaced font registered
+with NanoVG))doc";
+
+static const char *__doc_nanogui_TextArea_setTextColor =
+R"doc(Set the text color (a transparent color selects the theme's text
+color))doc";
+
+static const char *__doc_nanogui_TextArea_setTheme = R"doc(Set the Theme used to draw this widget)doc";
+
+static const char *__doc_nanogui_TextArea_setValue = R"doc(Replace the contents of the editor (clears the undo history))doc";
+
+static const char *__doc_nanogui_TextArea_textColor =
+R"doc(Return the text color (a transparent color selects the theme's text
+color))doc";
+
+static const char *__doc_nanogui_TextArea_trimLayoutCache = R"doc(Drop cached line layouts that are far away from the visible lines)doc";
+
+static const char *__doc_nanogui_TextArea_undo = R"doc(Revert the most recent group of edits)doc";
+
+static const char *__doc_nanogui_TextArea_value = R"doc(Return the contents of the editor as a single string)doc";
+
+static const char *__doc_nanogui_TextArea_viewHeight = R"doc(Return the height of the text viewport)doc";
+
+static const char *__doc_nanogui_TextArea_viewWidth = R"doc(Return the width of the text viewport)doc";
+
 static const char *__doc_nanogui_TextBox =
 R"doc(Fancy text box with builtin regular expression-based validation.
 
+The format is compiled once when it is set, rather than on every edit.
+The formats used by IntBox and FloatBox are recognized and checked by
+hand-written scanners, and arbitrary validation logic can be supplied
+through setValidator().
+
 Remark:
     This class overrides nanogui::Widget::mIconExtraScale to be
     ``0.8f``, which affects all subclasses of this Widget. Subclasses
@@ -2927,6 +3649,9 @@ static const char *__doc_nanogui_TextBox_SpinArea_None = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_SpinArea_Top = R"doc()doc";
 
+static const char *__doc_nanogui_TextBox_Validator = R"doc(Function that decides whether the (nonempty) contents of the text box
+are valid)doc";
+
 static const char *__doc_nanogui_TextBox_TextBox = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_alignment = R"doc()doc";
@@ -2935,6 +3660,8 @@ static const char *__doc_nanogui_TextBox_callback = R"doc(The callback to execut
 
 static const char *__doc_nanogui_TextBox_checkFormat = R"doc()doc";
 
+static const char *__doc_nanogui_TextBox_compileFormat = R"doc(Create a validator for the given regular expression)doc";
+
 static const char *__doc_nanogui_TextBox_copySelection = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_cursorIndex2Position = R"doc()doc";
@@ -2971,6 +3698,16 @@ static const char *__doc_nanogui_TextBox_mEditable = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_mFormat = R"doc()doc";
 
+static const char *__doc_nanogui_TextBox_mGlyphAlignment = R"doc()doc";
+
+static const char *__doc_nanogui_TextBox_mGlyphFontSize = R"doc()doc";
+
+static const char *__doc_nanogui_TextBox_mGlyphLineHeight = R"doc()doc";
+
+static const char *__doc_nanogui_TextBox_mGlyphText = R"doc()doc";
+
+static const char *__doc_nanogui_TextBox_mGlyphX = R"doc()doc";
+
 static const char *__doc_nanogui_TextBox_mLastClick = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_mMouseDownModifier = R"doc()doc";
@@ -2993,6 +3730,8 @@ static const char *__doc_nanogui_TextBox_mUnitsImage = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_mValidFormat = R"doc()doc";
 
+static const char *__doc_nanogui_TextBox_mValidator = R"doc()doc";
+
 static const char *__doc_nanogui_TextBox_mValue = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_mValueTemp = R"doc()doc";
@@ -3045,7 +3784,8 @@ static const char *__doc_nanogui_TextBox_setDefaultValue = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_setEditable = R"doc()doc";
 
-static const char *__doc_nanogui_TextBox_setFormat = R"doc(Specify a regular expression specifying valid formats)doc";
+static const char *__doc_nanogui_TextBox_setFormat = R"doc(Specify a regular expression specifying valid formats (compiles a new
+validator()))doc";
 
 static const char *__doc_nanogui_TextBox_setSpinnable = R"doc()doc";
 
@@ -3055,6 +3795,8 @@ static const char *__doc_nanogui_TextBox_setUnits = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_setUnitsImage = R"doc()doc";
 
+static const char *__doc_nanogui_TextBox_setValidator = R"doc(Specify a custom validation function (clears the format()))doc";
+
 static const char *__doc_nanogui_TextBox_setValue = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_spinArea = R"doc()doc";
@@ -3067,8 +3809,148 @@ static const char *__doc_nanogui_TextBox_unitsImage = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_updateCursor = R"doc()doc";
 
+static const char *__doc_nanogui_TextBox_updateGlyphPositions = R"doc(Measure the caret positions of the edited text, unless they are cached
+already)doc";
+
+static const char *__doc_nanogui_TextBox_validate = R"doc(Check the given input against the current validator)doc";
+
+static const char *__doc_nanogui_TextBox_validator = R"doc(Return the function that validates the contents (empty if any input is
+accepted))doc";
+
 static const char *__doc_nanogui_TextBox_value = R"doc()doc";
 
+static const char *__doc_nanogui_TextDocument =
+R"doc(Editable text stored as a piece table, with a line index and an undo
+history of deltas.
+
+The original text is never modified: edits append the inserted text to a
+separate buffer and split the list of pieces that refer to the two
+buffers. Together with the sorted offsets of all line starts, this makes
+edits of multi-megabyte documents independent of the size of the text
+(apart from shifting the line and piece offsets behind the edit).
+
+Lines are separated by ``'\n'``. All positions are byte offsets into the
+UTF-8 encoded text.)doc";
+
+static const char *__doc_nanogui_TextDocument_ChangeCallback =
+R"doc(Callback invoked after every modification.
+
+The arguments are the first affected line and the number of line breaks
+that were removed and inserted; lines behind the edit are shifted by the
+difference.)doc";
+
+static const char *__doc_nanogui_TextDocument_Delta =
+R"doc(An entry of the undo history: ``removed`` was replaced by ``inserted``
+at ``offset``.)doc";
+
+static const char *__doc_nanogui_TextDocument_Delta_inserted = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_Delta_offset = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_Delta_removed = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_Piece = R"doc(A contiguous range of the original or the appended buffer.)doc";
+
+static const char *__doc_nanogui_TextDocument_Piece_added = R"doc(Whether the piece refers to mAdded (or else to mOriginal))doc";
+
+static const char *__doc_nanogui_TextDocument_Piece_length = R"doc(Length of the piece in bytes)doc";
+
+static const char *__doc_nanogui_TextDocument_Piece_start = R"doc(Offset of the piece within its buffer)doc";
+
+static const char *__doc_nanogui_TextDocument_TextDocument = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_at = R"doc(Return the byte at the given offset)doc";
+
+static const char *__doc_nanogui_TextDocument_buffer = R"doc(Return the buffer a piece refers to)doc";
+
+static const char *__doc_nanogui_TextDocument_canRedo = R"doc(Return whether there is an undone edit that can be redone)doc";
+
+static const char *__doc_nanogui_TextDocument_canUndo = R"doc(Return whether there is an edit that can be undone)doc";
+
+static const char *__doc_nanogui_TextDocument_changeCallback = R"doc(Return the callback that is invoked after every modification)doc";
+
+static const char *__doc_nanogui_TextDocument_clearHistory = R"doc(Discard the undo and redo history)doc";
+
+static const char *__doc_nanogui_TextDocument_closeUndoGroup =
+R"doc(Prevent the next edit from being merged with the previous one in the
+history)doc";
+
+static const char *__doc_nanogui_TextDocument_erase = R"doc(Remove ``length`` bytes starting at ``offset``)doc";
+
+static const char *__doc_nanogui_TextDocument_findPiece = R"doc(Return the index of the piece that contains the given offset)doc";
+
+static const char *__doc_nanogui_TextDocument_insert = R"doc(Insert text at the given offset)doc";
+
+static const char *__doc_nanogui_TextDocument_length = R"doc(Return the length of the text in bytes)doc";
+
+static const char *__doc_nanogui_TextDocument_line = R"doc(Return the contents of a line (excluding the line break))doc";
+
+static const char *__doc_nanogui_TextDocument_lineCount = R"doc(Return the number of lines (at least one))doc";
+
+static const char *__doc_nanogui_TextDocument_lineEnd = R"doc(Return the offset of the end of a line (excluding the line break))doc";
+
+static const char *__doc_nanogui_TextDocument_lineOf = R"doc(Return the line that contains the given offset)doc";
+
+static const char *__doc_nanogui_TextDocument_lineStart = R"doc(Return the offset of the first character of a line)doc";
+
+static const char *__doc_nanogui_TextDocument_mAdded = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mChangeCallback = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mCoalesce = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mLength = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mLineStarts = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mOriginal = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mPieceOffsets = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mPieces = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mRedo = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_mUndo = R"doc()doc";
+
+static const char *__doc_nanogui_TextDocument_pieceCount = R"doc(Return the number of pieces the text currently consists of)doc";
+
+static const char *__doc_nanogui_TextDocument_rawErase = R"doc(Remove text without recording it in the history)doc";
+
+static const char *__doc_nanogui_TextDocument_rawInsert = R"doc(Insert text without recording it in the history)doc";
+
+static const char *__doc_nanogui_TextDocument_record =
+R"doc(Record an edit in the undo history, merging it with the previous one
+if possible)doc";
+
+static const char *__doc_nanogui_TextDocument_redo = R"doc(Reapply the most recently undone group of edits (see undo()))doc";
+
+static const char *__doc_nanogui_TextDocument_replace =
+R"doc(Replace ``length`` bytes starting at ``offset`` by the given text (a
+single undo step))doc";
+
+static const char *__doc_nanogui_TextDocument_setChangeCallback = R"doc(Set the callback that is invoked after every modification)doc";
+
+static const char *__doc_nanogui_TextDocument_setText = R"doc(Replace the contents (clears the undo history))doc";
+
+static const char *__doc_nanogui_TextDocument_splitAt = R"doc(Split pieces so that one starts at ``offset`` and return its index)doc";
+
+static const char *__doc_nanogui_TextDocument_substr = R"doc(Return ``length`` bytes starting at ``offset``)doc";
+
+static const char *__doc_nanogui_TextDocument_text = R"doc(Return the contents as a single string)doc";
+
+static const char *__doc_nanogui_TextDocument_undo =
+R"doc(Revert the most recent group of edits.
+
+Parameter ``caret``:
+    If not ``nullptr``, receives the offset right after the restored
+    text.
+
+Returns:
+    ``false`` if there was nothing to undo.)doc";
+
+static const char *__doc_nanogui_TextDocument_updatePieceOffsets = R"doc(Recompute the document offsets of all pieces starting at ``index``)doc";
+
 static const char *__doc_nanogui_Theme = R"doc(Storage class for basic theme-related properties.)doc";
 
 static const char *__doc_nanogui_Theme_Theme = R"doc()doc";
@@ -3338,7 +4220,13 @@ static const char *__doc_nanogui_UniformBufferStd140_push_back_3 = R"doc()doc";
 
 static const char *__doc_nanogui_VScrollPanel =
 R"doc(Adds a vertical scrollbar around a widget that is too big to fit into
-a certain area.)doc";
+a certain area.
+
+Scrolling only translates the child widget; its layout is recomputed
+when the size of the panel changes or when performLayout() is called,
+e.g. after widgets were added to or removed from the scrolled content.
+Scroll wheel input is applied smoothly over the following frames
+unless setSmoothScrolling() is used to disable this.)doc";
 
 static const char *__doc_nanogui_VScrollPanel_VScrollPanel = R"doc()doc";
 
@@ -3348,8 +4236,16 @@ static const char *__doc_nanogui_VScrollPanel_load = R"doc()doc";
 
 static const char *__doc_nanogui_VScrollPanel_mChildPreferredHeight = R"doc()doc";
 
+static const char *__doc_nanogui_VScrollPanel_mLastScrollTime = R"doc()doc";
+
+static const char *__doc_nanogui_VScrollPanel_mLayoutSize = R"doc()doc";
+
 static const char *__doc_nanogui_VScrollPanel_mScroll = R"doc()doc";
 
+static const char *__doc_nanogui_VScrollPanel_mScrollVelocity = R"doc()doc";
+
+static const char *__doc_nanogui_VScrollPanel_mSmoothScrolling = R"doc()doc";
+
 static const char *__doc_nanogui_VScrollPanel_mUpdateLayout = R"doc()doc";
 
 static const char *__doc_nanogui_VScrollPanel_mouseDragEvent = R"doc()doc";
@@ -3394,6 +4290,12 @@ static const char *__doc_nanogui_VScrollPanel_setScroll =
 R"doc(Set the scroll amount to a value between 0 and 1. 0 means scrolled to
 the top and 1 to the bottom.)doc";
 
+static const char *__doc_nanogui_VScrollPanel_setSmoothScrolling = R"doc(Set whether scroll wheel input glides to a halt instead of jumping)doc";
+
+static const char *__doc_nanogui_VScrollPanel_smoothScrolling = R"doc(Return whether scroll wheel input glides to a halt instead of jumping)doc";
+
+static const char *__doc_nanogui_VScrollPanel_updateScrollMotion = R"doc(Advance an ongoing inertial scroll motion to the current time)doc";
+
 static const char *__doc_nanogui_Widget =
 R"doc(Base class of all widgets.
 
@@ -3416,6 +4318,8 @@ parent)doc";
 
 static const char *__doc_nanogui_Widget_addChild_2 = R"doc(Convenience function which appends a widget at the end)doc";
 
+static const char *__doc_nanogui_Widget_cached = R"doc(Return whether this widget and its children are drawn from a retained cache)doc";
+
 static const char *__doc_nanogui_Widget_childAt = R"doc(Retrieves the child at the specific position)doc";
 
 static const char *__doc_nanogui_Widget_childAt_2 = R"doc(Retrieves the child at the specific position)doc";
@@ -3550,6 +4454,8 @@ static const char *__doc_nanogui_Widget_mVisible =
 R"doc(Whether or not this Widget is currently visible. When a Widget is not
 currently visible, no time is wasted executing its drawing method.)doc";
 
+static const char *__doc_nanogui_Widget_markDirty = R"doc(Record a change of this widget's appearance, invalidating caches of it and its parents)doc";
+
 static const char *__doc_nanogui_Widget_mouseButtonEvent =
 R"doc(Handle a mouse button event (default implementation: propagate to
 children))doc";
@@ -3614,6 +4520,28 @@ static const char *__doc_nanogui_Widget_scrollEvent =
 R"doc(Handle a mouse scroll event (default implementation: propagate to
 children))doc";
 
+static const char *__doc_nanogui_Widget_setCached =
+R"doc(Set whether this widget and its children are drawn from a retained
+cache.
+
+A cached subtree is rendered into an offscreen texture, which is then
+composited with a single textured rectangle. The texture is only
+redrawn when the stateVersion() of the widget changes or when its size
+or the pixel ratio changes; moving the widget merely translates the
+texture. This makes large, mostly static panels nearly free to redraw.
+
+The version is bumped automatically by input events routed to widgets
+in the subtree, focus changes, layout changes and changes to the
+visibility or enabled state. Programmatic changes of other widget
+state (e.g. the caption of a label) must be followed by a call to
+markDirty(). Subtrees containing widgets that change every frame
+should not be cached.
+
+Parameter ``margin``:
+    Additional space around the widget that is included in the cache,
+    e.g. for the drop shadow of a Window. The margin is not clipped by
+    the parent widgets.)doc";
+
 static const char *__doc_nanogui_Widget_setCursor = R"doc(Set the cursor of the widget)doc";
 
 static const char *__doc_nanogui_Widget_setEnabled = R"doc(Set whether or not this widget is currently enabled)doc";
@@ -3663,6 +4591,8 @@ static const char *__doc_nanogui_Widget_setWidth = R"doc(Set the width of the wi
 
 static const char *__doc_nanogui_Widget_size = R"doc(Return the size of the widget)doc";
 
+static const char *__doc_nanogui_Widget_stateVersion = R"doc(Return a counter which is incremented whenever this widget or one of its children changes)doc";
+
 static const char *__doc_nanogui_Widget_theme = R"doc(Return the Theme used to draw this widget)doc";
 
 static const char *__doc_nanogui_Widget_theme_2 = R"doc(Return the Theme used to draw this widget)doc";
@@ -3693,6 +4623,14 @@ static const char *__doc_nanogui_Window_dispose = R"doc(Dispose the window)doc";
 
 static const char *__doc_nanogui_Window_draw = R"doc(Draw the window)doc";
 
+static const char *__doc_nanogui_Window_drawCached = R"doc(Composite the layer of the window using the current opacity)doc";
+
+static const char *__doc_nanogui_Window_layerMargin =
+R"doc(Space around the window that is covered by its layer; overridden in
+Popup)doc";
+
+static const char *__doc_nanogui_Window_layered = R"doc(Return whether the window is drawn from its own compositing layer)doc";
+
 static const char *__doc_nanogui_Window_load = R"doc()doc";
 
 static const char *__doc_nanogui_Window_mButtonPanel = R"doc()doc";
@@ -3701,6 +4639,8 @@ static const char *__doc_nanogui_Window_mDrag = R"doc()doc";
 
 static const char *__doc_nanogui_Window_mModal = R"doc()doc";
 
+static const char *__doc_nanogui_Window_mOpacity = R"doc()doc";
+
 static const char *__doc_nanogui_Window_mTitle = R"doc()doc";
 
 static const char *__doc_nanogui_Window_modal = R"doc(Is this a model dialog?)doc";
@@ -3711,6 +4651,8 @@ top)doc";
 
 static const char *__doc_nanogui_Window_mouseDragEvent = R"doc(Handle window drag events)doc";
 
+static const char *__doc_nanogui_Window_opacity = R"doc(Return the opacity of the window)doc";
+
 static const char *__doc_nanogui_Window_operator_delete = R"doc()doc";
 
 static const char *__doc_nanogui_Window_operator_delete_2 = R"doc()doc";
@@ -3751,14 +4693,43 @@ static const char *__doc_nanogui_Window_scrollEvent =
 R"doc(Accept scroll events and propagate them to the widget under the mouse
 cursor)doc";
 
+static const char *__doc_nanogui_Window_setLayered =
+R"doc(Set whether the window is drawn from its own compositing layer.
+
+A layered window renders itself, its drop shadow and all of its
+children into a texture (see Widget::setCached()). The texture is only
+redrawn when the contents of the window change; moving the window,
+changing its stacking order or fading it via setOpacity() merely
+composites the existing texture at a new position.)doc";
+
 static const char *__doc_nanogui_Window_setModal = R"doc(Set whether or not this is a modal dialog)doc";
 
+static const char *__doc_nanogui_Window_setOpacity =
+R"doc(Set the opacity of the window (between 0 and 1).
+
+For layered windows, this blends the layer as a whole and does not
+require it to be redrawn. Otherwise, the opacity is applied to every
+shape separately, so overlapping shapes will show through each other.)doc";
+
 static const char *__doc_nanogui_Window_setTitle = R"doc(Set the window title)doc";
 
 static const char *__doc_nanogui_Window_title = R"doc(Return the window title)doc";
 
 static const char *__doc_nanogui_active = R"doc(Return whether or not a main loop is currently active)doc";
 
+static const char *__doc_nanogui_build =
+R"doc(Create a widget subtree below ``parent`` from a description
+
+The description has the form ``(type, {property: value, ..}, [child,
+..])``, where ``type`` is a widget class or its name. The properties
+``args`` (extra constructor arguments) and ``id`` (key under which the
+widget is stored in the ``ids`` dictionary) are special; all others
+are set as in set_property(). Returns the root of the new subtree.
+
+Parameter ``layout``:
+    Widget whose layout is recomputed once at the end (optional). It
+    must be part of a screen.)doc";
+
 static const char *__doc_nanogui_chdir_to_bundle_parent =
 R"doc(Move to the application bundle's parent directory
 
@@ -3863,6 +4834,34 @@ static const char *__doc_nanogui_detail_FormWidget_value = R"doc(Returns the val
 
 static const char *__doc_nanogui_detail_FormWidget_value_2 = R"doc(Returns the value of nanogui::ColorPicker::color.)doc";
 
+static const char *__doc_nanogui_detail_PyOverrides =
+R"doc(Remembers which virtual methods of a trampoline instance are
+overridden in Python.
+
+The first call of each method looks up the Python override (with the
+GIL held). Afterwards, methods without an override are dispatched
+straight to the C++ implementation, so that plain widgets created from
+Python neither acquire the GIL nor consult the interpreter while they
+are drawn or receive events. Overrides that are attached to an
+instance after the first call of a method are not noticed.)doc";
+
+static const char *__doc_nanogui_detail_PyOverrides_PyOverrides = R"doc()doc";
+
+static const char *__doc_nanogui_detail_PyOverrides_has = R"doc(Return whether the Python object wrapping ``self`` overrides the given method)doc";
+
+static const char *__doc_nanogui_detail_PyOverrides_mCount = R"doc()doc";
+
+static const char *__doc_nanogui_detail_PyOverrides_mNames = R"doc()doc";
+
+static const char *__doc_nanogui_detail_PyOverrides_mOverridden = R"doc()doc";
+
+static const char *__doc_nanogui_detail_is_reflected =
+R"doc(Detects whether the fields of a type were declared with NANOGUI_REFLECT.)doc";
+
+static const char *__doc_nanogui_detail_is_reflected_test = R"doc()doc";
+
+static const char *__doc_nanogui_detail_is_reflected_test_2 = R"doc()doc";
+
 static const char *__doc_nanogui_detail_type_traits = R"doc()doc";
 
 static const char *__doc_nanogui_detail_type_traits_2 = R"doc()doc";
@@ -3917,6 +4916,8 @@ static const char *__doc_nanogui_detail_type_traits_type_8 = R"doc()doc";
 
 static const char *__doc_nanogui_detail_type_traits_type_9 = R"doc()doc";
 
+static const char *__doc_nanogui_fields = R"doc(Return the tuple of Field descriptions of a reflected struct)doc";
+
 static const char *__doc_nanogui_file_dialog =
 R"doc(Open a native file open/save dialog.
 
@@ -3943,6 +4944,15 @@ Parameter ``multiple``:
     Set to ``True`` if you would like to be able to select multiple
     files at once. May not be simultaneously true with \p save.)doc";
 
+static const char *__doc_nanogui_forEachField =
+R"doc(Invoke a function object on the Field description of every field of a
+reflected struct, in declaration order.
+
+The function object must accept ``const Field<T, Type> &`` for each
+field type (e.g. by a templated ``operator()``). The loop is unrolled
+at compile time, so every call is made with the static type of the
+field.)doc";
+
 static const char *__doc_nanogui_frustum =
 R"doc(Creates a perspective projection matrix.
 
@@ -3976,6 +4986,10 @@ and GLFW on your own, while still using NanoGUI's classes.
 
 ```)doc";
 
+static const char *__doc_nanogui_last_interaction =
+R"doc(Return the time of the most recent user interaction with any visible
+screen)doc";
+
 static const char *__doc_nanogui_leave =
 R"doc(Request the application main loop to terminate (e.g. if you detached
 mainloop).)doc";
@@ -4023,7 +5037,9 @@ Parameter ``detach``:
     ``detach != None``, the function returns an opaque handle that
     will release any resources allocated by the created thread when
     the handle's ``join()`` method is invoked (or when it is garbage
-    collected).
+    collected). Alternatively, ``mainloop_async()`` runs the main loop
+    as a task of the current ``asyncio`` event loop without creating
+    any threads (see mainloop_iteration()).
 
 Remark:
     Unfortunately, Mac OS X strictly requires all event processing to
@@ -4041,6 +5057,50 @@ Remark:
     the main loop and then swap the two thread environments back into
     their initial configuration.)doc";
 
+static const char *__doc_nanogui_mainloop_async =
+R"doc(Run the application main loop as a task of the current ``asyncio``
+event loop
+
+Pending events are polled without blocking, since GLFW can only wait
+for events on the main thread, which would block the event loop. This
+happens once per frame while the user interacts with a screen; when
+idle, the polling period gradually backs off to 100 ms. A finished
+``async def`` callback or ``leave()`` wakes the loop immediately. The
+visible screens are redrawn after user interactions, after an
+``async def`` callback finished, and at least once every ``refresh``
+milliseconds (a negative value disables the refresh timer). Event
+callbacks (e.g. of buttons, sliders, text boxes, and the screen resize
+callback) may be coroutine functions; they are scheduled as tasks on
+the event loop and can ``await`` long-running work (e.g. via
+``loop.run_in_executor()``) without blocking the user interface.
+Callbacks whose result is used or that must finish synchronously (e.g.
+``ImageView.setPixelInfoCallback`` and ``LazyPage.setReleaseCallback``)
+must be regular functions.
+
+Returns a future that completes once all screens are closed or
+``leave()`` is called.)doc";
+
+static const char *__doc_nanogui_mainloop_iteration =
+R"doc(Run a single iteration of the application main loop
+
+Draws all visible screens (unless ``draw`` is ``false``) and then
+processes pending mouse/keyboard/.. events. Screens whose windows were
+asked to close are hidden. This is the body of mainloop(); calling it
+repeatedly makes it possible to drive NanoGUI from a different event
+loop (the Python bindings use it to run the user interface as a task
+of an ``asyncio`` event loop).
+
+Parameter ``timeout``:
+    Number of seconds to wait for an event when none is pending. Zero
+    only processes the events that have already arrived, and a
+    negative value waits until the next event.
+
+Parameter ``draw``:
+    Whether to redraw the visible screens before processing events.
+
+Returns:
+    ``false`` if there is no visible screen anymore.)doc";
+
 static const char *__doc_nanogui_nanogui_get_image = R"doc(Helper function used by nvgImageIcon)doc";
 
 static const char *__doc_nanogui_nvgIsFontIcon =
@@ -4181,6 +5241,32 @@ components with the corresponding entries of the 3D vector ``v``. The
 Parameter ``v``:
     The vector representing the scaling for each axis.)doc";
 
+static const char *__doc_nanogui_set_properties =
+R"doc(Apply a list of ``(widget, name, value)`` property updates in one call
+
+All updates are validated first: if a widget lacks one of the
+properties, an exception is raised before any widget is modified.
+
+Parameter ``layout``:
+    Widget whose layout is recomputed once at the end (optional). It
+    must be part of a screen.)doc";
+
+static const char *__doc_nanogui_set_property =
+R"doc(Set the property ``name`` (e.g. ``"caption"`` or ``"fixedSize"``) of
+many widgets in one call
+
+``values`` holds one value per widget or a single value for all of
+them; numeric properties accept an array with one row per widget.
+Common properties are applied natively with the GIL released; other
+properties, and widgets without a native setter for them, use the
+widget's Python setter (e.g. ``setValue()``). All widgets are checked
+for the property first, so that a missing property leaves every widget
+unmodified.
+
+Parameter ``layout``:
+    Widget whose layout is recomputed once at the end (optional). It
+    must be part of a screen.)doc";
+
 static const char *__doc_nanogui_shutdown = R"doc(Static shutdown; should be called before the application terminates.)doc";
 
 static const char *__doc_nanogui_translate =
@@ -2,6 +2,7 @@
 
 #include "python.h"
 
+DECLARE_WIDGET(LazyPage);
 DECLARE_WIDGET(StackedWidget);
 DECLARE_WIDGET(TabHeader);
 DECLARE_WIDGET(TabWidget);
@@ -10,7 +11,20 @@ void register_tabs(py::module &m) {
     py::class_<StackedWidget, Widget, ref<StackedWidget>, PyStackedWidget>(m, "StackedWidget", D(StackedWidget))
         .def(py::init<Widget *>(), D(StackedWidget, StackedWidget))
         .def("selectedIndex", &StackedWidget::selectedIndex, D(StackedWidget, selectedIndex))
-        .def("setSelectedIndex", &StackedWidget::setSelectedIndex, D(StackedWidget, setSelectedIndex));
+        .def("setSelectedIndex", &StackedWidget::setSelectedIndex, D(StackedWidget, setSelectedIndex))
+        .def("releaseTimeout", &StackedWidget::releaseTimeout, D(StackedWidget, releaseTimeout))
+        .def("setReleaseTimeout", &StackedWidget::setReleaseTimeout, D(StackedWidget, setReleaseTimeout));
+
+    py::class_<LazyPage, Widget, ref<LazyPage>, PyLazyPage>(m, "LazyPage", D(LazyPage))
+        .def(py::init<Widget *, const LazyPage::Factory &>(), py::arg("parent"), py::arg("factory"), D(LazyPage, LazyPage))
+        .def("factory", &LazyPage::factory, D(LazyPage, factory))
+        .def("setFactory", &LazyPage::setFactory, D(LazyPage, setFactory))
+        .def("releaseCallback", &LazyPage::releaseCallback, D(LazyPage, releaseCallback))
+        .def("setReleaseCallback", &LazyPage::setReleaseCallback, D(LazyPage, setReleaseCallback))
+        .def("populated", &LazyPage::populated, D(LazyPage, populated))
+        .def("populate", &LazyPage::populate, D(LazyPage, populate))
+        .def("release", &LazyPage::release, D(LazyPage, release))
+        .def("lastDrawn", &LazyPage::lastDrawn, D(LazyPage, lastDrawn));
 
     py::class_<TabHeader, Widget, ref<TabHeader>, PyTabHeader>(m, "TabHeader", D(TabHeader))
         .def(py::init<Widget *, const std::string &>(), D(TabHeader, TabHeader))
@@ -40,6 +54,10 @@ void register_tabs(py::module &m) {
         .def("addTab", (void (TabWidget::*)(int index, const std::string &, Widget *)) &TabWidget::addTab, D(TabWidget, addTab, 2))
         .def("createTab", (Widget *(TabWidget::*)(const std::string &)) &TabWidget::createTab, D(TabWidget, createTab))
         .def("createTab", (Widget *(TabWidget::*)(int index, const std::string &)) &TabWidget::createTab, D(TabWidget, createTab, 2))
+        .def("createLazyTab", (LazyPage *(TabWidget::*)(const std::string &, const std::function<void(Widget *)> &)) &TabWidget::createLazyTab, D(TabWidget, createLazyTab))
+        .def("createLazyTab", (LazyPage *(TabWidget::*)(int index, const std::string &, const std::function<void(Widget *)> &)) &TabWidget::createLazyTab, D(TabWidget, createLazyTab, 2))
+        .def("releaseTimeout", &TabWidget::releaseTimeout, D(TabWidget, releaseTimeout))
+        .def("setReleaseTimeout", &TabWidget::setReleaseTimeout, D(TabWidget, setReleaseTimeout))
         .def("removeTab", (bool (TabWidget::*)(const std::string &)) &TabWidget::removeTab, D(TabWidget, removeTab))
         .def("removeTab", (void (TabWidget::*)(int index)) &TabWidget::removeTab, D(TabWidget, removeTab, 2))
         .def("tabLabelAt", &TabWidget::tabLabelAt, D(TabWidget, tabLabelAt))
@@ -6,6 +6,7 @@ typedef FloatBox<double> DoubleBox;
 typedef IntBox<int64_t> Int64Box;
 
 DECLARE_WIDGET(TextBox);
+DECLARE_WIDGET(TextArea);
 DECLARE_WIDGET(DoubleBox);
 DECLARE_WIDGET(Int64Box);
 
@@ -30,6 +31,8 @@ void register_textbox(py::module &m) {
         .def("setUnitsImage", &TextBox::setUnitsImage, D(TextBox, setUnitsImage))
         .def("format", &TextBox::format, D(TextBox, format))
         .def("setFormat", &TextBox::setFormat, D(TextBox, setFormat))
+        .def("validator", &TextBox::validator, D(TextBox, validator))
+        .def("setValidator", &TextBox::setValidator, D(TextBox, setValidator))
         .def("callback", &TextBox::callback, D(TextBox, callback))
         .def("setCallback", &TextBox::setCallback, D(TextBox, setCallback));
 
@@ -38,6 +41,42 @@ void register_textbox(py::module &m) {
         .value("Center", TextBox::Alignment::Center)
         .value("Right", TextBox::Alignment::Right);
 
+    py::class_<TextDocument>(m, "TextDocument", D(TextDocument))
+        .def("text", &TextDocument::text, D(TextDocument, text))
+        .def("length", &TextDocument::length, D(TextDocument, length))
+        .def("lineCount", &TextDocument::lineCount, D(TextDocument, lineCount))
+        .def("lineStart", &TextDocument::lineStart, D(TextDocument, lineStart))
+        .def("lineEnd", &TextDocument::lineEnd, D(TextDocument, lineEnd))
+        .def("lineOf", &TextDocument::lineOf, D(TextDocument, lineOf))
+        .def("line", &TextDocument::line, D(TextDocument, line))
+        .def("substr", &TextDocument::substr, D(TextDocument, substr))
+        .def("pieceCount", &TextDocument::pieceCount, D(TextDocument, pieceCount))
+        .def("canUndo", &TextDocument::canUndo, D(TextDocument, canUndo))
+        .def("canRedo", &TextDocument::canRedo, D(TextDocument, canRedo));
+
+    py::class_<TextArea, Widget, ref<TextArea>, PyTextArea>(m, "TextArea", D(TextArea))
+        .def(py::init<Widget *, const std::string &>(), py::arg("parent"),
+            py::arg("value") = std::string(""), D(TextArea, TextArea))
+        .def("value", &TextArea::value, D(TextArea, value))
+        .def("setValue", &TextArea::setValue, D(TextArea, setValue))
+        .def("document", &TextArea::document, py::return_value_policy::reference_internal, D(TextArea, document))
+        .def("editable", &TextArea::editable, D(TextArea, editable))
+        .def("setEditable", &TextArea::setEditable, D(TextArea, setEditable))
+        .def("font", &TextArea::font, D(TextArea, font))
+        .def("setFont", &TextArea::setFont, D(TextArea, setFont))
+        .def("textColor", &TextArea::textColor, D(TextArea, textColor))
+        .def("setTextColor", &TextArea::setTextColor, D(TextArea, setTextColor))
+        .def("caretPosition", &TextArea::caretPosition, D(TextArea, caretPosition))
+        .def("setCaretPosition", &TextArea::setCaretPosition, D(TextArea, setCaretPosition))
+        .def("select", &TextArea::select, D(TextArea, select))
+        .def("selectedText", &TextArea::selectedText, D(TextArea, selectedText))
+        .def("insert", &TextArea::insert, D(TextArea, insert))
+        .def("undo", &TextArea::undo, D(TextArea, undo))
+        .def("redo", &TextArea::redo, D(TextArea, redo))
+        .def("scrollToLine", &TextArea::scrollToLine, D(TextArea, scrollToLine))
+        .def("callback", &TextArea::callback, D(TextArea, callback))
+        .def("setCallback", &TextArea::setCallback, D(TextArea, setCallback));
+
     py::class_<Int64Box, TextBox, ref<Int64Box>, PyInt64Box>(m, "IntBox", D(IntBox))
         .def(py::init<Widget *, int64_t>(), py::arg("parent"), py::arg("value") = (int64_t) 0, D(IntBox, IntBox))
         .def("value", &Int64Box::value, D(IntBox, value))
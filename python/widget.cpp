@@ -32,6 +32,11 @@ void register_widget(py::module &m) {
         .def("setFixedHeight", &Widget::setFixedHeight, D(Widget, setFixedHeight))
         .def("visible", &Widget::visible, D(Widget, visible))
         .def("setVisible", &Widget::setVisible, D(Widget, setVisible))
+        .def("cached", &Widget::cached, D(Widget, cached))
+        .def("setCached", &Widget::setCached, py::arg("cached"),
+             py::arg("margin") = 0, D(Widget, setCached))
+        .def("markDirty", &Widget::markDirty, D(Widget, markDirty))
+        .def("stateVersion", &Widget::stateVersion, D(Widget, stateVersion))
         .def("visibleRecursive", &Widget::visibleRecursive, D(Widget, visibleRecursive))
         .def("children", (std::vector<Widget *>&(Widget::*)(void)) &Widget::children,
              D(Widget, children), py::return_value_policy::reference)
@@ -90,6 +95,10 @@ void register_widget(py::module &m) {
         .def("setTitle", &Window::setTitle, D(Window, setTitle))
         .def("modal", &Window::modal, D(Window, modal))
         .def("setModal", &Window::setModal, D(Window, setModal))
+        .def("layered", &Window::layered, D(Window, layered))
+        .def("setLayered", &Window::setLayered, D(Window, setLayered))
+        .def("opacity", &Window::opacity, D(Window, opacity))
+        .def("setOpacity", &Window::setOpacity, D(Window, setOpacity))
         .def("dispose", &Window::dispose, D(Window, dispose))
         .def("buttonPanel", &Window::buttonPanel, D(Window, buttonPanel))
         .def("center", &Window::center, D(Window, center));
@@ -113,10 +122,13 @@ void register_widget(py::module &m) {
         .def("setResizeCallback", &Screen::setResizeCallback)
         .def("dropEvent", &Screen::dropEvent, D(Screen, dropEvent))
         .def("mousePos", &Screen::mousePos, D(Screen, mousePos))
+        .def("lastInteraction", &Screen::lastInteraction, D(Screen, lastInteraction))
         .def("pixelRatio", &Screen::pixelRatio, D(Screen, pixelRatio))
         .def("glfwWindow", &Screen::glfwWindow, D(Screen, glfwWindow),
                 py::return_value_policy::reference)
         .def("nvgContext", &Screen::nvgContext, D(Screen, nvgContext),
-                py::return_value_policy::reference);
+                py::return_value_policy::reference)
+        .def("primitiveBatching", &Screen::primitiveBatching, D(Screen, primitiveBatching))
+        .def("setPrimitiveBatching", &Screen::setPrimitiveBatching, D(Screen, setPrimitiveBatching));
 }
 #endif
@@ -11,6 +11,8 @@
 
 #include <nanogui/button.h>
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
 #include <nanogui/serializer/core.h>
 
@@ -117,40 +119,43 @@ void Button::draw(NVGcontext *ctx) {
         gradBot = mTheme->mButtonGradientBotFocused;
     }
 
-    nvgBeginPath(ctx);
-
-    nvgRoundedRect(ctx, mPos.x() + 1, mPos.y() + 1.0f, mSize.x() - 2,
-                   mSize.y() - 2, mTheme->mButtonCornerRadius - 1);
-
-    if (mBackgroundColor.w() != 0) {
-        nvgFillColor(ctx, Color(mBackgroundColor.head<3>(), 1.f));
-        nvgFill(ctx);
-        if (mPushed) {
-            gradTop.a = gradBot.a = 0.8f;
-        } else {
-            double v = 1 - mBackgroundColor.w();
-            gradTop.a = gradBot.a = mEnabled ? v : v * .5f + .5f;
+    const Skin *skin = mTheme->skin();
+    if (skin && skin->ready() && mBackgroundColor.w() == 0) {
+        Skin::Element element = Skin::Element::ButtonNormal;
+        if (mPushed)
+            element = Skin::Element::ButtonPushed;
+        else if (mMouseFocus && mEnabled)
+            element = Skin::Element::ButtonFocused;
+        skin->draw(ctx, element, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    } else {
+        float x = mPos.x() + 1, y = mPos.y() + 1.0f, w = mSize.x() - 2,
+              h = mSize.y() - 2, r = mTheme->mButtonCornerRadius - 1;
+
+        if (mBackgroundColor.w() != 0) {
+            PrimitiveBatch::fillRoundedRect(ctx, x, y, w, h, r,
+                                            Color(mBackgroundColor.head<3>(), 1.f));
+            if (mPushed) {
+                gradTop.a = gradBot.a = 0.8f;
+            } else {
+                double v = 1 - mBackgroundColor.w();
+                gradTop.a = gradBot.a = mEnabled ? v : v * .5f + .5f;
+            }
         }
-    }
 
-    NVGpaint bg = nvgLinearGradient(ctx, mPos.x(), mPos.y(), mPos.x(),
-                                    mPos.y() + mSize.y(), gradTop, gradBot);
+        NVGpaint bg = nvgLinearGradient(ctx, mPos.x(), mPos.y(), mPos.x(),
+                                        mPos.y() + mSize.y(), gradTop, gradBot);
 
-    nvgFillPaint(ctx, bg);
-    nvgFill(ctx);
+        PrimitiveBatch::fillRoundedRect(ctx, x, y, w, h, r, bg);
 
-    nvgBeginPath(ctx);
-    nvgStrokeWidth(ctx, 1.0f);
-    nvgRoundedRect(ctx, mPos.x() + 0.5f, mPos.y() + (mPushed ? 0.5f : 1.5f), mSize.x() - 1,
-                   mSize.y() - 1 - (mPushed ? 0.0f : 1.0f), mTheme->mButtonCornerRadius);
-    nvgStrokeColor(ctx, mTheme->mBorderLight);
-    nvgStroke(ctx);
+        PrimitiveBatch::strokeRoundedRect(
+            ctx, mPos.x() + 0.5f, mPos.y() + (mPushed ? 0.5f : 1.5f), mSize.x() - 1,
+            mSize.y() - 1 - (mPushed ? 0.0f : 1.0f), mTheme->mButtonCornerRadius,
+            1.0f, mTheme->mBorderLight);
 
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x() + 0.5f, mPos.y() + 0.5f, mSize.x() - 1,
-                   mSize.y() - 2, mTheme->mButtonCornerRadius);
-    nvgStrokeColor(ctx, mTheme->mBorderDark);
-    nvgStroke(ctx);
+        PrimitiveBatch::strokeRoundedRect(
+            ctx, mPos.x() + 0.5f, mPos.y() + 0.5f, mSize.x() - 1, mSize.y() - 2,
+            mTheme->mButtonCornerRadius, 1.0f, mTheme->mBorderDark);
+    }
 
     int fontSize = mFontSize == -1 ? mTheme->mButtonFontSize : mFontSize;
     nvgFontSize(ctx, fontSize);
@@ -0,0 +1,395 @@
+/*
+    src/capture.cpp -- Asynchronous framebuffer readback and frame encoding
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/capture.h>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <array>
+
+NAMESPACE_BEGIN(nanogui)
+
+void GLFrameCapture::init(const Vector2i &size, int bufferCount) {
+    if (bufferCount < 1)
+        throw std::runtime_error("GLFrameCapture::init(): need at least one buffer!");
+    if (ready())
+        free();
+
+    mSize = size;
+    mHead = mPending = 0;
+    mSlots.resize(bufferCount);
+
+    size_t bufferSize = (size_t) size.x() * (size_t) size.y() * 4;
+    for (auto &slot : mSlots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ);
+        slot.fence = nullptr;
+        slot.time = 0.0;
+        slot.index = 0;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void GLFrameCapture::free() {
+    for (auto &slot : mSlots) {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        glDeleteBuffers(1, &slot.pbo);
+    }
+    mSlots.clear();
+    mHead = mPending = 0;
+    if (mResolve.ready())
+        mResolve.free();
+}
+
+void GLFrameCapture::capture(GLuint framebuffer, double time) {
+    if (!ready())
+        throw std::runtime_error("GLFrameCapture::capture(): not initialized!");
+
+    /* Hand out whatever has completed in the meantime */
+    poll(false);
+
+    /* Ring is full: the GPU is lagging behind, wait for the oldest readback */
+    if (mPending == (int) mSlots.size())
+        retrieve(true);
+
+    Slot &slot = mSlots[mHead];
+    slot.time = time;
+    slot.index = mFrameIndex++;
+
+    GLint prevReadFramebuffer = 0, prevReadBuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFramebuffer);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    if (framebuffer == 0) {
+        glGetIntegerv(GL_READ_BUFFER, &prevReadBuffer);
+        glReadBuffer(GL_BACK);
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glReadPixels(0, 0, mSize.x(), mSize.y(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (framebuffer == 0)
+        glReadBuffer((GLenum) prevReadBuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint) prevReadFramebuffer);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    mHead = (mHead + 1) % (int) mSlots.size();
+    mPending++;
+}
+
+void GLFrameCapture::capture(GLFramebuffer &framebuffer, double time) {
+    if (framebuffer.samples() <= 1) {
+        capture(framebuffer.framebuffer(), time);
+        return;
+    }
+
+    /* glReadPixels() cannot read from multisampled buffers: resolve first */
+    if (!mResolve.ready() || mResolve.size() != mSize) {
+        if (mResolve.ready())
+            mResolve.free();
+        mResolve.init(mSize, 0);
+    }
+
+    GLint prevReadFramebuffer = 0, prevDrawFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFramebuffer);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFramebuffer);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.framebuffer());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mResolve.framebuffer());
+    glBlitFramebuffer(0, 0, mSize.x(), mSize.y(), 0, 0, mSize.x(), mSize.y(),
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint) prevReadFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint) prevDrawFramebuffer);
+
+    capture(mResolve.framebuffer(), time);
+}
+
+int GLFrameCapture::poll(bool wait) {
+    int count = 0;
+    while (mPending > 0 && retrieve(wait))
+        count++;
+    return count;
+}
+
+bool GLFrameCapture::retrieve(bool wait) {
+    int tail = (mHead - mPending + (int) mSlots.size()) % (int) mSlots.size();
+    Slot &slot = mSlots[tail];
+
+    GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     wait ? GL_TIMEOUT_IGNORED : 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+        return false;
+    if (result == GL_WAIT_FAILED)
+        std::cerr << "GLFrameCapture: glClientWaitSync() failed!" << std::endl;
+
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    mPending--;
+
+    if (!mCallback)
+        return true;
+
+    CapturedFrame frame;
+    frame.size = mSize;
+    frame.time = slot.time;
+    frame.index = slot.index;
+
+    size_t rowSize = (size_t) mSize.x() * 4;
+    frame.data.resize(rowSize * (size_t) mSize.y());
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const uint8_t *src = (const uint8_t *) glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, frame.data.size(), GL_MAP_READ_BIT);
+    if (src) {
+        /* OpenGL stores the bottom row first -- flip while copying */
+        for (int y = 0; y < mSize.y(); ++y)
+            memcpy(frame.data.data() + y * rowSize,
+                   src + (mSize.y() - 1 - y) * rowSize, rowSize);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (src)
+        mCallback(std::move(frame));
+
+    return true;
+}
+
+//  ----------------------------------------------------
+
+bool FrameEncoder::validPattern(const std::string &path) {
+    /* Accept "%%" and a single "%d" with optional flags and width */
+    int conversions = 0;
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (path[i] != '%')
+            continue;
+        if (++i < path.size() && path[i] == '%')
+            continue;
+        while (i < path.size() && std::string("-+ #0").find(path[i]) != std::string::npos)
+            ++i;
+        while (i < path.size() && isdigit((unsigned char) path[i]))
+            ++i;
+        if (i >= path.size() || path[i] != 'd')
+            return false;
+        conversions++;
+    }
+    return conversions == 1;
+}
+
+FrameEncoder::FrameEncoder(const std::string &path, Format format, int fps,
+                           size_t queueSize)
+    : mPath(path), mFormat(format), mFPS(fps), mFile(nullptr),
+      mStreamSize(Vector2i::Zero()), mQueue(queueSize), mActive(true),
+      mWritten(0), mDropped(0) {
+    if (format == Format::PNG) {
+        if (!validPattern(path))
+            throw std::runtime_error("FrameEncoder: \"" + path + "\" must contain "
+                                     "exactly one %d conversion!");
+    } else {
+        mFile = fopen(path.c_str(), "wb");
+        if (mFile == nullptr)
+            throw std::runtime_error("FrameEncoder: could not open \"" + path + "\"!");
+    }
+    mThread = std::thread([this]() { run(); });
+}
+
+FrameEncoder::~FrameEncoder() {
+    mActive = false;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mCond.notify_one();
+    }
+    mThread.join();
+    if (mFile)
+        fclose(mFile);
+}
+
+bool FrameEncoder::push(CapturedFrame &&frame) {
+    if (!mQueue.push(std::move(frame))) {
+        mDropped++;
+        return false;
+    }
+    mCond.notify_one();
+    return true;
+}
+
+void FrameEncoder::run() {
+    CapturedFrame frame;
+    while (true) {
+        /* Read the flag first: everything pushed before it was cleared
+           is then guaranteed to be visible to the drain loop below */
+        bool active = mActive;
+        while (mQueue.pop(frame)) {
+            try {
+                write(frame);
+                mWritten++;
+            } catch (const std::exception &e) {
+                std::cerr << "FrameEncoder: " << e.what() << std::endl;
+            }
+        }
+        if (!active)
+            break;
+        /* The producer never takes the lock, so use a timeout to
+           recover from a notification that raced with this wait */
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCond.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+void FrameEncoder::write(const CapturedFrame &frame) {
+    const Vector2i &size = frame.size;
+    size_t nPixels = (size_t) size.x() * (size_t) size.y();
+
+    if (mFormat == Format::PNG) {
+        char filename[1024];
+        snprintf(filename, sizeof(filename), mPath.c_str(), (int) mWritten);
+        writePNG(filename, size, frame.data.data());
+        return;
+    }
+
+    if (mStreamSize == Vector2i::Zero()) {
+        mStreamSize = size;
+        if (mFormat == Format::Y4M)
+            fprintf(mFile, "YUV4MPEG2 W%i H%i F%i:1 Ip A1:1 C444\n",
+                    size.x(), size.y(), mFPS);
+    } else if (mStreamSize != size) {
+        throw std::runtime_error("frame size changed during capture, skipping frame");
+    }
+
+    if (mFormat == Format::Raw) {
+        fwrite(frame.data.data(), nPixels * 4, 1, mFile);
+        return;
+    }
+
+    /* Convert to planar YCbCr 4:4:4 (BT.601, studio swing) */
+    mScratch.resize(nPixels * 3);
+    uint8_t *Y = mScratch.data(), *U = Y + nPixels, *V = U + nPixels;
+    const uint8_t *src = frame.data.data();
+    for (size_t i = 0; i < nPixels; ++i, src += 4) {
+        int r = src[0], g = src[1], b = src[2];
+        Y[i] = (uint8_t) (((  66 * r + 129 * g +  25 * b + 128) >> 8) +  16);
+        U[i] = (uint8_t) ((( -38 * r -  74 * g + 112 * b + 128) >> 8) + 128);
+        V[i] = (uint8_t) ((( 112 * r -  94 * g -  18 * b + 128) >> 8) + 128);
+    }
+    fputs("FRAME\n", mFile);
+    fwrite(mScratch.data(), mScratch.size(), 1, mFile);
+}
+
+//  ----------------------------------------------------
+
+namespace {
+    uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size) {
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> result;
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                result[i] = c;
+            }
+            return result;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    uint32_t adler32(const uint8_t *data, size_t size) {
+        uint32_t a = 1, b = 0;
+        while (size > 0) {
+            /* 5552 is the largest block that cannot overflow 'b' */
+            size_t blockSize = std::min(size, (size_t) 5552);
+            for (size_t i = 0; i < blockSize; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += blockSize;
+            size -= blockSize;
+        }
+        return (b << 16) | a;
+    }
+
+    void putU32(std::vector<uint8_t> &out, uint32_t value) {
+        out.push_back((uint8_t) (value >> 24));
+        out.push_back((uint8_t) (value >> 16));
+        out.push_back((uint8_t) (value >> 8));
+        out.push_back((uint8_t) value);
+    }
+
+    void writeChunk(FILE *f, const char *type, const std::vector<uint8_t> &payload) {
+        std::vector<uint8_t> chunk;
+        chunk.reserve(payload.size() + 12);
+        putU32(chunk, (uint32_t) payload.size());
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), payload.begin(), payload.end());
+        putU32(chunk, crc32(0, chunk.data() + 4, chunk.size() - 4));
+        fwrite(chunk.data(), chunk.size(), 1, f);
+    }
+}
+
+void writePNG(const std::string &filename, const Vector2i &size, const uint8_t *data) {
+    FILE *f = fopen(filename.c_str(), "wb");
+    if (f == nullptr)
+        throw std::runtime_error("writePNG(): could not open \"" + filename + "\"!");
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    fwrite(signature, sizeof(signature), 1, f);
+
+    std::vector<uint8_t> header;
+    putU32(header, (uint32_t) size.x());
+    putU32(header, (uint32_t) size.y());
+    header.push_back(8); /* Bit depth */
+    header.push_back(6); /* Color type: RGBA */
+    header.push_back(0); /* Compression */
+    header.push_back(0); /* Filter */
+    header.push_back(0); /* Interlace */
+    writeChunk(f, "IHDR", header);
+
+    /* Filtered scanlines: one filter byte (0 = none) per row */
+    size_t rowSize = (size_t) size.x() * 4;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowSize + 1) * size.y());
+    for (int y = 0; y < size.y(); ++y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), data + y * rowSize, data + (y + 1) * rowSize);
+    }
+
+    /* zlib stream made of uncompressed ("stored") deflate blocks */
+    std::vector<uint8_t> idat;
+    idat.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    idat.push_back(0x78); idat.push_back(0x01);
+    size_t offset = 0;
+    do {
+        size_t blockSize = std::min(raw.size() - offset, (size_t) 65535);
+        bool last = offset + blockSize == raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.push_back((uint8_t) (blockSize & 0xFF));
+        idat.push_back((uint8_t) (blockSize >> 8));
+        idat.push_back((uint8_t) (~blockSize & 0xFF));
+        idat.push_back((uint8_t) ((~blockSize >> 8) & 0xFF));
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+
+    putU32(idat, adler32(raw.data(), raw.size()));
+    writeChunk(f, "IDAT", idat);
+    writeChunk(f, "IEND", std::vector<uint8_t>());
+    fclose(f);
+}
+
+NAMESPACE_END(nanogui)
@@ -12,6 +12,7 @@
 #include <nanogui/checkbox.h>
 #include <nanogui/opengl.h>
 #include <nanogui/theme.h>
+#include <nanogui/primitives.h>
 #include <nanogui/serializer/core.h>
 
 NAMESPACE_BEGIN(nanogui)
@@ -73,11 +74,8 @@ void CheckBox::draw(NVGcontext *ctx) {
                                  mPushed ? Color(0, 100) : Color(0, 32),
                                  Color(0, 0, 0, 180));
 
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x() + 1.0f, mPos.y() + 1.0f, mSize.y() - 2.0f,
-                   mSize.y() - 2.0f, 3);
-    nvgFillPaint(ctx, bg);
-    nvgFill(ctx);
+    PrimitiveBatch::fillRoundedRect(ctx, mPos.x() + 1.0f, mPos.y() + 1.0f,
+                                    mSize.y() - 2.0f, mSize.y() - 2.0f, 3, bg);
 
     if (mChecked) {
         nvgFontSize(ctx, mSize.y() * icon_scale());
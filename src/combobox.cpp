@@ -11,30 +11,334 @@
 
 #include <nanogui/combobox.h>
 #include <nanogui/layout.h>
+#include <nanogui/theme.h>
+#include <nanogui/primitives.h>
+#include <nanogui/opengl.h>
 #include <nanogui/serializer/core.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
+#include <mutex>
+#include <thread>
 
 NAMESPACE_BEGIN(nanogui)
 
-ComboBox::ComboBox(Widget *parent) : PopupButton(parent), mSelectedIndex(0) {
+namespace {
+    /* Lower-case ASCII characters, leaving other UTF-8 bytes untouched */
+    std::string toLower(std::string str) {
+        for (char &c : str)
+            c = (char) std::tolower((unsigned char) c);
+        return str;
+    }
+}
+
+/**
+ * \struct ComboBox::IndexSlot combobox.h nanogui/combobox.h
+ *
+ * \brief Result of the (detached) worker thread that builds a \ref PrefixIndex.
+ *
+ * The slot is shared between the combo box and the worker, so neither
+ * replacing the items nor destroying the combo box has to wait for it.
+ */
+struct ComboBox::IndexSlot {
+    /// Set when the items changed, which tells the worker to stop early
+    std::atomic<bool> cancelled { false };
+    /// Protects \ref index
+    std::mutex mutex;
+    /// The finished index (``nullptr`` while it is being built)
+    std::shared_ptr<const PrefixIndex> index;
+};
+
+/**
+ * \class ComboBox::ItemList combobox.h nanogui/combobox.h
+ *
+ * \brief Scrollable list inside the popup of a virtualized \ref ComboBox.
+ *
+ * The list has a fixed height and draws only the rows that are visible. The
+ * first row shows the type-ahead filter.
+ */
+class ComboBox::ItemList : public Widget {
+public:
+    ItemList(Widget *parent, ComboBox *combo)
+        : Widget(parent), mCombo(combo), mScroll(0.f), mHover(-1),
+          mHighlight(-1), mDragScrollbar(false) { }
+
+    /// Show the selected item and reset the highlight
+    void reset() {
+        int count = mCombo->filteredCount(), selected = mCombo->mSelectedIndex;
+        if (mCombo->mFilterActive) {
+            auto it = std::lower_bound(mCombo->mFiltered.begin(),
+                                       mCombo->mFiltered.end(), selected);
+            mHighlight = it != mCombo->mFiltered.end() && *it == selected
+                             ? (int) (it - mCombo->mFiltered.begin()) : 0;
+        } else {
+            mHighlight = selected;
+        }
+        if (mHighlight >= count)
+            mHighlight = count - 1;
+        mHover = -1;
+        mScroll = (float) (mHighlight - rowCount() / 2);
+        clampScroll();
+        markDirty();
+    }
+
+    virtual Vector2i preferredSize(NVGcontext *) const override {
+        int rows = std::max(1, std::min(mCombo->mVisibleRows, (int) mCombo->mItems.size()));
+        return Vector2i(std::max(mCombo->width(), 200),
+                        headerHeight() + rows * rowHeight());
+    }
+
+    virtual void draw(NVGcontext *ctx) override {
+        int rh = rowHeight(), hh = headerHeight();
+        int count = mCombo->filteredCount(), rows = rowCount();
+        bool scrollbar = count > rows;
+        float textWidth = mSize.x() - (scrollbar ? 12 : 0);
+
+        nvgFontSize(ctx, fontSize());
+        nvgFontFace(ctx, "sans");
+        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+
+        /* Type-ahead filter */
+        const std::string &filter = mCombo->mFilter;
+        nvgFillColor(ctx, filter.empty() ? mTheme->mDisabledTextColor
+                                         : mTheme->mTextColor);
+        nvgText(ctx, mPos.x() + 6, mPos.y() + rh * 0.5f,
+                filter.empty() ? "Type to filter" : filter.c_str(), nullptr);
+
+        nvgBeginPath(ctx);
+        nvgMoveTo(ctx, mPos.x(), mPos.y() + hh - 2.5f);
+        nvgLineTo(ctx, mPos.x() + mSize.x(), mPos.y() + hh - 2.5f);
+        nvgStrokeWidth(ctx, 1.0f);
+        nvgStrokeColor(ctx, mTheme->mBorderDark);
+        nvgStroke(ctx);
+
+        /* Visible rows only */
+        PrimitiveBatch::save(ctx);
+        PrimitiveBatch::intersectScissor(ctx, mPos.x(), mPos.y() + hh, textWidth, mSize.y() - hh);
+        int first = (int) mScroll, last = std::min(count, first + rows + 1);
+        for (int row = first; row < last; ++row) {
+            int index = mCombo->filteredItem(row);
+            float y = mPos.y() + hh + (row - first) * rh;
+
+            if (row == mHover || row == mHighlight || index == mCombo->mSelectedIndex) {
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, mPos.x() + 1, y + 1, textWidth - 2, rh - 2,
+                               mTheme->mButtonCornerRadius);
+                nvgFillColor(ctx, index == mCombo->mSelectedIndex
+                                      ? mTheme->mButtonGradientBotPushed
+                                      : mTheme->mButtonGradientTopFocused);
+                nvgFill(ctx);
+            }
+
+            nvgFillColor(ctx, mTheme->mTextColor);
+            nvgText(ctx, mPos.x() + 6, y + rh * 0.5f,
+                    mCombo->mItems[index].c_str(), nullptr);
+        }
+        PrimitiveBatch::restore(ctx);
+
+        if (!scrollbar)
+            return;
+
+        float trackHeight = mSize.y() - hh - 8;
+        float thumbHeight = std::max(16.0f, trackHeight * rows / (float) count);
+        float thumbPos = (trackHeight - thumbHeight) * mScroll / (float) (count - rows);
+
+        NVGpaint paint = nvgBoxGradient(
+            ctx, mPos.x() + mSize.x() - 12 + 1, mPos.y() + hh + 4 + 1, 8,
+            trackHeight, 3, 4, Color(0, 32), Color(0, 92));
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, mPos.x() + mSize.x() - 12, mPos.y() + hh + 4, 8,
+                       trackHeight, 3);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+
+        paint = nvgBoxGradient(
+            ctx, mPos.x() + mSize.x() - 12 - 1, mPos.y() + hh + 4 + thumbPos - 1,
+            8, thumbHeight, 3, 4, Color(220, 100), Color(128, 100));
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, mPos.x() + mSize.x() - 12 + 1,
+                       mPos.y() + hh + 4 + 1 + thumbPos, 8 - 2, thumbHeight - 2, 2);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
+
+    virtual bool mouseButtonEvent(const Vector2i &p, int button, bool down,
+                                  int modifiers) override {
+        Widget::mouseButtonEvent(p, button, down, modifiers);
+        if (button != GLFW_MOUSE_BUTTON_1)
+            return false;
+
+        if (!down) {
+            mDragScrollbar = false;
+            return true;
+        }
+
+        if (mCombo->filteredCount() > rowCount() && p.x() - mPos.x() >= mSize.x() - 12) {
+            mDragScrollbar = true;
+            return true;
+        }
+
+        int row = rowAt(p);
+        if (row >= 0)
+            mCombo->selectItem(mCombo->filteredItem(row));
+        return true;
+    }
+
+    virtual bool mouseDragEvent(const Vector2i &, const Vector2i &rel, int,
+                                int) override {
+        if (!mDragScrollbar)
+            return false;
+        int count = mCombo->filteredCount(), rows = rowCount();
+        float trackHeight = mSize.y() - headerHeight() - 8;
+        float thumbHeight = std::max(16.0f, trackHeight * rows / (float) count);
+        if (trackHeight > thumbHeight) {
+            mScroll += rel.y() * (count - rows) / (trackHeight - thumbHeight);
+            clampScroll();
+            markDirty();
+        }
+        return true;
+    }
+
+    virtual bool mouseMotionEvent(const Vector2i &p, const Vector2i &, int,
+                                  int) override {
+        int row = rowAt(p);
+        if (row != mHover) {
+            mHover = row;
+            markDirty();
+        }
+        return true;
+    }
+
+    virtual bool mouseEnterEvent(const Vector2i &p, bool enter) override {
+        Widget::mouseEnterEvent(p, enter);
+        if (!enter && mHover != -1) {
+            mHover = -1;
+            markDirty();
+        }
+        return true;
+    }
+
+    virtual bool scrollEvent(const Vector2i &p, const Vector2f &rel) override {
+        mScroll = (float) (int) (mScroll - rel.y() * 3);
+        clampScroll();
+        mHover = rowAt(p);
+        markDirty();
+        return true;
+    }
+
+    virtual bool keyboardEvent(int key, int, int action, int) override {
+        if (action != GLFW_PRESS && action != GLFW_REPEAT)
+            return false;
+
+        int count = mCombo->filteredCount(), rows = rowCount();
+        switch (key) {
+            case GLFW_KEY_UP:        moveHighlight(mHighlight - 1); break;
+            case GLFW_KEY_DOWN:      moveHighlight(mHighlight + 1); break;
+            case GLFW_KEY_PAGE_UP:   moveHighlight(mHighlight - rows); break;
+            case GLFW_KEY_PAGE_DOWN: moveHighlight(mHighlight + rows); break;
+            case GLFW_KEY_HOME:      moveHighlight(0); break;
+            case GLFW_KEY_END:       moveHighlight(count - 1); break;
+
+            case GLFW_KEY_ENTER:
+            case GLFW_KEY_KP_ENTER:
+                if (mHighlight >= 0 && mHighlight < count)
+                    mCombo->selectItem(mCombo->filteredItem(mHighlight));
+                break;
+
+            case GLFW_KEY_BACKSPACE: {
+                    /* Remove the last UTF-8 encoded character */
+                    std::string filter = mCombo->mFilter;
+                    while (!filter.empty() && (filter.back() & 0xC0) == 0x80)
+                        filter.pop_back();
+                    if (!filter.empty())
+                        filter.pop_back();
+                    mCombo->setFilter(filter);
+                }
+                break;
+
+            case GLFW_KEY_ESCAPE:
+                if (!mCombo->mFilter.empty()) {
+                    mCombo->setFilter("");
+                } else {
+                    mCombo->setPushed(false);
+                    mCombo->popup()->setVisible(false);
+                }
+                break;
+
+            default:
+                return false;
+        }
+        return true;
+    }
+
+    virtual bool keyboardCharacterEvent(unsigned int codepoint) override {
+        mCombo->setFilter(mCombo->mFilter + utf8((int) codepoint).data());
+        return true;
+    }
+
+protected:
+    int rowHeight() const { return fontSize() + 6; }
+    int headerHeight() const { return rowHeight() + 4; }
+    int rowCount() const { return std::max(1, (mSize.y() - headerHeight()) / rowHeight()); }
+
+    /// Return the row below the given position (in parent coordinates), or -1
+    int rowAt(const Vector2i &p) const {
+        int y = p.y() - mPos.y() - headerHeight();
+        if (y < 0 || p.x() - mPos.x() >= mSize.x() - (mCombo->filteredCount() > rowCount() ? 12 : 0))
+            return -1;
+        int row = (int) mScroll + y / rowHeight();
+        return row < mCombo->filteredCount() ? row : -1;
+    }
+
+    void clampScroll() {
+        int maxScroll = std::max(0, mCombo->filteredCount() - rowCount());
+        mScroll = std::max(0.f, std::min((float) maxScroll, mScroll));
+    }
+
+    void moveHighlight(int row) {
+        int count = mCombo->filteredCount(), rows = rowCount();
+        mHighlight = std::max(0, std::min(count - 1, row));
+        if (mHighlight < (int) mScroll)
+            mScroll = (float) mHighlight;
+        else if (mHighlight >= (int) mScroll + rows)
+            mScroll = (float) (mHighlight - rows + 1);
+        clampScroll();
+        markDirty();
+    }
+
+protected:
+    ComboBox *mCombo;
+    float mScroll;
+    int mHover, mHighlight;
+    bool mDragScrollbar;
+};
+
+ComboBox::ComboBox(Widget *parent)
+    : PopupButton(parent), mSelectedIndex(0), mList(nullptr), mVisibleRows(12),
+      mFilterActive(false) {
 }
 
 ComboBox::ComboBox(Widget *parent, const std::vector<std::string> &items)
-    : PopupButton(parent), mSelectedIndex(0) {
+    : PopupButton(parent), mSelectedIndex(0), mList(nullptr), mVisibleRows(12),
+      mFilterActive(false) {
     setItems(items);
 }
 
 ComboBox::ComboBox(Widget *parent, const std::vector<std::string> &items, const std::vector<std::string> &itemsShort)
-    : PopupButton(parent), mSelectedIndex(0) {
+    : PopupButton(parent), mSelectedIndex(0), mList(nullptr), mVisibleRows(12),
+      mFilterActive(false) {
     setItems(items, itemsShort);
 }
 
 void ComboBox::setSelectedIndex(int idx) {
     if (mItemsShort.empty())
         return;
-    const std::vector<Widget *> &children = popup()->children();
-    ((Button *) children[mSelectedIndex])->setPushed(false);
-    ((Button *) children[idx])->setPushed(true);
+    if (!mList) {
+        const std::vector<Widget *> &children = popup()->children();
+        ((Button *) children[mSelectedIndex])->setPushed(false);
+        ((Button *) children[idx])->setPushed(true);
+    }
     mSelectedIndex = idx;
     setCaption(mItemsShort[idx]);
 }
@@ -45,11 +349,65 @@ void ComboBox::setItems(const std::vector<std::string> &items, const std::vector
     mItemsShort = itemsShort;
     if (mSelectedIndex < 0 || mSelectedIndex >= (int) items.size())
         mSelectedIndex = 0;
+    rebuildPopup(mList != nullptr);
+    setSelectedIndex(mSelectedIndex);
+}
+
+void ComboBox::setVirtualized(bool virtualized) {
+    if (virtualized == (mList != nullptr))
+        return;
+    rebuildPopup(virtualized);
+    setSelectedIndex(mSelectedIndex);
+}
+
+void ComboBox::setVisibleRows(int visibleRows) {
+    mVisibleRows = std::max(1, visibleRows);
+}
+
+void ComboBox::setFilter(const std::string &filter) {
+    mFilter = filter;
+    updateFilter();
+    if (mList)
+        mList->reset();
+}
+
+void ComboBox::rebuildPopup(bool virtualized) {
+    mList = nullptr;
     while (mPopup->childCount() != 0)
         mPopup->removeChild(mPopup->childCount()-1);
     mPopup->setLayout(new GroupLayout(10));
+    mFilter.clear();
+    mFiltered.clear();
+    mFilterActive = false;
+
+    /* Abandon the index of the previous items without waiting for it */
+    if (mIndex)
+        mIndex->cancelled = true;
+    mIndex = nullptr;
+
+    if (virtualized) {
+        /* Sort a lower-case copy of the labels on a worker thread */
+        auto slot = std::make_shared<IndexSlot>();
+        std::thread([slot](std::vector<std::string> labels) {
+            auto index = std::make_shared<PrefixIndex>();
+            index->entries.reserve(labels.size());
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (slot->cancelled)
+                    return;
+                index->entries.emplace_back(toLower(std::move(labels[i])), (int) i);
+            }
+            std::sort(index->entries.begin(), index->entries.end());
+
+            std::lock_guard<std::mutex> guard(slot->mutex);
+            slot->index = std::move(index);
+        }, mItems).detach();
+        mIndex = slot;
+        mList = new ItemList(mPopup, this);
+        return;
+    }
+
     int index = 0;
-    for (const auto &str: items) {
+    for (const auto &str: mItems) {
         Button *button = new Button(mPopup, str);
         button->setFlags(Button::RadioButton);
         button->setCallback([&, index] {
@@ -62,7 +420,65 @@ void ComboBox::setItems(const std::vector<std::string> &items, const std::vector
         });
         index++;
     }
-    setSelectedIndex(mSelectedIndex);
+}
+
+void ComboBox::updateFilter() {
+    mFiltered.clear();
+    mFilterActive = !mFilter.empty();
+    if (!mFilterActive)
+        return;
+
+    std::shared_ptr<const PrefixIndex> index;
+    if (mIndex) {
+        std::lock_guard<std::mutex> guard(mIndex->mutex);
+        index = mIndex->index;
+    }
+
+    std::string prefix = toLower(mFilter);
+    if (index) {
+        /* All matches are adjacent in the sorted index */
+        const auto &entries = index->entries;
+        auto it = std::lower_bound(
+            entries.begin(), entries.end(), prefix,
+            [](const std::pair<std::string, int> &entry, const std::string &value) {
+                return entry.first < value;
+            });
+        for (; it != entries.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+            mFiltered.push_back(it->second);
+        std::sort(mFiltered.begin(), mFiltered.end());
+    } else {
+        /* The index is still being built */
+        for (int i = 0; i < (int) mItems.size(); ++i) {
+            if (mItems[i].size() >= prefix.size() &&
+                toLower(mItems[i].substr(0, prefix.size())) == prefix)
+                mFiltered.push_back(i);
+        }
+    }
+}
+
+int ComboBox::filteredCount() const {
+    return mFilterActive ? (int) mFiltered.size() : (int) mItems.size();
+}
+
+void ComboBox::selectItem(int index) {
+    mSelectedIndex = index;
+    setCaption(mItemsShort[index]);
+    setPushed(false);
+    popup()->setVisible(false);
+    if (!mFilter.empty()) {
+        mFilter.clear();
+        updateFilter();
+    }
+    if (mCallback)
+        mCallback(index);
+}
+
+bool ComboBox::mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) {
+    bool pushed = mPushed;
+    bool result = PopupButton::mouseButtonEvent(p, button, down, modifiers);
+    if (mList && mPushed && !pushed)
+        mList->reset();
+    return result;
 }
 
 bool ComboBox::scrollEvent(const Vector2i &p, const Vector2f &rel) {
@@ -80,6 +496,18 @@ bool ComboBox::scrollEvent(const Vector2i &p, const Vector2f &rel) {
     return Widget::scrollEvent(p, rel);
 }
 
+bool ComboBox::keyboardEvent(int key, int scancode, int action, int modifiers) {
+    if (mList && mPushed)
+        return mList->keyboardEvent(key, scancode, action, modifiers);
+    return PopupButton::keyboardEvent(key, scancode, action, modifiers);
+}
+
+bool ComboBox::keyboardCharacterEvent(unsigned int codepoint) {
+    if (mList && mPushed)
+        return mList->keyboardCharacterEvent(codepoint);
+    return PopupButton::keyboardCharacterEvent(codepoint);
+}
+
 void ComboBox::save(Serializer &s) const {
     Widget::save(s);
     s.set("items", mItems);
@@ -86,27 +86,12 @@ void mainloop(int refresh) {
 
     try {
         while (mainloop_active) {
-            int numScreens = 0;
-            for (auto kv : __nanogui_screens) {
-                Screen *screen = kv.second;
-                if (!screen->visible()) {
-                    continue;
-                } else if (glfwWindowShouldClose(screen->glfwWindow())) {
-                    screen->setVisible(false);
-                    continue;
-                }
-                screen->drawAll();
-                numScreens++;
-            }
-
-            if (numScreens == 0) {
-                /* Give up if there was nothing to draw */
+            /* Draw, then wait for mouse/keyboard or empty refresh events.
+               Give up if there was nothing to draw */
+            if (!mainloop_iteration(-1)) {
                 mainloop_active = false;
                 break;
             }
-
-            /* Wait for mouse/keyboard or empty refresh events */
-            glfwWaitEvents();
         }
 
         /* Process events once more */
@@ -120,6 +105,44 @@ void mainloop(int refresh) {
         refresh_thread.join();
 }
 
+bool mainloop_iteration(double timeout, bool draw) {
+    int numScreens = 0;
+    for (auto kv : __nanogui_screens) {
+        Screen *screen = kv.second;
+        if (!screen->visible()) {
+            continue;
+        } else if (glfwWindowShouldClose(screen->glfwWindow())) {
+            screen->setVisible(false);
+            continue;
+        }
+        if (draw)
+            screen->drawAll();
+        numScreens++;
+    }
+
+    if (numScreens == 0)
+        return false;
+
+    if (timeout < 0)
+        glfwWaitEvents();
+    else if (timeout > 0)
+        glfwWaitEventsTimeout(timeout);
+    else
+        glfwPollEvents();
+
+    return true;
+}
+
+double last_interaction() {
+    double result = 0;
+    for (auto kv : __nanogui_screens) {
+        Screen *screen = kv.second;
+        if (screen->visible())
+            result = std::max(result, screen->lastInteraction());
+    }
+    return result;
+}
+
 void leave() {
     mainloop_active = false;
 }
@@ -16,17 +16,29 @@
 #include <nanogui/screen.h>
 #include <nanogui/glcanvas.h>
 #include <nanogui/theme.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
 #include <nanogui/serializer/core.h>
+#include <iostream>
 
 NAMESPACE_BEGIN(nanogui)
 
 GLCanvas::GLCanvas(Widget *parent)
   : Widget(parent), mBackgroundColor(Vector4i(128, 128, 128, 255)),
-    mDrawBorder(true) {
+    mDrawBorder(true), mCacheScene(false), mSceneDirty(true), mPixelRatio(0.f),
+    mThreaded(false), mThreadWindow(nullptr), mDisplaySlot(-1), mReadySlot(-1),
+    mSamples(0), mThreadStop(false), mFrameRequested(false),
+    mThreadSize(Vector2i::Zero()), mLastRenderTime(0.0), mLastCompositeTime(0.0) {
     mSize = Vector2i(250, 250);
 }
 
+void GLCanvas::drawChildren(NVGcontext *ctx) {
+    /* The canvas image is NanoVG content, which would cover the primitives */
+    PrimitiveBatch *batch = PrimitiveBatch::suspend(ctx);
+    Widget::draw(ctx);
+    PrimitiveBatch::resume(batch);
+}
+
 void GLCanvas::drawWidgetBorder(NVGcontext *ctx) const {
     nvgBeginPath(ctx);
     nvgStrokeWidth(ctx, 1.0f);
@@ -39,41 +51,317 @@ void GLCanvas::drawWidgetBorder(NVGcontext *ctx) const {
     nvgStroke(ctx);
 }
 
-void GLCanvas::draw(NVGcontext *ctx) {
-    Widget::draw(ctx);
-    nvgEndFrame(ctx);
-
-    if (mDrawBorder)
-        drawWidgetBorder(ctx);
+GLCanvas::~GLCanvas() {
+    /* By now, a subclass that is still being rendered on the thread is gone */
+    assert(!mThread.joinable() &&
+           "GLCanvas: call setThreaded(false) before the canvas is destroyed!");
+    if (mThread.joinable()) {
+        std::cerr << "GLCanvas: call setThreaded(false) before the canvas is destroyed!" << std::endl;
+        stopThread();
+    }
+    mRenderTarget.free();
+}
 
-    const Screen* screen = this->screen();
+void GLCanvas::draw(NVGcontext *ctx) {
+    Screen *screen = this->screen();
     assert(screen);
 
     float pixelRatio = screen->pixelRatio();
-    Vector2f screenSize = screen->size().cast<float>();
-    Vector2i positionInScreen = absolutePosition();
+    Vector2i size = (mSize.cast<float>() * pixelRatio).cast<int>();
+
+    if (size.x() > 0 && size.y() > 0) {
+        if (pixelRatio != mPixelRatio) {
+            mPixelRatio = pixelRatio;
+            mSceneDirty = true;
+        }
+
+        if (mThreaded) {
+            drawThreaded(ctx, size);
+            drawChildren(ctx);
+            if (mDrawBorder)
+                drawWidgetBorder(ctx);
+            return;
+        }
+
+        if (!mRenderTarget.ready() || mRenderTarget.size() != size) {
+            GLint samples = 0;
+            glGetIntegerv(GL_SAMPLES, &samples);
+            mRenderTarget.free();
+            mRenderTarget.init(size, samples);
 
-    Vector2i size = (mSize.cast<float>() * pixelRatio).cast<int>(),
-             imagePosition = (Vector2f(positionInScreen[0],
-                                       screenSize[1] - positionInScreen[1] -
-                                       (float) mSize[1]) * pixelRatio).cast<int>();
+            /* The canvas is opaque, just like when it was drawn into the back buffer */
+            mRenderTarget.texture().bind();
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ONE);
+            mRenderTarget.texture().release();
+            mSceneDirty = true;
+        }
 
-    GLint storedViewport[4];
-    glGetIntegerv(GL_VIEWPORT, storedViewport);
+        if (mSceneDirty || !mCacheScene) {
+            ref<GLCanvas> self = this;
+            screen->deferGL([self]() mutable { self->drawOffscreen(); });
+            mSceneDirty = false;
+        }
 
-    glViewport(imagePosition[0], imagePosition[1], size[0] , size[1]);
+        int image = screen->textureImage(mRenderTarget.texture().texture(), size,
+                                         NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+        NVGpaint paint = nvgImagePattern(ctx, mPos.x(), mPos.y(), mSize.x(),
+                                         mSize.y(), 0.0f, image, 1.0f);
+        nvgBeginPath(ctx);
+        nvgRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
 
-    glEnable(GL_SCISSOR_TEST);
-    glScissor(imagePosition[0], imagePosition[1], size[0], size[1]);
+    drawChildren(ctx);
+
+    if (mDrawBorder)
+        drawWidgetBorder(ctx);
+}
+
+void GLCanvas::drawOffscreen() {
+    mRenderTarget.bind();
     glClearColor(mBackgroundColor[0], mBackgroundColor[1],
                  mBackgroundColor[2], mBackgroundColor[3]);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
     this->drawGL();
 
-    glDisable(GL_SCISSOR_TEST);
-    glViewport(storedViewport[0], storedViewport[1],
-               storedViewport[2], storedViewport[3]);
+    mRenderTarget.release();
+}
+
+void GLCanvas::setThreaded(bool threaded, int bufferCount) {
+    if (bufferCount < 2 || bufferCount > 3)
+        throw std::runtime_error("GLCanvas::setThreaded(): bufferCount must be 2 or 3!");
+    if (threaded == mThreaded && (!threaded || (int) mSlots.size() == bufferCount))
+        return;
+    stopThread();
+    mThreaded = threaded;
+    mSlots.clear();
+    if (threaded) {
+        for (int i = 0; i < bufferCount; ++i)
+            mSlots.emplace_back(new Slot());
+    }
+    mSceneDirty = true;
+}
+
+GLCanvas::FrameStats GLCanvas::renderStats() const {
+    std::lock_guard<std::mutex> guard(mThreadMutex);
+    return mRenderStats;
+}
+
+GLCanvas::FrameStats GLCanvas::compositeStats() const {
+    std::lock_guard<std::mutex> guard(mThreadMutex);
+    return mCompositeStats;
+}
+
+void GLCanvas::updateStats(double &average, double sample, uint64_t count) {
+    const double weight = 0.1;
+    average = count <= 1 ? sample : (1.0 - weight) * average + weight * sample;
+}
+
+void GLCanvas::startThread() {
+    GLFWwindow *window = screen()->glfwWindow();
+
+    /* Create a hidden window whose context shares objects with the screen */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR,
+                   glfwGetWindowAttrib(window, GLFW_CONTEXT_VERSION_MAJOR));
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR,
+                   glfwGetWindowAttrib(window, GLFW_CONTEXT_VERSION_MINOR));
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT,
+                   glfwGetWindowAttrib(window, GLFW_OPENGL_FORWARD_COMPAT));
+    glfwWindowHint(GLFW_OPENGL_PROFILE,
+                   glfwGetWindowAttrib(window, GLFW_OPENGL_PROFILE));
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+    mThreadWindow = glfwCreateWindow(1, 1, "", nullptr, window);
+    glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+    if (!mThreadWindow)
+        throw std::runtime_error("GLCanvas: could not create a shared OpenGL context!");
+
+    GLint samples = 0;
+    glGetIntegerv(GL_SAMPLES, &samples);
+    mSamples = samples;
+    mDisplaySlot = mReadySlot = -1;
+    mThreadStop = false;
+    mFrameRequested = false;
+    mRenderStats = mCompositeStats = FrameStats();
+    mLastRenderTime = mLastCompositeTime = 0.0;
+    mThread = std::thread([this]() { renderThread(); });
+}
+
+void GLCanvas::stopThread() {
+    if (!mThread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> guard(mThreadMutex);
+        mThreadStop = true;
+    }
+    mThreadCond.notify_all();
+    mThread.join();
+
+    /* The render thread released its context: borrow it on this thread to
+       release the objects created there (vertex arrays and framebuffers are
+       not shared with the screen's context) */
+    GLFWwindow *current = glfwGetCurrentContext();
+    glfwMakeContextCurrent(mThreadWindow);
+    freeGL();
+    for (auto &slot : mSlots) {
+        if (slot->ready)
+            glDeleteSync(slot->ready);
+        if (slot->released)
+            glDeleteSync(slot->released);
+        slot->ready = slot->released = nullptr;
+        slot->target.free();
+    }
+    mDisplaySlot = mReadySlot = -1;
+    glfwMakeContextCurrent(current);
+
+    glfwDestroyWindow(mThreadWindow);
+    mThreadWindow = nullptr;
+}
+
+void GLCanvas::drawThreaded(NVGcontext *ctx, const Vector2i &size) {
+    if (!mThread.joinable())
+        startThread();
+
+    GLsync ready = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(mThreadMutex);
+        if (mReadySlot >= 0) {
+            if (mDisplaySlot >= 0) {
+                /* Commands sampling the previous frame were submitted by the last nvgEndFrame() */
+                mSlots[mDisplaySlot]->released = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                glFlush();
+            }
+            mDisplaySlot = mReadySlot;
+            mReadySlot = -1;
+            ready = mSlots[mDisplaySlot]->ready;
+            mSlots[mDisplaySlot]->ready = nullptr;
+        }
+
+        if (size != mThreadSize) {
+            mThreadSize = size;
+            mSceneDirty = true;
+        }
+        if (mSceneDirty || !mCacheScene) {
+            mFrameRequested = true;
+            mSceneDirty = false;
+        }
+
+        double now = glfwGetTime();
+        mCompositeStats.frames++;
+        if (mLastCompositeTime > 0.0)
+            updateStats(mCompositeStats.frameTime, now - mLastCompositeTime,
+                        mCompositeStats.frames - 1);
+        mLastCompositeTime = now;
+    }
+    mThreadCond.notify_all();
+
+    if (ready) {
+        double start = glfwGetTime();
+        glWaitSync(ready, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(ready);
+        std::lock_guard<std::mutex> guard(mThreadMutex);
+        updateStats(mCompositeStats.workTime, glfwGetTime() - start, mCompositeStats.frames);
+    }
+
+    nvgBeginPath(ctx);
+    nvgRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    if (mDisplaySlot >= 0) {
+        GLRenderTarget &target = mSlots[mDisplaySlot]->target;
+        int image = screen()->textureImage(target.texture().texture(), target.size(),
+                                           NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+        nvgFillPaint(ctx, nvgImagePattern(ctx, mPos.x(), mPos.y(), mSize.x(),
+                                          mSize.y(), 0.0f, image, 1.0f));
+    } else {
+        /* No frame has been completed yet */
+        Color background = mBackgroundColor;
+        background.w() = 1.0f;
+        nvgFillColor(ctx, background);
+    }
+    nvgFill(ctx);
+}
+
+void GLCanvas::renderThread() {
+    glfwMakeContextCurrent(mThreadWindow);
+
+    while (true) {
+        int index = -1;
+        Vector2i size;
+        Color background;
+        GLsync released = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mThreadMutex);
+            mThreadCond.wait(lock, [&]() {
+                if (mThreadStop)
+                    return true;
+                if (!mFrameRequested)
+                    return false;
+                for (int i = 0; i < (int) mSlots.size(); ++i) {
+                    if (i != mDisplaySlot && i != mReadySlot) {
+                        index = i;
+                        return true;
+                    }
+                }
+                return false;
+            });
+            if (mThreadStop)
+                break;
+            mFrameRequested = false;
+            size = mThreadSize;
+            background = mBackgroundColor;
+            released = mSlots[index]->released;
+            mSlots[index]->released = nullptr;
+        }
+
+        if (released) {
+            glWaitSync(released, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(released);
+        }
+
+        GLRenderTarget &target = mSlots[index]->target;
+        if (!target.ready() || target.size() != size) {
+            target.free();
+            target.init(size, mSamples);
+            target.texture().bind();
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ONE);
+            target.texture().release();
+        }
+
+        double start = glfwGetTime();
+        target.bind();
+        glClearColor(background[0], background[1], background[2], background[3]);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        this->drawGL();
+        target.release();
+        GLsync ready = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+        double now = glfwGetTime();
+
+        {
+            std::lock_guard<std::mutex> guard(mThreadMutex);
+            if (mReadySlot >= 0) {
+                /* The UI did not pick up the previous frame: replace it */
+                glDeleteSync(mSlots[mReadySlot]->ready);
+                mSlots[mReadySlot]->ready = nullptr;
+                mRenderStats.dropped++;
+            }
+            mSlots[index]->ready = ready;
+            mReadySlot = index;
+
+            mRenderStats.frames++;
+            updateStats(mRenderStats.workTime, now - start, mRenderStats.frames);
+            if (mLastRenderTime > 0.0)
+                updateStats(mRenderStats.frameTime, now - mLastRenderTime,
+                            mRenderStats.frames - 1);
+            mLastRenderTime = now;
+        }
+
+        /* Wake up the main loop so that the new frame gets composited */
+        glfwPostEmptyEvent();
+    }
+
+    /* Resources are released by stopThread() */
+    glfwMakeContextCurrent(nullptr);
 }
 
 void GLCanvas::save(Serializer &s) const {
@@ -86,6 +374,7 @@ bool GLCanvas::load(Serializer &s) {
     if (!Widget::load(s)) return false;
     if (!s.get("backgroundColor", mBackgroundColor)) return false;
     if (!s.get("drawBorder", mDrawBorder)) return false;
+    mSceneDirty = true;
     return true;
 }
 
@@ -143,13 +143,17 @@ GLint GLShader::attrib(const std::string &name, bool warn) const {
 }
 
 void GLShader::setUniform(const std::string &name, const GLUniformBuffer &buf, bool warn) {
+    setUniformBlockBinding(name, buf.getBindingPoint(), warn);
+}
+
+void GLShader::setUniformBlockBinding(const std::string &name, int bindingPoint, bool warn) {
     GLuint blockIndex = glGetUniformBlockIndex(mProgramShader, name.c_str());
     if (blockIndex == GL_INVALID_INDEX) {
         if (warn)
             std::cerr << mName << ": warning: did not find uniform buffer " << name << std::endl;
         return;
     }
-    glUniformBlockBinding(mProgramShader, blockIndex, buf.getBindingPoint());
+    glUniformBlockBinding(mProgramShader, blockIndex, (GLuint) bindingPoint);
 }
 
 GLint GLShader::uniform(const std::string &name, bool warn) const {
@@ -314,16 +318,404 @@ void GLUniformBuffer::release() {
 void GLUniformBuffer::free() {
     glDeleteBuffers(1, &mID);
     mID = 0;
+    mSize = 0;
 }
 
-void GLUniformBuffer::update(const std::vector<uint8_t> &data) {
+void GLUniformBuffer::update(const void *data, size_t size) {
     glBindBuffer(GL_UNIFORM_BUFFER, mID);
-    glBufferData(GL_UNIFORM_BUFFER, data.size(), data.data(), GL_DYNAMIC_DRAW);
+    if (size != mSize) {
+        glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+        mSize = size;
+    } else {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    }
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
 //  ----------------------------------------------------
 
+void GLUniformRing::init(size_t capacity) {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    mAlignment = (size_t) std::max(alignment, 1);
+    mCapacity = capacity / mAlignment * mAlignment;
+    mHead = mAllocated = mReleased = 0;
+
+    glGenBuffers(1, &mID);
+    glBindBuffer(GL_UNIFORM_BUFFER, mID);
+    glBufferData(GL_UNIFORM_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void GLUniformRing::free() {
+    for (auto &fence : mFences)
+        glDeleteSync(fence.first);
+    mFences.clear();
+    glDeleteBuffers(1, &mID);
+    mID = 0;
+    mCapacity = mHead = mAllocated = mReleased = 0;
+}
+
+bool GLUniformRing::retire(bool wait) {
+    if (mFences.empty())
+        return false;
+    GLenum result = glClientWaitSync(mFences.front().first, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     wait ? GL_TIMEOUT_IGNORED : 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+        return false;
+    glDeleteSync(mFences.front().first);
+    mReleased = mFences.front().second;
+    mFences.erase(mFences.begin());
+
+    /* Start over at the beginning once the ring is drained, since blocks never
+       wrap and a large block might otherwise not fit at the current head */
+    if (mAllocated == mReleased)
+        mHead = mAllocated = mReleased = 0;
+    return true;
+}
+
+uint8_t *GLUniformRing::map(size_t size, Range &range) {
+    if (mMapped)
+        throw std::runtime_error("GLUniformRing::map(): previous block is still mapped!");
+    size_t alignedSize = (size + mAlignment - 1) / mAlignment * mAlignment;
+    if (alignedSize > mCapacity)
+        throw std::runtime_error("GLUniformRing::map(): block does not fit into the ring!");
+
+    while (retire(false))
+        ;
+
+    while (true) {
+        /* Blocks never straddle the end of the ring: skip the tail if needed */
+        size_t skip = mHead + alignedSize > mCapacity ? mCapacity - mHead : 0;
+        if (mCapacity - (mAllocated - mReleased) >= skip + alignedSize) {
+            mAllocated += skip;
+            if (skip)
+                mHead = 0;
+            break;
+        }
+        /* An empty ring starts at offset zero, so waiting would not help */
+        if (mAllocated == mReleased)
+            throw std::runtime_error("GLUniformRing::map(): block does not fit into the ring!");
+        /* Everything in use belongs to the current frame: fence it off */
+        if (mFences.empty())
+            fence();
+        retire(true);
+    }
+
+    range.offset = mHead;
+    range.size = size;
+    mHead = (mHead + alignedSize) % mCapacity;
+    mAllocated += alignedSize;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mID);
+    uint8_t *ptr = (uint8_t *) glMapBufferRange(
+        GL_UNIFORM_BUFFER, range.offset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (!ptr)
+        throw std::runtime_error("GLUniformRing::map(): glMapBufferRange() failed!");
+    mMapped = true;
+    return ptr;
+}
+
+void GLUniformRing::unmap() {
+    if (!mMapped)
+        return;
+    glBindBuffer(GL_UNIFORM_BUFFER, mID);
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    mMapped = false;
+}
+
+GLUniformRing::Range GLUniformRing::upload(const void *data, size_t size) {
+    Range range;
+    memcpy(map(size, range), data, size);
+    unmap();
+    return range;
+}
+
+void GLUniformRing::bind(int bindingPoint, const Range &range) {
+    glBindBufferRange(GL_UNIFORM_BUFFER, (GLuint) bindingPoint, mID,
+                      (GLintptr) range.offset, (GLsizeiptr) range.size);
+}
+
+void GLUniformRing::fence() {
+    if (!mFences.empty() && mFences.back().second == mAllocated)
+        return;
+    mFences.push_back(std::make_pair(
+        glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), mAllocated));
+}
+
+//  ----------------------------------------------------
+
+#if defined(_WIN32)
+#  define NANOGUI_GLAPIENTRY __stdcall
+#else
+#  define NANOGUI_GLAPIENTRY
+#endif
+
+typedef void (NANOGUI_GLAPIENTRY *PFNNANOGUITEXSTORAGE2D)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+
+struct TextureFormat {
+    GLenum internalFormat, format, type;
+    int channels, componentSize;
+};
+
+static const TextureFormat textureFormats[] = {
+    { GL_R8,             GL_RED,          GL_UNSIGNED_BYTE,  1, 1 },
+    { GL_RG8,            GL_RG,           GL_UNSIGNED_BYTE,  2, 1 },
+    { GL_RGB8,           GL_RGB,          GL_UNSIGNED_BYTE,  3, 1 },
+    { GL_RGBA8,          GL_RGBA,         GL_UNSIGNED_BYTE,  4, 1 },
+    { GL_SRGB8,          GL_RGB,          GL_UNSIGNED_BYTE,  3, 1 },
+    { GL_SRGB8_ALPHA8,   GL_RGBA,         GL_UNSIGNED_BYTE,  4, 1 },
+    { GL_R8_SNORM,       GL_RED,          GL_BYTE,           1, 1 },
+    { GL_RG8_SNORM,      GL_RG,           GL_BYTE,           2, 1 },
+    { GL_RGB8_SNORM,     GL_RGB,          GL_BYTE,           3, 1 },
+    { GL_RGBA8_SNORM,    GL_RGBA,         GL_BYTE,           4, 1 },
+    { GL_R16,            GL_RED,          GL_UNSIGNED_SHORT, 1, 2 },
+    { GL_RG16,           GL_RG,           GL_UNSIGNED_SHORT, 2, 2 },
+    { GL_RGB16,          GL_RGB,          GL_UNSIGNED_SHORT, 3, 2 },
+    { GL_RGBA16,         GL_RGBA,         GL_UNSIGNED_SHORT, 4, 2 },
+    { GL_R16_SNORM,      GL_RED,          GL_SHORT,          1, 2 },
+    { GL_RG16_SNORM,     GL_RG,           GL_SHORT,          2, 2 },
+    { GL_RGB16_SNORM,    GL_RGB,          GL_SHORT,          3, 2 },
+    { GL_RGBA16_SNORM,   GL_RGBA,         GL_SHORT,          4, 2 },
+    { GL_R16F,           GL_RED,          GL_HALF_FLOAT,     1, 2 },
+    { GL_RG16F,          GL_RG,           GL_HALF_FLOAT,     2, 2 },
+    { GL_RGB16F,         GL_RGB,          GL_HALF_FLOAT,     3, 2 },
+    { GL_RGBA16F,        GL_RGBA,         GL_HALF_FLOAT,     4, 2 },
+    { GL_R32F,           GL_RED,          GL_FLOAT,          1, 4 },
+    { GL_RG32F,          GL_RG,           GL_FLOAT,          2, 4 },
+    { GL_RGB32F,         GL_RGB,          GL_FLOAT,          3, 4 },
+    { GL_RGBA32F,        GL_RGBA,         GL_FLOAT,          4, 4 },
+    { GL_R8UI,           GL_RED_INTEGER,  GL_UNSIGNED_BYTE,  1, 1 },
+    { GL_RG8UI,          GL_RG_INTEGER,   GL_UNSIGNED_BYTE,  2, 1 },
+    { GL_RGB8UI,         GL_RGB_INTEGER,  GL_UNSIGNED_BYTE,  3, 1 },
+    { GL_RGBA8UI,        GL_RGBA_INTEGER, GL_UNSIGNED_BYTE,  4, 1 },
+    { GL_R8I,            GL_RED_INTEGER,  GL_BYTE,           1, 1 },
+    { GL_RG8I,           GL_RG_INTEGER,   GL_BYTE,           2, 1 },
+    { GL_RGB8I,          GL_RGB_INTEGER,  GL_BYTE,           3, 1 },
+    { GL_RGBA8I,         GL_RGBA_INTEGER, GL_BYTE,           4, 1 },
+    { GL_R16UI,          GL_RED_INTEGER,  GL_UNSIGNED_SHORT, 1, 2 },
+    { GL_RG16UI,         GL_RG_INTEGER,   GL_UNSIGNED_SHORT, 2, 2 },
+    { GL_RGB16UI,        GL_RGB_INTEGER,  GL_UNSIGNED_SHORT, 3, 2 },
+    { GL_RGBA16UI,       GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, 4, 2 },
+    { GL_R16I,           GL_RED_INTEGER,  GL_SHORT,          1, 2 },
+    { GL_RG16I,          GL_RG_INTEGER,   GL_SHORT,          2, 2 },
+    { GL_RGB16I,         GL_RGB_INTEGER,  GL_SHORT,          3, 2 },
+    { GL_RGBA16I,        GL_RGBA_INTEGER, GL_SHORT,          4, 2 },
+    { GL_R32UI,          GL_RED_INTEGER,  GL_UNSIGNED_INT,   1, 4 },
+    { GL_RG32UI,         GL_RG_INTEGER,   GL_UNSIGNED_INT,   2, 4 },
+    { GL_RGB32UI,        GL_RGB_INTEGER,  GL_UNSIGNED_INT,   3, 4 },
+    { GL_RGBA32UI,       GL_RGBA_INTEGER, GL_UNSIGNED_INT,   4, 4 },
+    { GL_R32I,           GL_RED_INTEGER,  GL_INT,            1, 4 },
+    { GL_RG32I,          GL_RG_INTEGER,   GL_INT,            2, 4 },
+    { GL_RGB32I,         GL_RGB_INTEGER,  GL_INT,            3, 4 },
+    { GL_RGBA32I,        GL_RGBA_INTEGER, GL_INT,            4, 4 },
+    { GL_DEPTH_COMPONENT16,  GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, 1, 2 },
+    { GL_DEPTH_COMPONENT24,  GL_DEPTH_COMPONENT, GL_UNSIGNED_INT,   1, 4 },
+    { GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT,          1, 4 }
+};
+
+GLenum GLTexture::internalFormat(GLenum type, int channels, bool normalized) {
+    bool integer = type != GL_FLOAT && type != GL_HALF_FLOAT;
+    if (type == GL_INT || type == GL_UNSIGNED_INT)
+        normalized = false;
+    for (const TextureFormat &f : textureFormats) {
+        if (f.type != type || f.channels != channels)
+            continue;
+        bool isInteger = f.format == GL_RED_INTEGER || f.format == GL_RG_INTEGER ||
+                         f.format == GL_RGB_INTEGER || f.format == GL_RGBA_INTEGER;
+        bool isSRGB = f.internalFormat == GL_SRGB8 || f.internalFormat == GL_SRGB8_ALPHA8;
+        if (f.format == GL_DEPTH_COMPONENT || isSRGB)
+            continue;
+        if (!integer || isInteger != normalized)
+            return f.internalFormat;
+    }
+    throw std::runtime_error("GLTexture::internalFormat(): unsupported type/channel combination!");
+}
+
+void GLTexture::init(const Vector2i &size, GLenum internalFormat, int levels) {
+    const TextureFormat *fmt = nullptr;
+    for (const TextureFormat &f : textureFormats) {
+        if (f.internalFormat == internalFormat) {
+            fmt = &f;
+            break;
+        }
+    }
+    if (!fmt)
+        throw std::runtime_error("GLTexture::init(): unsupported internal format!");
+    if (size.minCoeff() <= 0)
+        throw std::runtime_error("GLTexture::init(): invalid texture size!");
+
+    int maxLevels = 1;
+    while ((size.maxCoeff() >> maxLevels) > 0)
+        ++maxLevels;
+    if (levels <= 0 || levels > maxLevels)
+        levels = maxLevels;
+
+    if (mID)
+        free();
+
+    mInternalFormat = fmt->internalFormat;
+    mFormat = fmt->format;
+    mType = fmt->type;
+    mChannels = fmt->channels;
+    mComponentSize = fmt->componentSize;
+    mLevels = levels;
+    mSize = size;
+
+    /* glTexStorage2D is core in OpenGL 4.2 and not exported by every loader.
+       A non-null address does not imply support (e.g. on GLX), so check the
+       version and extensions of the current context */
+    PFNNANOGUITEXSTORAGE2D texStorage2D = nullptr;
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 2) ||
+        glfwExtensionSupported("GL_ARB_texture_storage"))
+        texStorage2D = (PFNNANOGUITEXSTORAGE2D) glfwGetProcAddress("glTexStorage2D");
+
+    bool integer = mFormat == GL_RED_INTEGER || mFormat == GL_RG_INTEGER ||
+                   mFormat == GL_RGB_INTEGER || mFormat == GL_RGBA_INTEGER ||
+                   mFormat == GL_DEPTH_COMPONENT;
+
+    glGenTextures(1, &mID);
+    glBindTexture(GL_TEXTURE_2D, mID);
+    if (texStorage2D) {
+        texStorage2D(GL_TEXTURE_2D, levels, mInternalFormat, size.x(), size.y());
+    } else {
+        for (int i = 0; i < levels; ++i) {
+            Vector2i s = this->size(i);
+            glTexImage2D(GL_TEXTURE_2D, i, (GLint) mInternalFormat, s.x(), s.y(), 0,
+                         mFormat, mType, nullptr);
+        }
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    integer ? GL_NEAREST : (levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, integer ? GL_NEAREST : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GLTexture::free() {
+    if (mMapped)
+        unmap();
+    glDeleteTextures(1, &mID);
+    glDeleteBuffers(1, &mPBO);
+    mID = mPBO = 0;
+    mPBOSize = 0;
+    mLevels = 0;
+    mSize = Vector2i::Zero();
+}
+
+void GLTexture::bind(int unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, mID);
+}
+
+void GLTexture::release(int unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GLTexture::setFilter(GLenum minFilter, GLenum magFilter) {
+    glBindTexture(GL_TEXTURE_2D, mID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint) minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint) magFilter);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GLTexture::setWrap(GLenum wrap) {
+    glBindTexture(GL_TEXTURE_2D, mID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint) wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint) wrap);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+uint8_t *GLTexture::map(const Vector2i &offset, const Vector2i &size, int level) {
+    if (!mID)
+        throw std::runtime_error("GLTexture::map(): texture is not initialized!");
+    if (mMapped)
+        throw std::runtime_error("GLTexture::map(): a region is already mapped!");
+    if (level < 0 || level >= mLevels || offset.minCoeff() < 0 || size.minCoeff() <= 0 ||
+        ((offset + size).array() > this->size(level).array()).any())
+        throw std::runtime_error("GLTexture::map(): region is out of bounds!");
+
+    size_t bytes = (size_t) size.x() * (size_t) size.y() * pixelSize();
+    if (!mPBO)
+        glGenBuffers(1, &mPBO);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mPBO);
+    if (bytes > mPBOSize) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        mPBOSize = bytes;
+    }
+
+    /* Orphan the previous contents, which may still be in flight */
+    uint8_t *ptr = (uint8_t *) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!ptr)
+        throw std::runtime_error("GLTexture::map(): glMapBufferRange() failed!");
+
+    mMapped = true;
+    mMapOffset = offset;
+    mMapSize = size;
+    mMapLevel = level;
+    return ptr;
+}
+
+void GLTexture::unmap() {
+    if (!mMapped)
+        return;
+    mMapped = false;
+
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mPBO);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindTexture(GL_TEXTURE_2D, mID);
+    glTexSubImage2D(GL_TEXTURE_2D, mMapLevel, mMapOffset.x(), mMapOffset.y(),
+                    mMapSize.x(), mMapSize.y(), mFormat, mType, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+void GLTexture::update(const Vector2i &offset, const Vector2i &size, const void *data, int level) {
+    uint8_t *ptr = map(offset, size, level);
+    memcpy(ptr, data, (size_t) size.x() * (size_t) size.y() * pixelSize());
+    unmap();
+}
+
+void GLTexture::generateMipmaps() {
+    if (mLevels <= 1)
+        return;
+    glBindTexture(GL_TEXTURE_2D, mID);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GLTexture::download(std::vector<uint8_t> &data, int level) const {
+    if (level < 0 || level >= mLevels)
+        throw std::runtime_error("GLTexture::download(): invalid mipmap level!");
+    Vector2i s = size(level);
+    data.resize((size_t) s.x() * (size_t) s.y() * pixelSize());
+
+    GLint alignment;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, mID);
+    glGetTexImage(GL_TEXTURE_2D, level, mFormat, mType, data.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+}
+
+//  ----------------------------------------------------
+
 void GLFramebuffer::init(const Vector2i &size, int nSamples) {
     mSize = size;
     mSamples = nSamples;
@@ -362,9 +754,10 @@ void GLFramebuffer::init(const Vector2i &size, int nSamples) {
 }
 
 void GLFramebuffer::free() {
+    glDeleteFramebuffers(1, &mFramebuffer);
     glDeleteRenderbuffers(1, &mColor);
     glDeleteRenderbuffers(1, &mDepth);
-    mColor = mDepth = 0;
+    mFramebuffer = mColor = mDepth = 0;
 }
 
 void GLFramebuffer::bind() {
@@ -437,6 +830,43 @@ void GLFramebuffer::downloadTGA(const std::string &filename) {
 
 //  ----------------------------------------------------
 
+void GLRenderTarget::init(const Vector2i &size, int nSamples) {
+    mFramebuffer.init(size, nSamples);
+    mTexture.init(size, GL_RGBA8);
+
+    glGenFramebuffers(1, &mResolve);
+    glBindFramebuffer(GL_FRAMEBUFFER, mResolve);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           mTexture.texture(), 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw std::runtime_error("Could not create render target!");
+}
+
+void GLRenderTarget::free() {
+    glDeleteFramebuffers(1, &mResolve);
+    mResolve = 0;
+    mFramebuffer.free();
+    mTexture.free();
+}
+
+void GLRenderTarget::bind() {
+    mFramebuffer.bind();
+    glViewport(0, 0, size().x(), size().y());
+}
+
+void GLRenderTarget::release() {
+    const Vector2i &s = size();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer.framebuffer());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mResolve);
+    glBlitFramebuffer(0, 0, s.x(), s.y(), 0, 0, s.x(), s.y(),
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+//  ----------------------------------------------------
+
 Eigen::Vector3f project(const Eigen::Vector3f &obj,
                         const Eigen::Matrix4f &model,
                         const Eigen::Matrix4f &proj,
@@ -15,6 +15,7 @@
 #include <nanogui/window.h>
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/primitives.h>
 #include <cmath>
 
 NAMESPACE_BEGIN(nanogui)
@@ -90,6 +91,7 @@ ImageView::ImageView(Widget* parent, GLuint imageID)
 
 ImageView::~ImageView() {
     mShader.free();
+    mRenderTarget.free();
 }
 
 void ImageView::bindImage(GLuint imageId) {
@@ -285,24 +287,50 @@ void ImageView::performLayout(NVGcontext* ctx) {
 
 void ImageView::draw(NVGcontext* ctx) {
     Widget::draw(ctx);
-    nvgEndFrame(ctx); // Flush the NanoVG draw stack, not necessary to call nvgBeginFrame afterwards.
+
+    Screen *screen = this->screen();
+    assert(screen);
+
+    // The image is rendered with mShader into an offscreen target once all widgets have been
+    // traversed, and composited here by NanoVG so that the frame needs only a single flush.
+    Vector2i size = (sizeF() * screen->pixelRatio()).cast<int>();
+    if (size.x() > 0 && size.y() > 0) {
+        if (!mRenderTarget.ready() || mRenderTarget.size() != size) {
+            mRenderTarget.free();
+            mRenderTarget.init(size, 0);
+        }
+
+        ref<ImageView> self = this;
+        screen->deferGL([self]() mutable { self->drawOffscreen(); });
+
+        int image = screen->textureImage(mRenderTarget.texture().texture(), size,
+                                         NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+        NVGpaint paint = nvgImagePattern(ctx, mPos.x(), mPos.y(), mSize.x(),
+                                         mSize.y(), 0.0f, image, 1.0f);
+        nvgBeginPath(ctx);
+        nvgRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
 
     drawImageBorder(ctx);
 
+    if (helpersVisible())
+        drawHelpers(ctx);
+
+    drawWidgetBorder(ctx);
+}
+
+void ImageView::drawOffscreen() {
     // Calculate several variables that need to be send to OpenGL in order for the image to be
     // properly displayed inside the widget.
-    const Screen* screen = dynamic_cast<const Screen*>(this->window()->parent());
-    assert(screen);
-    Vector2f screenSize = screen->size().cast<float>();
-    Vector2f scaleFactor = mScale * imageSizeF().cwiseQuotient(screenSize);
-    Vector2f positionInScreen = absolutePosition().cast<float>();
-    Vector2f positionAfterOffset = positionInScreen + mOffset;
-    Vector2f imagePosition = positionAfterOffset.cwiseQuotient(screenSize);
-    glEnable(GL_SCISSOR_TEST);
-    float r = screen->pixelRatio();
-    glScissor(positionInScreen.x() * r,
-              (screenSize.y() - positionInScreen.y() - size().y()) * r,
-              size().x() * r, size().y() * r);
+    Vector2f scaleFactor = mScale * imageSizeF().cwiseQuotient(sizeF());
+    Vector2f imagePosition = mOffset.cwiseQuotient(sizeF());
+
+    mRenderTarget.bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_BLEND);
     mShader.bind();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, mImageID);
@@ -310,12 +338,7 @@ void ImageView::draw(NVGcontext* ctx) {
     mShader.setUniform("scaleFactor", scaleFactor);
     mShader.setUniform("position", imagePosition);
     mShader.drawIndexed(GL_TRIANGLES, 0, 2);
-    glDisable(GL_SCISSOR_TEST);
-
-    if (helpersVisible())
-        drawHelpers(ctx);
-
-    drawWidgetBorder(ctx);
+    mRenderTarget.release();
 }
 
 void ImageView::updateImageParameters() {
@@ -343,9 +366,9 @@ void ImageView::drawWidgetBorder(NVGcontext* ctx) const {
 }
 
 void ImageView::drawImageBorder(NVGcontext* ctx) const {
-    nvgSave(ctx);
+    PrimitiveBatch::save(ctx);
     nvgBeginPath(ctx);
-    nvgScissor(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    PrimitiveBatch::intersectScissor(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
     nvgStrokeWidth(ctx, 1.0f);
     Vector2i borderPosition = mPos + mOffset.cast<int>();
     Vector2i borderSize = scaledImageSizeF().cast<int>();
@@ -353,8 +376,7 @@ void ImageView::drawImageBorder(NVGcontext* ctx) const {
             borderSize.x() + 1, borderSize.y() + 1);
     nvgStrokeColor(ctx, Color(1.0f, 1.0f, 1.0f, 1.0f));
     nvgStroke(ctx);
-    nvgResetScissor(ctx);
-    nvgRestore(ctx);
+    PrimitiveBatch::restore(ctx);
 }
 
 void ImageView::drawHelpers(NVGcontext* ctx) const {
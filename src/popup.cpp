@@ -12,6 +12,8 @@
 
 #include <nanogui/popup.h>
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
 #include <nanogui/serializer/core.h>
 
@@ -40,6 +42,10 @@ void Popup::refreshRelativePlacement() {
     mPos = mParentWindow->position() + mAnchorPos - Vector2i(0, mAnchorHeight);
 }
 
+int Popup::layerMargin() const {
+    return std::max(Window::layerMargin(), 15);
+}
+
 void Popup::draw(NVGcontext* ctx) {
     refreshRelativePlacement();
 
@@ -48,24 +54,35 @@ void Popup::draw(NVGcontext* ctx) {
 
     int ds = mTheme->mWindowDropShadowSize, cr = mTheme->mWindowCornerRadius;
 
-    nvgSave(ctx);
-    nvgResetScissor(ctx);
+    /* Layered popups apply the opacity when compositing */
+    bool fade = mOpacity < 1.0f && !mCached;
+    if (fade) {
+        PrimitiveBatch::save(ctx);
+        PrimitiveBatch::globalAlpha(ctx, mOpacity);
+    }
 
-    /* Draw a drop shadow */
-    NVGpaint shadowPaint = nvgBoxGradient(
-        ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr*2, ds*2,
-        mTheme->mDropShadow, mTheme->mTransparent);
+    PrimitiveBatch::save(ctx);
+    PrimitiveBatch::resetScissor(ctx);
 
-    nvgBeginPath(ctx);
-    nvgRect(ctx, mPos.x()-ds,mPos.y()-ds, mSize.x()+2*ds, mSize.y()+2*ds);
-    nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr);
-    nvgPathWinding(ctx, NVG_HOLE);
-    nvgFillPaint(ctx, shadowPaint);
-    nvgFill(ctx);
+    /* Draw a drop shadow */
+    const Skin *skin = mTheme->skin();
+    if (skin && skin->ready()) {
+        skin->draw(ctx, Skin::Element::WindowShadow, mPos.x(), mPos.y(),
+                   mSize.x(), mSize.y());
+    } else {
+        NVGpaint shadowPaint = nvgBoxGradient(
+            ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr*2, ds*2,
+            mTheme->mDropShadow, mTheme->mTransparent);
+
+        PrimitiveBatch::fillRectWithHole(
+            ctx, mPos.x() - ds, mPos.y() - ds, mSize.x() + 2 * ds,
+            mSize.y() + 2 * ds, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr,
+            shadowPaint);
+    }
 
     /* Draw window */
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr);
+    PrimitiveBatch::fillRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(),
+                                    mSize.y(), cr, mTheme->mWindowPopup);
 
     Vector2i base = mPos + Vector2i(0, mAnchorHeight);
     int sign = -1;
@@ -74,15 +91,19 @@ void Popup::draw(NVGcontext* ctx) {
         sign = 1;
     }
 
+    nvgBeginPath(ctx);
     nvgMoveTo(ctx, base.x() + 15*sign, base.y());
     nvgLineTo(ctx, base.x() - 1*sign, base.y() - 15);
     nvgLineTo(ctx, base.x() - 1*sign, base.y() + 15);
 
     nvgFillColor(ctx, mTheme->mWindowPopup);
     nvgFill(ctx);
-    nvgRestore(ctx);
+    PrimitiveBatch::restore(ctx);
 
     Widget::draw(ctx);
+
+    if (fade)
+        PrimitiveBatch::restore(ctx);
 }
 
 void Popup::save(Serializer &s) const {
@@ -0,0 +1,513 @@
+/*
+    src/primitives.cpp -- Instanced signed-distance renderer for rounded
+    rectangles, circles and gradients
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/primitives.h>
+#include <nanogui/opengl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+namespace {
+    /* Batch that is recording between begin() and end() */
+    PrimitiveBatch *activeBatch = nullptr;
+
+    constexpr char const *const primitiveVertexShader =
+        R"(#version 330
+        uniform vec2 viewSize;
+        in vec4 shape, params, hole, paintMat, paintOffset, paintParams;
+        in vec4 innerColor, outerColor, scissor;
+        out vec2 fpos;
+        flat out vec4 vShape, vParams, vHole, vPaintMat, vPaintOffset,
+                      vPaintParams, vInnerColor, vOuterColor, vScissor;
+        void main() {
+            /* Bounding box of the shape, clipped against the scissor rectangle */
+            float grow = params.y * 0.5 + 1.0;
+            vec2 p0 = max(shape.xy - grow, scissor.xy);
+            vec2 p1 = max(min(shape.xy + shape.zw + grow, scissor.zw), p0);
+            fpos = mix(p0, p1, vec2(gl_VertexID & 1, gl_VertexID >> 1));
+
+            vShape = shape; vParams = params; vHole = hole;
+            vPaintMat = paintMat; vPaintOffset = paintOffset;
+            vPaintParams = paintParams; vInnerColor = innerColor;
+            vOuterColor = outerColor; vScissor = scissor;
+
+            gl_Position = vec4(2.0 * fpos.x / viewSize.x - 1.0,
+                               1.0 - 2.0 * fpos.y / viewSize.y, 0.0, 1.0);
+        })";
+
+    constexpr char const *const primitiveFragmentShader =
+        R"(#version 330
+        uniform sampler2D image;
+        in vec2 fpos;
+        flat in vec4 vShape, vParams, vHole, vPaintMat, vPaintOffset,
+                     vPaintParams, vInnerColor, vOuterColor, vScissor;
+        out vec4 color;
+
+        /* Signed distance to a rounded rectangle given as (x, y, w, h) */
+        float sdRoundedRect(vec2 p, vec4 rect, float r) {
+            vec2 ext = rect.zw * 0.5;
+            r = min(r, min(ext.x, ext.y));
+            vec2 q = abs(p - rect.xy - ext) - (ext - vec2(r));
+            return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - r;
+        }
+
+        /* Paint evaluation, identical to NanoVG's fragment shader */
+        float sdPaint(vec2 pt, vec2 ext, float rad) {
+            vec2 d = abs(pt) - (ext - vec2(rad));
+            return min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - rad;
+        }
+
+        void main() {
+            float d = sdRoundedRect(fpos, vShape, vParams.x);
+            float coverage = vParams.y > 0.0
+                ? clamp(vParams.y * 0.5 + 0.5 - abs(d), 0.0, 1.0)
+                : clamp(0.5 - d, 0.0, 1.0);
+            if (vHole.z > 0.0)
+                coverage *= clamp(sdRoundedRect(fpos, vHole, vParams.z) + 0.5, 0.0, 1.0);
+
+            vec2 sc = min(fpos - vScissor.xy, vScissor.zw - fpos);
+            coverage *= clamp(min(sc.x, sc.y) + 0.5, 0.0, 1.0);
+
+            /* Textured rectangle: the paint matrix holds the source rectangle */
+            if (vParams.w > 0.0) {
+                vec2 uv = vPaintMat.xy + (fpos - vShape.xy) / vShape.zw * vPaintMat.zw;
+                color = texture(image, uv) * vInnerColor * coverage;
+                return;
+            }
+
+            vec2 pt = mat2(vPaintMat.xy, vPaintMat.zw) * fpos + vPaintOffset.xy;
+            float t = clamp((sdPaint(pt, vPaintOffset.zw, vPaintParams.x) +
+                             vPaintParams.y * 0.5) / vPaintParams.y, 0.0, 1.0);
+            color = mix(vInnerColor, vOuterColor, t) * coverage;
+        })";
+
+    /* Same as the paint set up by nvgFillColor() */
+    NVGpaint colorPaint(const NVGcolor &color) {
+        NVGpaint paint;
+        memset(&paint, 0, sizeof(NVGpaint));
+        nvgTransformIdentity(paint.xform);
+        paint.feather = 1.0f;
+        paint.innerColor = paint.outerColor = color;
+        return paint;
+    }
+}
+
+PrimitiveBatch::PrimitiveBatch()
+    : mInstanceBuffer(0), mTexture(0), mContext(nullptr),
+      mSize(Vector2i::Zero()), mPixelRatio(1.f), mDrawCalls(0) { }
+
+void PrimitiveBatch::init() {
+    mShader.init("PrimitiveBatch", primitiveVertexShader, primitiveFragmentShader);
+
+    glGenBuffers(1, &mInstanceBuffer);
+    mShader.bind();
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+
+    const char *attribs[] = { "shape", "params", "hole", "paintMat",
+                              "paintOffset", "paintParams", "innerColor",
+                              "outerColor", "scissor" };
+    for (size_t i = 0; i < sizeof(attribs) / sizeof(attribs[0]); ++i) {
+        GLint id = mShader.attrib(attribs[i]);
+        if (id < 0)
+            continue;
+        glEnableVertexAttribArray(id);
+        glVertexAttribPointer(id, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                              (const void *) (i * 4 * sizeof(float)));
+        glVertexAttribDivisor(id, 1);
+    }
+}
+
+void PrimitiveBatch::free() {
+    if (activeBatch == this)
+        activeBatch = nullptr;
+    mShader.free();
+    if (mInstanceBuffer) {
+        glDeleteBuffers(1, &mInstanceBuffer);
+        mInstanceBuffer = 0;
+    }
+    mInstances.clear();
+}
+
+void PrimitiveBatch::begin(NVGcontext *ctx, const Vector2i &size,
+                           float pixelRatio,
+                           const std::function<void()> &prepare) {
+    mContext = ctx;
+    mSize = size;
+    mPixelRatio = pixelRatio;
+    mPrepare = prepare;
+    mDrawCalls = 0;
+    mInstances.clear();
+    mLayers.clear();
+
+    State state;
+    state.scissor[0] = state.scissor[1] = 0.f;
+    state.scissor[2] = size.x() * pixelRatio;
+    state.scissor[3] = size.y() * pixelRatio;
+    state.alpha = 1.f;
+    mStates.assign(1, state);
+
+    activeBatch = this;
+}
+
+void PrimitiveBatch::end() {
+    flush();
+    activeBatch = nullptr;
+    mPrepare = nullptr;
+}
+
+void PrimitiveBatch::split() {
+    if (mPrepare)
+        mPrepare();
+    flush();
+    nvgEndFrame(mContext);
+    nvgBeginFrame(mContext, mSize.x(), mSize.y(), mPixelRatio);
+    mStates.resize(1);
+    mLayers.clear();
+}
+
+bool PrimitiveBatch::layer(float x, float y, float w, float h) {
+    float xform[6], x0, y0, x1, y1;
+    transform(xform);
+    nvgTransformPoint(&x0, &y0, xform, x, y);
+    nvgTransformPoint(&x1, &y1, xform, x + w, y + h);
+    std::array<float, 4> rect = {{ std::min(x0, x1), std::min(y0, y1),
+                                   std::max(x0, x1), std::max(y0, y1) }};
+
+    bool overlaps = false;
+    for (const auto &l : mLayers) {
+        if (rect[0] < l[2] && l[0] < rect[2] && rect[1] < l[3] && l[1] < rect[3]) {
+            overlaps = true;
+            break;
+        }
+    }
+
+    if (overlaps)
+        split();
+    mLayers.push_back(rect);
+    return overlaps;
+}
+
+void PrimitiveBatch::flush() {
+    if (mInstances.empty())
+        return;
+
+    mShader.bind();
+    mShader.setUniform("viewSize", Vector2f(mSize.cast<float>() * mPixelRatio));
+    if (mTexture) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mTexture);
+        mShader.setUniform("image", 0);
+    }
+
+    /* Orphan the previous contents to avoid waiting for earlier draw calls */
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, mInstances.size() * sizeof(Instance), nullptr,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mInstances.size() * sizeof(Instance),
+                    mInstances.data());
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_CULL_FACE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei) mInstances.size());
+
+    mInstances.clear();
+    mTexture = 0;
+    mDrawCalls++;
+}
+
+void PrimitiveBatch::transform(float *xform) const {
+    nvgCurrentTransform(mContext, xform);
+    for (int i = 0; i < 6; ++i)
+        xform[i] *= mPixelRatio;
+}
+
+void PrimitiveBatch::add(float x, float y, float w, float h, float r,
+                         float strokeWidth, const float *hole, float holeRadius,
+                         const NVGpaint &paint) {
+    const State &state = mStates.back();
+    float xform[6];
+    transform(xform);
+    float scale = std::sqrt(std::abs(xform[0] * xform[3] - xform[1] * xform[2]));
+
+    auto mapRect = [&](float x, float y, float w, float h, float *out) {
+        float x0, y0, x1, y1;
+        nvgTransformPoint(&x0, &y0, xform, x, y);
+        nvgTransformPoint(&x1, &y1, xform, x + w, y + h);
+        out[0] = std::min(x0, x1);
+        out[1] = std::min(y0, y1);
+        out[2] = std::abs(x1 - x0);
+        out[3] = std::abs(y1 - y0);
+    };
+
+    Instance inst;
+    mapRect(x, y, w, h, inst.shape);
+
+    /* Skip primitives that are entirely scissored away */
+    float grow = strokeWidth * scale * 0.5f + 1.f;
+    if (inst.shape[0] - grow >= state.scissor[2] ||
+        inst.shape[1] - grow >= state.scissor[3] ||
+        inst.shape[0] + inst.shape[2] + grow <= state.scissor[0] ||
+        inst.shape[1] + inst.shape[3] + grow <= state.scissor[1])
+        return;
+
+    /* Thin strokes are widened to one pixel and faded, as in NanoVG */
+    float alpha = state.alpha;
+    strokeWidth *= scale;
+    if (strokeWidth > 0.f && strokeWidth < 1.f) {
+        alpha *= strokeWidth * strokeWidth;
+        strokeWidth = 1.f;
+    }
+
+    inst.params[0] = r * scale;
+    inst.params[1] = strokeWidth;
+    inst.params[2] = holeRadius * scale;
+    inst.params[3] = 0.f;
+
+    if (hole)
+        mapRect(hole[0], hole[1], hole[2], hole[3], inst.hole);
+    else
+        inst.hole[0] = inst.hole[1] = inst.hole[2] = inst.hole[3] = 0.f;
+
+    /* Map framebuffer pixels to paint space */
+    float paintXform[6], inverse[6];
+    memcpy(paintXform, paint.xform, sizeof(float) * 6);
+    nvgTransformMultiply(paintXform, xform);
+    nvgTransformInverse(inverse, paintXform);
+    memcpy(inst.paintMat, inverse, sizeof(float) * 4);
+    inst.paintOffset[0] = inverse[4];
+    inst.paintOffset[1] = inverse[5];
+    inst.paintOffset[2] = paint.extent[0];
+    inst.paintOffset[3] = paint.extent[1];
+    inst.paintParams[0] = paint.radius;
+    inst.paintParams[1] = std::max(paint.feather, 1e-4f);
+    inst.paintParams[2] = inst.paintParams[3] = 0.f;
+
+    const NVGcolor *colors[2] = { &paint.innerColor, &paint.outerColor };
+    float *targets[2] = { inst.innerColor, inst.outerColor };
+    for (int i = 0; i < 2; ++i) {
+        float a = colors[i]->a * alpha;
+        targets[i][0] = colors[i]->r * a;
+        targets[i][1] = colors[i]->g * a;
+        targets[i][2] = colors[i]->b * a;
+        targets[i][3] = a;
+    }
+
+    memcpy(inst.scissor, state.scissor, sizeof(float) * 4);
+    mInstances.push_back(inst);
+}
+
+void PrimitiveBatch::addTexture(GLuint texture, float x, float y, float w,
+                                float h, const float *uv) {
+    /* All textured rectangles of a draw call share one texture */
+    if (mTexture && mTexture != texture)
+        flush();
+    mTexture = texture;
+
+    const State &state = mStates.back();
+    float xform[6], x0, y0, x1, y1;
+    transform(xform);
+    nvgTransformPoint(&x0, &y0, xform, x, y);
+    nvgTransformPoint(&x1, &y1, xform, x + w, y + h);
+
+    Instance inst;
+    memset(&inst, 0, sizeof(Instance));
+    inst.shape[0] = std::min(x0, x1);
+    inst.shape[1] = std::min(y0, y1);
+    inst.shape[2] = std::abs(x1 - x0);
+    inst.shape[3] = std::abs(y1 - y0);
+    if (inst.shape[2] <= 0.f || inst.shape[3] <= 0.f ||
+        inst.shape[0] >= state.scissor[2] || inst.shape[1] >= state.scissor[3] ||
+        inst.shape[0] + inst.shape[2] <= state.scissor[0] ||
+        inst.shape[1] + inst.shape[3] <= state.scissor[1])
+        return;
+
+    inst.params[3] = 1.f;
+    inst.paintMat[0] = uv[0];
+    inst.paintMat[1] = uv[1];
+    inst.paintMat[2] = uv[2] - uv[0];
+    inst.paintMat[3] = uv[3] - uv[1];
+    inst.paintParams[1] = 1.f;
+    for (int i = 0; i < 4; ++i)
+        inst.innerColor[i] = inst.outerColor[i] = state.alpha;
+
+    memcpy(inst.scissor, state.scissor, sizeof(float) * 4);
+    mInstances.push_back(inst);
+}
+
+PrimitiveBatch *PrimitiveBatch::active(NVGcontext *ctx) {
+    return (activeBatch && activeBatch->mContext == ctx) ? activeBatch : nullptr;
+}
+
+PrimitiveBatch *PrimitiveBatch::suspend(NVGcontext *ctx) {
+    PrimitiveBatch *batch = active(ctx);
+    if (batch)
+        activeBatch = nullptr;
+    return batch;
+}
+
+void PrimitiveBatch::resume(PrimitiveBatch *batch) {
+    if (batch)
+        activeBatch = batch;
+}
+
+void PrimitiveBatch::fillRoundedRect(NVGcontext *ctx, float x, float y,
+                                     float w, float h, float r,
+                                     const NVGpaint &paint) {
+    if (PrimitiveBatch *batch = active(ctx)) {
+        batch->add(x, y, w, h, r, 0.f, nullptr, 0.f, paint);
+    } else {
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, x, y, w, h, r);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
+}
+
+void PrimitiveBatch::fillRoundedRect(NVGcontext *ctx, float x, float y,
+                                     float w, float h, float r,
+                                     const NVGcolor &color) {
+    fillRoundedRect(ctx, x, y, w, h, r, colorPaint(color));
+}
+
+void PrimitiveBatch::strokeRoundedRect(NVGcontext *ctx, float x, float y,
+                                       float w, float h, float r,
+                                       float strokeWidth,
+                                       const NVGpaint &paint) {
+    if (PrimitiveBatch *batch = active(ctx)) {
+        batch->add(x, y, w, h, r, strokeWidth, nullptr, 0.f, paint);
+    } else {
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, x, y, w, h, r);
+        nvgStrokeWidth(ctx, strokeWidth);
+        nvgStrokePaint(ctx, paint);
+        nvgStroke(ctx);
+    }
+}
+
+void PrimitiveBatch::strokeRoundedRect(NVGcontext *ctx, float x, float y,
+                                       float w, float h, float r,
+                                       float strokeWidth,
+                                       const NVGcolor &color) {
+    strokeRoundedRect(ctx, x, y, w, h, r, strokeWidth, colorPaint(color));
+}
+
+void PrimitiveBatch::fillCircle(NVGcontext *ctx, float cx, float cy, float r,
+                                const NVGpaint &paint) {
+    if (PrimitiveBatch *batch = active(ctx)) {
+        batch->add(cx - r, cy - r, 2 * r, 2 * r, r, 0.f, nullptr, 0.f, paint);
+    } else {
+        nvgBeginPath(ctx);
+        nvgCircle(ctx, cx, cy, r);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
+}
+
+void PrimitiveBatch::fillCircle(NVGcontext *ctx, float cx, float cy, float r,
+                                const NVGcolor &color) {
+    fillCircle(ctx, cx, cy, r, colorPaint(color));
+}
+
+void PrimitiveBatch::strokeCircle(NVGcontext *ctx, float cx, float cy,
+                                  float r, float strokeWidth,
+                                  const NVGpaint &paint) {
+    if (PrimitiveBatch *batch = active(ctx)) {
+        batch->add(cx - r, cy - r, 2 * r, 2 * r, r, strokeWidth, nullptr, 0.f, paint);
+    } else {
+        nvgBeginPath(ctx);
+        nvgCircle(ctx, cx, cy, r);
+        nvgStrokeWidth(ctx, strokeWidth);
+        nvgStrokePaint(ctx, paint);
+        nvgStroke(ctx);
+    }
+}
+
+void PrimitiveBatch::strokeCircle(NVGcontext *ctx, float cx, float cy,
+                                  float r, float strokeWidth,
+                                  const NVGcolor &color) {
+    strokeCircle(ctx, cx, cy, r, strokeWidth, colorPaint(color));
+}
+
+void PrimitiveBatch::fillRectWithHole(NVGcontext *ctx, float x, float y,
+                                      float w, float h, float hx, float hy,
+                                      float hw, float hh, float hr,
+                                      const NVGpaint &paint) {
+    if (PrimitiveBatch *batch = active(ctx)) {
+        float hole[4] = { hx, hy, hw, hh };
+        batch->add(x, y, w, h, 0.f, 0.f, hole, hr, paint);
+    } else {
+        nvgBeginPath(ctx);
+        nvgRect(ctx, x, y, w, h);
+        nvgRoundedRect(ctx, hx, hy, hw, hh, hr);
+        nvgPathWinding(ctx, NVG_HOLE);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
+}
+
+void PrimitiveBatch::save(NVGcontext *ctx) {
+    nvgSave(ctx);
+    if (PrimitiveBatch *batch = active(ctx))
+        batch->mStates.push_back(batch->mStates.back());
+}
+
+void PrimitiveBatch::restore(NVGcontext *ctx) {
+    nvgRestore(ctx);
+    PrimitiveBatch *batch = active(ctx);
+    if (batch && batch->mStates.size() > 1)
+        batch->mStates.pop_back();
+}
+
+void PrimitiveBatch::intersectScissor(NVGcontext *ctx, float x, float y,
+                                      float w, float h) {
+    nvgIntersectScissor(ctx, x, y, w, h);
+    PrimitiveBatch *batch = active(ctx);
+    if (!batch)
+        return;
+
+    float xform[6], x0, y0, x1, y1;
+    batch->transform(xform);
+    nvgTransformPoint(&x0, &y0, xform, x, y);
+    nvgTransformPoint(&x1, &y1, xform, x + w, y + h);
+
+    float *scissor = batch->mStates.back().scissor;
+    scissor[0] = std::max(scissor[0], std::min(x0, x1));
+    scissor[1] = std::max(scissor[1], std::min(y0, y1));
+    scissor[2] = std::max(scissor[0], std::min(scissor[2], std::max(x0, x1)));
+    scissor[3] = std::max(scissor[1], std::min(scissor[3], std::max(y0, y1)));
+}
+
+void PrimitiveBatch::resetScissor(NVGcontext *ctx) {
+    nvgResetScissor(ctx);
+    if (PrimitiveBatch *batch = active(ctx)) {
+        float *scissor = batch->mStates.back().scissor;
+        scissor[0] = scissor[1] = 0.f;
+        scissor[2] = batch->mSize.x() * batch->mPixelRatio;
+        scissor[3] = batch->mSize.y() * batch->mPixelRatio;
+    }
+}
+
+void PrimitiveBatch::globalAlpha(NVGcontext *ctx, float alpha) {
+    nvgGlobalAlpha(ctx, alpha);
+    if (PrimitiveBatch *batch = active(ctx))
+        batch->mStates.back().alpha = alpha;
+}
+
+NAMESPACE_END(nanogui)
@@ -11,6 +11,7 @@
 
 #include <nanogui/progressbar.h>
 #include <nanogui/opengl.h>
+#include <nanogui/primitives.h>
 #include <nanogui/serializer/core.h>
 
 NAMESPACE_BEGIN(nanogui)
@@ -28,10 +29,8 @@ void ProgressBar::draw(NVGcontext* ctx) {
     NVGpaint paint = nvgBoxGradient(
         ctx, mPos.x() + 1, mPos.y() + 1,
         mSize.x()-2, mSize.y(), 3, 4, Color(0, 32), Color(0, 92));
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), 3);
-    nvgFillPaint(ctx, paint);
-    nvgFill(ctx);
+    PrimitiveBatch::fillRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(),
+                                    mSize.y(), 3, paint);
 
     float value = std::min(std::max(0.0f, mValue), 1.0f);
     int barPos = (int) std::round((mSize.x() - 2) * value);
@@ -41,12 +40,9 @@ void ProgressBar::draw(NVGcontext* ctx) {
         barPos+1.5f, mSize.y()-1, 3, 4,
         Color(220, 100), Color(128, 100));
 
-    nvgBeginPath(ctx);
-    nvgRoundedRect(
+    PrimitiveBatch::fillRoundedRect(
         ctx, mPos.x()+1, mPos.y()+1,
-        barPos, mSize.y()-2, 3);
-    nvgFillPaint(ctx, paint);
-    nvgFill(ctx);
+        barPos, mSize.y()-2, 3, paint);
 }
 
 void ProgressBar::save(Serializer &s) const {
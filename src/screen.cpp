@@ -13,9 +13,13 @@
 
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
 #include <nanogui/opengl.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
+#include <nanogui/capture.h>
+#include <nanogui/primitives.h>
+#include <algorithm>
 #include <map>
 #include <iostream>
 
@@ -331,6 +335,11 @@ void Screen::initialize(GLFWwindow *window, bool shutdownGLFWOnDestruct) {
 
 Screen::~Screen() {
     __nanogui_screens.erase(mGLFWWindow);
+    freeSkins();
+    if (mPrimitives) {
+        mPrimitives->free();
+        delete mPrimitives;
+    }
     for (int i=0; i < (int) Cursor::CursorCount; ++i) {
         if (mCursors[i])
             glfwDestroyCursor(mCursors[i]);
@@ -376,6 +385,15 @@ void Screen::drawAll() {
     drawContents();
     drawWidgets();
 
+    if (mFrameCapture) {
+        if (mFrameCapture->size() != mFBSize) {
+            int bufferCount = mFrameCapture->ready() ? mFrameCapture->bufferCount() : 3;
+            mFrameCapture->poll(true);
+            mFrameCapture->init(mFBSize, bufferCount);
+        }
+        mFrameCapture->capture(0, glfwGetTime());
+    }
+
     glfwSwapBuffers(mGLFWWindow);
 }
 
@@ -397,9 +415,24 @@ void Screen::drawWidgets() {
         mPixelRatio = (float) mFBSize[0] / (float) mSize[0];
 #endif
 
-    glViewport(0, 0, mFBSize[0], mFBSize[1]);
     glBindSampler(0, 0);
+    if (mPrimitiveBatching && !mPrimitives) {
+        mPrimitives = new PrimitiveBatch();
+        mPrimitives->init();
+    } else if (!mPrimitiveBatching && mPrimitives) {
+        mPrimitives->free();
+        delete mPrimitives;
+        mPrimitives = nullptr;
+    }
+
+    updateSkins();
+    updateCaches(this);
+
+    glViewport(0, 0, mFBSize[0], mFBSize[1]);
     nvgBeginFrame(mNVGContext, mSize[0], mSize[1], mPixelRatio);
+    if (mPrimitives)
+        mPrimitives->begin(mNVGContext, mSize, mPixelRatio,
+                           [this]() { runDeferredGL(); });
 
     draw(mNVGContext);
 
@@ -451,7 +484,124 @@ void Screen::drawWidgets() {
         }
     }
 
+    runDeferredGL();
+    if (mPrimitives)
+        mPrimitives->end();
+    nvgEndFrame(mNVGContext);
+
+    /* Release image handles of textures that were not drawn this frame */
+    for (auto it = mTextureImages.begin(); it != mTextureImages.end();) {
+        if (!it->second.second) {
+            nvgDeleteImage(mNVGContext, it->second.first);
+            it = mTextureImages.erase(it);
+        } else {
+            it->second.second = false;
+            ++it;
+        }
+    }
+}
+
+void Screen::runDeferredGL() {
+    if (mDeferredGL.empty())
+        return;
+    std::vector<std::function<void()>> callbacks;
+    callbacks.swap(mDeferredGL);
+    for (auto &callback : callbacks)
+        callback();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, mFBSize[0], mFBSize[1]);
+}
+
+void Screen::updateSkins() {
+    /* Skinned themes register themselves, so no search of the widget tree is
+       needed (and nothing at all happens when no skin is set) */
+    for (Theme *theme : Theme::skinnedThemes(mNVGContext))
+        theme->skin()->update(this, theme);
+}
+
+void Screen::freeSkins() {
+    if (!mGLFWWindow)
+        return;
+    glfwMakeContextCurrent(mGLFWWindow);
+    for (Theme *theme : Theme::skinnedThemes(mNVGContext))
+        theme->skin()->free();
+}
+
+void Screen::updateCaches(Widget *widget) {
+    if (!widget->visible())
+        return;
+
+    /* Nested caches are rendered first, since they are composited into their parents */
+    for (auto child : widget->children())
+        updateCaches(child);
+
+    if (!widget->mCached)
+        return;
+
+    /* Popups follow their parent window, so place them before rendering */
+    if (Window *window = dynamic_cast<Window *>(widget)) {
+        window->refreshRelativePlacement();
+        if (!window->visible())
+            return;
+    }
+
+    Vector2i size = widget->size() + Vector2i::Constant(2 * widget->mCacheMargin),
+             fbSize = (size.cast<float>() * mPixelRatio).cast<int>();
+    if (fbSize.x() <= 0 || fbSize.y() <= 0)
+        return;
+
+    GLRenderTarget *&target = widget->mCacheTarget;
+    if (target && target->ready() && target->size() == fbSize &&
+        widget->mCacheVersion == widget->mStateVersion &&
+        widget->mCachePixelRatio == mPixelRatio)
+        return;
+
+    if (!target)
+        target = new GLRenderTarget();
+    if (!target->ready() || target->size() != fbSize) {
+        target->free();
+        target->init(fbSize, 0);
+    }
+
+    target->bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    nvgBeginFrame(mNVGContext, size.x(), size.y(), mPixelRatio);
+    if (mPrimitives)
+        mPrimitives->begin(mNVGContext, size, mPixelRatio);
+    nvgTranslate(mNVGContext, widget->mCacheMargin - widget->position().x(),
+                 widget->mCacheMargin - widget->position().y());
+
+    /* Changes made while drawing (e.g. inertial scrolling) must invalidate
+       the new contents of the cache as well */
+    uint32_t version = widget->mStateVersion;
+    widget->draw(mNVGContext);
+    runDeferredGL();
+    target->bind();
+    if (mPrimitives)
+        mPrimitives->end();
     nvgEndFrame(mNVGContext);
+    target->release();
+
+    widget->mCacheVersion = version;
+    widget->mCachePixelRatio = mPixelRatio;
+
+    /* Parent caches contain the previous contents of this texture */
+    if (widget->parent())
+        widget->parent()->markDirty();
+}
+
+int Screen::textureImage(uint32_t texture, const Vector2i &size, int imageFlags) {
+    auto key = std::make_tuple(texture, size.x(), size.y(), imageFlags);
+    auto it = mTextureImages.find(key);
+    if (it == mTextureImages.end()) {
+        int handle = nvglCreateImageFromHandleGL3(mNVGContext, texture, size.x(), size.y(),
+                                                  imageFlags | NVG_IMAGE_NODELETE);
+        it = mTextureImages.insert(std::make_pair(key, std::make_pair(handle, false))).first;
+    }
+    it->second.second = true;
+    return it->second.first;
 }
 
 bool Screen::keyboardEvent(int key, int scancode, int action, int modifiers) {
@@ -493,6 +643,15 @@ bool Screen::cursorPosCallbackEvent(double x, double y) {
     try {
         p -= Vector2i(1, 2);
 
+        /* Hover state changes for the widgets below the old and new position */
+        Widget *prevHover = findWidget(mMousePos), *hover = findWidget(p);
+        if (prevHover != hover) {
+            if (prevHover)
+                prevHover->markDirty();
+            if (hover)
+                hover->markDirty();
+        }
+
         if (!mDragActive) {
             Widget *widget = findWidget(p);
             if (widget != nullptr && widget->cursor() != mCursor) {
@@ -500,13 +659,22 @@ bool Screen::cursorPosCallbackEvent(double x, double y) {
                 glfwSetCursor(mGLFWWindow, mCursors[(int) mCursor]);
             }
         } else {
+            Vector2i dragPos = mDragWidget->position();
             ret = mDragWidget->mouseDragEvent(
                 p - mDragWidget->parent()->absolutePosition(), p - mMousePos,
                 mMouseState, mModifiers);
+            /* Dragging a window around only translates its layer */
+            if (mDragWidget->position() != dragPos)
+                mDragWidget->parent()->markDirty();
+            else
+                mDragWidget->markDirty();
         }
 
-        if (!ret)
+        if (!ret) {
             ret = mouseMotionEvent(p, p - mMousePos, mMouseState, mModifiers);
+            if (ret && hover)
+                hover->markDirty();
+        }
 
         mMousePos = p;
 
@@ -536,6 +704,10 @@ bool Screen::mouseButtonCallbackEvent(int button, int action, int modifiers) {
             mMouseState &= ~(1 << button);
 
         auto dropWidget = findWidget(mMousePos);
+        if (dropWidget)
+            dropWidget->markDirty();
+        if (mDragWidget)
+            mDragWidget->markDirty();
         if (mDragActive && action == GLFW_RELEASE &&
             dropWidget != mDragWidget)
             mDragWidget->mouseButtonEvent(
@@ -569,6 +741,8 @@ bool Screen::mouseButtonCallbackEvent(int button, int action, int modifiers) {
 
 bool Screen::keyCallbackEvent(int key, int scancode, int action, int mods) {
     mLastInteraction = glfwGetTime();
+    if (!mFocusPath.empty())
+        mFocusPath.front()->markDirty();
     try {
         return keyboardEvent(key, scancode, action, mods);
     } catch (const std::exception &e) {
@@ -579,6 +753,8 @@ bool Screen::keyCallbackEvent(int key, int scancode, int action, int mods) {
 
 bool Screen::charCallbackEvent(unsigned int codepoint) {
     mLastInteraction = glfwGetTime();
+    if (!mFocusPath.empty())
+        mFocusPath.front()->markDirty();
     try {
         return keyboardCharacterEvent(codepoint);
     } catch (const std::exception &e) {
@@ -606,6 +782,7 @@ bool Screen::scrollCallbackEvent(double x, double y) {
                     return false;
             }
         }
+        markDirtyAt(mMousePos);
         return scrollEvent(mMousePos, Vector2f(x, y));
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what()
@@ -644,6 +821,10 @@ void Screen::updateFocus(Widget *widget) {
             continue;
         w->focusEvent(false);
     }
+    if (!mFocusPath.empty())
+        mFocusPath.front()->markDirty();
+    if (widget)
+        widget->markDirty();
     mFocusPath.clear();
     Widget *window = nullptr;
     while (widget) {
@@ -659,6 +840,12 @@ void Screen::updateFocus(Widget *widget) {
         moveWindowToFront((Window *) window);
 }
 
+void Screen::markDirtyAt(const Vector2i &p) {
+    Widget *widget = findWidget(p);
+    if (widget)
+        widget->markDirty();
+}
+
 void Screen::disposeWindow(Window *window) {
     if (std::find(mFocusPath.begin(), mFocusPath.end(), window) != mFocusPath.end())
         mFocusPath.clear();
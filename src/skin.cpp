@@ -0,0 +1,356 @@
+/*
+    src/skin.cpp -- Pre-rendered nine-slice atlas of theme elements
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/skin.h>
+#include <nanogui/screen.h>
+#include <nanogui/theme.h>
+#include <nanogui/primitives.h>
+#include <nanogui/opengl.h>
+#include <cmath>
+
+NAMESPACE_BEGIN(nanogui)
+
+/* Width of the (transparent) gap between neighboring cells */
+static const int SKIN_GUTTER = 2;
+
+/* Maximum width of the atlas in logical pixels */
+static const int SKIN_ATLAS_WIDTH = 256;
+
+Skin::Skin()
+    : mAtlasSize(Vector2i::Zero()), mPixelRatio(1.f), mImage(0),
+      mGeneration(0) { }
+
+Skin::~Skin() {
+    free();
+}
+
+void Skin::free() {
+    mTarget.free();
+    mSignature.clear();
+    mImage = 0;
+}
+
+void Skin::signature(const Theme *theme, std::vector<float> &result) const {
+    const Color *colors[] = {
+        &theme->mDropShadow, &theme->mTransparent,
+        &theme->mBorderDark, &theme->mBorderLight,
+        &theme->mButtonGradientTopFocused, &theme->mButtonGradientBotFocused,
+        &theme->mButtonGradientTopUnfocused, &theme->mButtonGradientBotUnfocused,
+        &theme->mButtonGradientTopPushed, &theme->mButtonGradientBotPushed,
+        &theme->mWindowFillUnfocused, &theme->mWindowFillFocused,
+        &theme->mWindowHeaderGradientTop, &theme->mWindowHeaderGradientBot,
+        &theme->mWindowHeaderSepTop, &theme->mWindowHeaderSepBot
+    };
+
+    result.clear();
+    result.push_back((float) theme->mWindowCornerRadius);
+    result.push_back((float) theme->mWindowHeaderHeight);
+    result.push_back((float) theme->mWindowDropShadowSize);
+    result.push_back((float) theme->mButtonCornerRadius);
+    result.push_back((float) theme->mButtonFontSize);
+    for (const Color *c : colors)
+        result.insert(result.end(), c->data(), c->data() + 4);
+}
+
+Vector2i Skin::layout(const Theme *theme) {
+    float ds = (float) theme->mWindowDropShadowSize,
+          cr = (float) theme->mWindowCornerRadius,
+          hh = (float) theme->mWindowHeaderHeight,
+          bcr = (float) theme->mButtonCornerRadius;
+
+    /* Corner slices must contain everything that depends on the distance
+       to two edges; four stretchable pixels are placed in between */
+    auto cell = [](float ix, float iy, float w, float h, float margin, bool hollow) {
+        Cell c;
+        c.pos = Vector2f::Zero();
+        c.inset = Vector2f(ix, iy);
+        c.size = Vector2f(w < 0 ? 2 * ix + 4 : w, h < 0 ? 2 * iy + 4 : h);
+        c.margin = margin;
+        c.hollow = hollow;
+        return c;
+    };
+
+    float buttonHeight = std::max((float) theme->mButtonFontSize + 10, 2 * (bcr + 2) + 4);
+
+    mCells[(int) Element::WindowShadow]      = cell(2*cr + ds, 2*cr + ds, -1, -1, ds, true);
+    mCells[(int) Element::WindowFill]        = cell(cr + 1, cr + 1, -1, -1, 1, false);
+    mCells[(int) Element::WindowFillFocused] = cell(cr + 1, cr + 1, -1, -1, 1, false);
+    mCells[(int) Element::WindowHeader]      = cell(cr + 1, hh / 2, -1, hh, 1, false);
+    mCells[(int) Element::ButtonNormal]      = cell(bcr + 2, bcr + 2, -1, buttonHeight, 1, false);
+    mCells[(int) Element::ButtonFocused]     = cell(bcr + 2, bcr + 2, -1, buttonHeight, 1, false);
+    mCells[(int) Element::ButtonPushed]      = cell(bcr + 2, bcr + 2, -1, buttonHeight, 1, false);
+    mCells[(int) Element::TextBoxNormal]     = cell(8, 8, -1, -1, 1, false);
+    mCells[(int) Element::TextBoxFocused]    = cell(8, 8, -1, -1, 1, false);
+    mCells[(int) Element::TextBoxInvalid]    = cell(8, 8, -1, -1, 1, false);
+    mCells[(int) Element::ScrollTrack]       = cell(4, 8, 8, -1, 1, false);
+    mCells[(int) Element::ScrollThumb]       = cell(4, 8, 8, -1, 1, false);
+
+    /* Simple shelf packing */
+    float x = SKIN_GUTTER, y = SKIN_GUTTER, rowHeight = 0, width = 0;
+    for (Cell &c : mCells) {
+        Vector2f extent = c.size + Vector2f::Constant(2 * c.margin);
+        if (x + extent.x() + SKIN_GUTTER > SKIN_ATLAS_WIDTH && x > SKIN_GUTTER) {
+            x = SKIN_GUTTER;
+            y += rowHeight + SKIN_GUTTER;
+            rowHeight = 0;
+        }
+        c.pos = Vector2f(x + c.margin, y + c.margin);
+        x += std::ceil(extent.x()) + SKIN_GUTTER;
+        rowHeight = std::max(rowHeight, std::ceil(extent.y()));
+        width = std::max(width, x);
+    }
+
+    return Vector2i((int) width, (int) (y + rowHeight + SKIN_GUTTER));
+}
+
+void Skin::update(Screen *screen, const Theme *theme) {
+    std::vector<float> sig;
+    signature(theme, sig);
+    sig.push_back(screen->pixelRatio());
+
+    if (sig != mSignature || !mTarget.ready()) {
+        NVGcontext *ctx = screen->nvgContext();
+        float pixelRatio = screen->pixelRatio();
+        mAtlasSize = layout(theme);
+
+        Vector2i fbSize = (mAtlasSize.cast<float>() * pixelRatio).cast<int>();
+        if (!mTarget.ready() || mTarget.size() != fbSize) {
+            mTarget.free();
+            mTarget.init(fbSize, 0);
+        }
+
+        mTarget.bind();
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+        nvgBeginFrame(ctx, mAtlasSize.x(), mAtlasSize.y(), pixelRatio);
+        for (int i = 0; i < (int) Element::ElementCount; ++i) {
+            const Cell &c = mCells[i];
+            nvgSave(ctx);
+            nvgTranslate(ctx, c.pos.x(), c.pos.y());
+            renderElement(ctx, theme, (Element) i, c.size.x(), c.size.y());
+            nvgRestore(ctx);
+        }
+        nvgEndFrame(ctx);
+        mTarget.release();
+
+        mSignature = std::move(sig);
+        mPixelRatio = pixelRatio;
+        mGeneration++;
+    }
+
+    mImage = screen->textureImage(mTarget.texture().texture(), mTarget.size(),
+                                  NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+}
+
+void Skin::renderElement(NVGcontext *ctx, const Theme *theme, Element element,
+                         float w, float h) const {
+    int ds = theme->mWindowDropShadowSize, cr = theme->mWindowCornerRadius;
+    int bcr = theme->mButtonCornerRadius;
+
+    /* The following mirrors the vector drawing code of the respective widgets */
+    switch (element) {
+        case Element::WindowShadow: {
+                NVGpaint shadowPaint = nvgBoxGradient(
+                    ctx, 0, 0, w, h, cr*2, ds*2,
+                    theme->mDropShadow, theme->mTransparent);
+
+                nvgBeginPath(ctx);
+                nvgRect(ctx, -ds, -ds, w + 2*ds, h + 2*ds);
+                nvgRoundedRect(ctx, 0, 0, w, h, cr);
+                nvgPathWinding(ctx, NVG_HOLE);
+                nvgFillPaint(ctx, shadowPaint);
+                nvgFill(ctx);
+            }
+            break;
+
+        case Element::WindowFill:
+        case Element::WindowFillFocused:
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, 0, 0, w, h, cr);
+            nvgFillColor(ctx, element == Element::WindowFillFocused
+                                  ? theme->mWindowFillFocused
+                                  : theme->mWindowFillUnfocused);
+            nvgFill(ctx);
+            break;
+
+        case Element::WindowHeader: {
+                NVGpaint headerPaint = nvgLinearGradient(
+                    ctx, 0, 0, 0, h, theme->mWindowHeaderGradientTop,
+                    theme->mWindowHeaderGradientBot);
+
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, 0, 0, w, h, cr);
+                nvgFillPaint(ctx, headerPaint);
+                nvgFill(ctx);
+
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, 0, 0, w, h, cr);
+                nvgStrokeColor(ctx, theme->mWindowHeaderSepTop);
+
+                nvgSave(ctx);
+                nvgIntersectScissor(ctx, 0, 0, w, 0.5f);
+                nvgStroke(ctx);
+                nvgRestore(ctx);
+
+                nvgBeginPath(ctx);
+                nvgMoveTo(ctx, 0.5f, h - 1.5f);
+                nvgLineTo(ctx, w - 0.5f, h - 1.5f);
+                nvgStrokeColor(ctx, theme->mWindowHeaderSepBot);
+                nvgStroke(ctx);
+            }
+            break;
+
+        case Element::ButtonNormal:
+        case Element::ButtonFocused:
+        case Element::ButtonPushed: {
+                bool pushed = element == Element::ButtonPushed;
+                NVGcolor gradTop = theme->mButtonGradientTopUnfocused;
+                NVGcolor gradBot = theme->mButtonGradientBotUnfocused;
+                if (pushed) {
+                    gradTop = theme->mButtonGradientTopPushed;
+                    gradBot = theme->mButtonGradientBotPushed;
+                } else if (element == Element::ButtonFocused) {
+                    gradTop = theme->mButtonGradientTopFocused;
+                    gradBot = theme->mButtonGradientBotFocused;
+                }
+
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, 1, 1.0f, w - 2, h - 2, bcr - 1);
+                nvgFillPaint(ctx, nvgLinearGradient(ctx, 0, 0, 0, h, gradTop, gradBot));
+                nvgFill(ctx);
+
+                nvgBeginPath(ctx);
+                nvgStrokeWidth(ctx, 1.0f);
+                nvgRoundedRect(ctx, 0.5f, (pushed ? 0.5f : 1.5f), w - 1,
+                               h - 1 - (pushed ? 0.0f : 1.0f), bcr);
+                nvgStrokeColor(ctx, theme->mBorderLight);
+                nvgStroke(ctx);
+
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, 0.5f, 0.5f, w - 1, h - 2, bcr);
+                nvgStrokeColor(ctx, theme->mBorderDark);
+                nvgStroke(ctx);
+            }
+            break;
+
+        case Element::TextBoxNormal:
+        case Element::TextBoxFocused:
+        case Element::TextBoxInvalid: {
+                NVGpaint paint;
+                if (element == Element::TextBoxFocused)
+                    paint = nvgBoxGradient(ctx, 1, 1 + 1.0f, w - 2, h - 2, 3, 4,
+                                           Color(150, 32), Color(32, 32));
+                else if (element == Element::TextBoxInvalid)
+                    paint = nvgBoxGradient(ctx, 1, 1 + 1.0f, w - 2, h - 2, 3, 4,
+                                           nvgRGBA(255, 0, 0, 100), nvgRGBA(255, 0, 0, 50));
+                else
+                    paint = nvgBoxGradient(ctx, 1, 1 + 1.0f, w - 2, h - 2, 3, 4,
+                                           Color(255, 32), Color(32, 32));
+
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, 1, 1 + 1.0f, w - 2, h - 2, 3);
+                nvgFillPaint(ctx, paint);
+                nvgFill(ctx);
+
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, 0.5f, 0.5f, w - 1, h - 1, 2.5f);
+                nvgStrokeColor(ctx, Color(0, 48));
+                nvgStroke(ctx);
+            }
+            break;
+
+        case Element::ScrollTrack:
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, 0, 0, w, h, 3);
+            nvgFillPaint(ctx, nvgBoxGradient(ctx, 1, 1, w, h, 3, 4,
+                                             Color(0, 32), Color(0, 92)));
+            nvgFill(ctx);
+            break;
+
+        case Element::ScrollThumb:
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, 1, 1, w - 2, h - 2, 2);
+            nvgFillPaint(ctx, nvgBoxGradient(ctx, -1, -1, w, h, 3, 4,
+                                             Color(220, 100), Color(128, 100)));
+            nvgFill(ctx);
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool Skin::draw(NVGcontext *ctx, Element element, float x, float y, float w,
+                float h) const {
+    if (mImage == 0 || w <= 0 || h <= 0)
+        return false;
+
+    const Cell &c = mCells[(int) element];
+    float m = c.margin,
+          ix = std::min(c.inset.x(), w * 0.5f),
+          iy = std::min(c.inset.y(), h * 0.5f);
+
+    float dx[4] = { x - m, x + ix, x + w - ix, x + w + m },
+          dy[4] = { y - m, y + iy, y + h - iy, y + h + m },
+          sx[4] = { c.pos.x() - m, c.pos.x() + c.inset.x(),
+                    c.pos.x() + c.size.x() - c.inset.x(), c.pos.x() + c.size.x() + m },
+          sy[4] = { c.pos.y() - m, c.pos.y() + c.inset.y(),
+                    c.pos.y() + c.size.y() - c.inset.y(), c.pos.y() + c.size.y() + m };
+
+    /* Snap the slice boundaries to device pixels to avoid seams */
+    for (int i = 0; i < 4; ++i) {
+        dx[i] = std::round(dx[i] * mPixelRatio) / mPixelRatio;
+        dy[i] = std::round(dy[i] * mPixelRatio) / mPixelRatio;
+    }
+
+    /* With primitive batching, the slices become textured instances of the
+       batch's draw call; NanoVG needs a separate image fill per slice since
+       each slice maps the atlas differently */
+    PrimitiveBatch *batch = PrimitiveBatch::active(ctx);
+    GLuint texture = mTarget.texture().texture();
+
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            if (c.hollow && i == 1 && j == 1)
+                continue;
+
+            float dw = dx[i + 1] - dx[i], dh = dy[j + 1] - dy[j],
+                  sw = sx[i + 1] - sx[i], sh = sy[j + 1] - sy[j];
+            if (dw <= 0 || dh <= 0 || sw <= 0 || sh <= 0)
+                continue;
+
+            if (batch) {
+                /* The render target stores the atlas bottom-up */
+                float uv[4] = { sx[i] / mAtlasSize.x(), 1.f - sy[j] / mAtlasSize.y(),
+                                sx[i + 1] / mAtlasSize.x(), 1.f - sy[j + 1] / mAtlasSize.y() };
+                batch->addTexture(texture, dx[i], dy[j], dw, dh, uv);
+                continue;
+            }
+
+            /* Map the atlas such that the source slice covers the target */
+            float scaleX = dw / sw, scaleY = dh / sh;
+            NVGpaint paint = nvgImagePattern(
+                ctx, dx[i] - sx[i] * scaleX, dy[j] - sy[j] * scaleY,
+                mAtlasSize.x() * scaleX, mAtlasSize.y() * scaleY, 0.0f,
+                mImage, 1.0f);
+
+            nvgBeginPath(ctx);
+            nvgRect(ctx, dx[i], dy[j], dw, dh);
+            nvgFillPaint(ctx, paint);
+            nvgFill(ctx);
+        }
+    }
+
+    return true;
+}
+
+NAMESPACE_END(nanogui)
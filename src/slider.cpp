@@ -12,6 +12,7 @@
 #include <nanogui/slider.h>
 #include <nanogui/theme.h>
 #include <nanogui/opengl.h>
+#include <nanogui/primitives.h>
 #include <nanogui/serializer/core.h>
 
 NAMESPACE_BEGIN(nanogui)
@@ -76,33 +77,25 @@ void Slider::draw(NVGcontext* ctx) {
         ctx, startX, center.y() - 3 + 1, widthX, 6, 3, 3,
         Color(0, mEnabled ? 32 : 10), Color(0, mEnabled ? 128 : 210));
 
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, startX, center.y() - 3 + 1, widthX, 6, 2);
-    nvgFillPaint(ctx, bg);
-    nvgFill(ctx);
+    PrimitiveBatch::fillRoundedRect(ctx, startX, center.y() - 3 + 1, widthX,
+                                    6, 2, bg);
 
     if (mHighlightedRange.second != mHighlightedRange.first) {
-        nvgBeginPath(ctx);
-        nvgRoundedRect(ctx, startX + mHighlightedRange.first * mSize.x(),
-                       center.y() - kshadow + 1,
-                       widthX *
-                           (mHighlightedRange.second - mHighlightedRange.first),
-                       kshadow * 2, 2);
-        nvgFillColor(ctx, mHighlightColor);
-        nvgFill(ctx);
+        PrimitiveBatch::fillRoundedRect(
+            ctx, startX + mHighlightedRange.first * mSize.x(),
+            center.y() - kshadow + 1,
+            widthX * (mHighlightedRange.second - mHighlightedRange.first),
+            kshadow * 2, 2, mHighlightColor);
     }
 
     NVGpaint knobShadow =
         nvgRadialGradient(ctx, knobPos.x(), knobPos.y(), kr - kshadow,
                           kr + kshadow, Color(0, 64), mTheme->mTransparent);
 
-    nvgBeginPath(ctx);
-    nvgRect(ctx, knobPos.x() - kr - 5, knobPos.y() - kr - 5, kr * 2 + 10,
-            kr * 2 + 10 + kshadow);
-    nvgCircle(ctx, knobPos.x(), knobPos.y(), kr);
-    nvgPathWinding(ctx, NVG_HOLE);
-    nvgFillPaint(ctx, knobShadow);
-    nvgFill(ctx);
+    PrimitiveBatch::fillRectWithHole(
+        ctx, knobPos.x() - kr - 5, knobPos.y() - kr - 5, kr * 2 + 10,
+        kr * 2 + 10 + kshadow, knobPos.x() - kr, knobPos.y() - kr, kr * 2,
+        kr * 2, kr, knobShadow);
 
     NVGpaint knob = nvgLinearGradient(ctx,
         mPos.x(), center.y() - kr, mPos.x(), center.y() + kr,
@@ -112,18 +105,13 @@ void Slider::draw(NVGcontext* ctx) {
         mTheme->mBorderMedium,
         mTheme->mBorderLight);
 
-    nvgBeginPath(ctx);
-    nvgCircle(ctx, knobPos.x(), knobPos.y(), kr);
-    nvgStrokeColor(ctx, mTheme->mBorderDark);
-    nvgFillPaint(ctx, knob);
-    nvgStroke(ctx);
-    nvgFill(ctx);
-    nvgBeginPath(ctx);
-    nvgCircle(ctx, knobPos.x(), knobPos.y(), kr/2);
-    nvgFillColor(ctx, Color(150, mEnabled ? 255 : 100));
-    nvgStrokePaint(ctx, knobReverse);
-    nvgStroke(ctx);
-    nvgFill(ctx);
+    PrimitiveBatch::strokeCircle(ctx, knobPos.x(), knobPos.y(), kr, 1.0f,
+                                 mTheme->mBorderDark);
+    PrimitiveBatch::fillCircle(ctx, knobPos.x(), knobPos.y(), kr, knob);
+    PrimitiveBatch::strokeCircle(ctx, knobPos.x(), knobPos.y(), kr / 2, 1.0f,
+                                 knobReverse);
+    PrimitiveBatch::fillCircle(ctx, knobPos.x(), knobPos.y(), kr / 2,
+                               Color(150, mEnabled ? 255 : 100));
 }
 
 void Slider::save(Serializer &s) const {
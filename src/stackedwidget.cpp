@@ -13,9 +13,78 @@
 */
 
 #include <nanogui/stackedwidget.h>
+#include <nanogui/screen.h>
+#include <nanogui/opengl.h>
 
 NAMESPACE_BEGIN(nanogui)
 
+namespace {
+    /// Minimum interval (in seconds) between two sweeps for idle lazy pages
+    const double releaseCheckInterval = 1.0;
+
+    bool hasFocusedDescendant(const Widget *widget) {
+        for (auto child : widget->children())
+            if (child->focused() || hasFocusedDescendant(child))
+                return true;
+        return false;
+    }
+}
+
+LazyPage::LazyPage(Widget *parent, const Factory &factory)
+    : Widget(parent), mFactory(factory), mPopulated(false),
+      mNeedsLayout(false), mLastDrawn(0.0) { }
+
+void LazyPage::populate() {
+    if (mPopulated)
+        return;
+    mPopulated = true;
+    if (mFactory)
+        mFactory(this);
+    mNeedsLayout = true;
+    markDirty();
+}
+
+void LazyPage::release() {
+    if (!mPopulated)
+        return;
+    if (mReleaseCallback)
+        mReleaseCallback(this);
+
+    /* Don't leave dangling pointers in the focus path of the screen */
+    if (hasFocusedDescendant(this)) {
+        Widget *widget = this;
+        while (widget->parent())
+            widget = widget->parent();
+        Screen *screen = dynamic_cast<Screen *>(widget);
+        if (screen)
+            screen->updateFocus(nullptr);
+    }
+
+    while (childCount() > 0)
+        removeChild(childCount() - 1);
+    mPopulated = false;
+    mNeedsLayout = false;
+}
+
+Vector2i LazyPage::preferredSize(NVGcontext *ctx) const {
+    if (!mPopulated)
+        return mFixedSize.cwiseMax(Vector2i::Zero());
+    return Widget::preferredSize(ctx);
+}
+
+void LazyPage::performLayout(NVGcontext *ctx) {
+    mNeedsLayout = false;
+    Widget::performLayout(ctx);
+}
+
+void LazyPage::draw(NVGcontext *ctx) {
+    populate();
+    if (mNeedsLayout)
+        performLayout(ctx);
+    mLastDrawn = glfwGetTime();
+    Widget::draw(ctx);
+}
+
 StackedWidget::StackedWidget(nanogui::Widget *parent)
     : Widget(parent) { }
 
@@ -54,4 +123,20 @@ void StackedWidget::addChild(int index, Widget *widget) {
     setSelectedIndex(index);
 }
 
+void StackedWidget::draw(NVGcontext *ctx) {
+    if (mReleaseTimeout >= 0) {
+        double now = glfwGetTime();
+        if (now - mLastReleaseCheck >= releaseCheckInterval) {
+            mLastReleaseCheck = now;
+            for (auto child : mChildren) {
+                LazyPage *page = dynamic_cast<LazyPage *>(child);
+                if (page && !page->visible() && page->populated() &&
+                    now - page->lastDrawn() > mReleaseTimeout)
+                    page->release();
+            }
+        }
+    }
+    Widget::draw(ctx);
+}
+
 NAMESPACE_END(nanogui)
@@ -13,8 +13,9 @@
 
 #include <nanogui/tabheader.h>
 #include <nanogui/theme.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
-#include <numeric>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -22,39 +23,58 @@ TabHeader::TabButton::TabButton(TabHeader &header, const std::string &label)
     : mHeader(&header), mLabel(label) { }
 
 Vector2i TabHeader::TabButton::preferredSize(NVGcontext *ctx) const {
+    if (mMeasured)
+        return mPreferredSize;
     // No need to call nvg font related functions since this is done by the tab header implementation
     float bounds[4];
     int labelWidth = nvgTextBounds(ctx, 0, 0, mLabel.c_str(), nullptr, bounds);
     int buttonWidth = labelWidth + 2 * mHeader->theme()->mTabButtonHorizontalPadding;
     int buttonHeight = bounds[3] - bounds[1] + 2 * mHeader->theme()->mTabButtonVerticalPadding;
-    return Vector2i(buttonWidth, buttonHeight);
+    mPreferredSize = Vector2i(buttonWidth, buttonHeight);
+    mMeasured = true;
+    return mPreferredSize;
 }
 
 void TabHeader::TabButton::calculateVisibleString(NVGcontext *ctx) {
     // The size must have been set in by the enclosing tab header.
+    mVisibleBegin = 0;
+    mVisibleLength = -1;
+    mVisibleWidth = 0;
+
     NVGtextRow displayedText;
-    nvgTextBreakLines(ctx, mLabel.c_str(), nullptr, mSize.x(), &displayedText, 1);
+    if (nvgTextBreakLines(ctx, mLabel.c_str(), nullptr, mSize.x(), &displayedText, 1) == 0)
+        return;
+    mVisibleBegin = (int) (displayedText.start - mLabel.c_str());
 
     // Check to see if the text need to be truncated.
     if (displayedText.next[0]) {
-        auto truncatedWidth = nvgTextBounds(ctx, 0.0f, 0.0f,
-                                            displayedText.start, displayedText.end, nullptr);
         auto dotsWidth = nvgTextBounds(ctx, 0.0f, 0.0f, dots, nullptr, nullptr);
-        while ((truncatedWidth + dotsWidth + mHeader->theme()->mTabButtonHorizontalPadding) > mSize.x()
-                && displayedText.end != displayedText.start) {
-            --displayedText.end;
-            truncatedWidth = nvgTextBounds(ctx, 0.0f, 0.0f,
-                                           displayedText.start, displayedText.end, nullptr);
+        float maxWidth = mSize.x() - dotsWidth - mHeader->theme()->mTabButtonHorizontalPadding;
+
+        // Binary search for the longest prefix of the first row that leaves room for the dots.
+        std::vector<NVGglyphPosition> glyphs(displayedText.end - displayedText.start);
+        int count = nvgTextGlyphPositions(ctx, 0.0f, 0.0f, displayedText.start,
+                                          displayedText.end, glyphs.data(), (int) glyphs.size());
+        auto prefixWidth = [&](int n) {
+            if (n == count)
+                return nvgTextBounds(ctx, 0.0f, 0.0f, displayedText.start,
+                                     displayedText.end, nullptr);
+            return glyphs[n].x - glyphs[0].x;
+        };
+        int lo = 0, hi = count;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (prefixWidth(mid) <= maxWidth)
+                lo = mid;
+            else
+                hi = mid - 1;
         }
+        const char *end = lo == count ? displayedText.end : glyphs[lo].str;
 
         // Remember the truncated width to know where to display the dots.
-        mVisibleWidth = truncatedWidth;
-        mVisibleText.last = displayedText.end;
-    } else {
-        mVisibleText.last = nullptr;
-        mVisibleWidth = 0;
+        mVisibleWidth = lo == 0 ? 0 : prefixWidth(lo);
+        mVisibleLength = (int) (end - displayedText.start);
     }
-    mVisibleText.first = displayedText.start;
 }
 
 void TabHeader::TabButton::drawAtPosition(NVGcontext *ctx, const Vector2i& position, bool active) {
@@ -64,8 +84,8 @@ void TabHeader::TabButton::drawAtPosition(NVGcontext *ctx, const Vector2i& posit
     int height = mSize.y();
     auto theme = mHeader->theme();
 
-    nvgSave(ctx);
-    nvgIntersectScissor(ctx, xPos, yPos, width+1, height);
+    PrimitiveBatch::save(ctx);
+    PrimitiveBatch::intersectScissor(ctx, xPos, yPos, width+1, height);
     if (!active) {
         // Background gradients
         NVGcolor gradTop = theme->mButtonGradientTopPushed;
@@ -101,17 +121,17 @@ void TabHeader::TabButton::drawAtPosition(NVGcontext *ctx, const Vector2i& posit
         nvgStrokeColor(ctx, theme->mBorderDark);
         nvgStroke(ctx);
     }
-    nvgResetScissor(ctx);
-    nvgRestore(ctx);
+    PrimitiveBatch::restore(ctx);
 
     // Draw the text with some padding
     int textX = xPos + mHeader->theme()->mTabButtonHorizontalPadding;
     int textY = yPos + mHeader->theme()->mTabButtonVerticalPadding;
     NVGcolor textColor = mHeader->theme()->mTextColor;
+    const char *first = mLabel.c_str() + mVisibleBegin;
     nvgBeginPath(ctx);
     nvgFillColor(ctx, textColor);
-    nvgText(ctx, textX, textY, mVisibleText.first, mVisibleText.last);
-    if (mVisibleText.last != nullptr)
+    nvgText(ctx, textX, textY, first, mVisibleLength < 0 ? nullptr : first + mVisibleLength);
+    if (mVisibleLength >= 0)
         nvgText(ctx, textX + mVisibleWidth, textY, dots, nullptr);
 }
 
@@ -171,6 +191,8 @@ void TabHeader::addTab(const std::string & label) {
 void TabHeader::addTab(int index, const std::string &label) {
     assert(index <= tabCount());
     mTabButtons.insert(std::next(mTabButtons.begin(), index), TabButton(*this, label));
+    mTabsDirty = mPreferredSizeDirty = true;
+    updateTabOffsets();
     setActiveTab(index);
 }
 
@@ -181,6 +203,8 @@ int TabHeader::removeTab(const std::string &label) {
     if (element == mTabButtons.end())
         return -1;
     mTabButtons.erase(element);
+    mPreferredSizeDirty = true;
+    updateTabOffsets();
     if (index == mActiveTab && index != 0)
         setActiveTab(index - 1);
     return index;
@@ -189,6 +213,8 @@ int TabHeader::removeTab(const std::string &label) {
 void TabHeader::removeTab(int index) {
     assert(index < tabCount());
     mTabButtons.erase(std::next(mTabButtons.begin(), index));
+    mPreferredSizeDirty = true;
+    updateTabOffsets();
     if (index == mActiveTab && index != 0)
         setActiveTab(index - 1);
 }
@@ -212,57 +238,42 @@ void TabHeader::ensureTabVisible(int index) {
     int allowedVisibleWidth = mSize.x() - 2 * theme()->mTabControlWidth;
     assert(allowedVisibleWidth >= visibleWidth);
     assert(index >= 0 && index < (int) mTabButtons.size());
+    (void) visibleWidth;
 
-    auto first = visibleBegin();
-    auto last = visibleEnd();
-    auto goal = tabIterator(index);
+    const int *offsets = mTabOffsets.data();
+    int count = tabCount();
+    int first = mVisibleStart, last = mVisibleEnd;
 
     // Reach the goal tab with the visible range.
-    if (goal < first) {
-        do {
-            --first;
-            visibleWidth += first->size().x();
-        } while (goal < first);
-        while (allowedVisibleWidth < visibleWidth) {
-            --last;
-            visibleWidth -= last->size().x();
-        }
-    }
-    else if (goal >= last) {
-        do {
-            visibleWidth += last->size().x();
-            ++last;
-        } while (goal >= last);
-        while (allowedVisibleWidth < visibleWidth) {
-            visibleWidth -= first->size().x();
-            ++first;
-        }
+    if (index < first) {
+        first = index;
+        // Drop tabs at the end until the range fits.
+        int fit = (int) (std::upper_bound(offsets + first, offsets + count + 1,
+                                          offsets[first] + allowedVisibleWidth) - offsets) - 1;
+        last = std::min(last, fit);
+    } else if (index >= last) {
+        last = index + 1;
+        // Drop tabs at the beginning until the range fits.
+        int fit = (int) (std::lower_bound(offsets + first, offsets + last + 1,
+                                          offsets[last] - allowedVisibleWidth) - offsets);
+        first = std::max(first, fit);
     }
 
     // Check if it is possible to expand the visible range on either side.
-    while (first != mTabButtons.begin()
-           && std::next(first, -1)->size().x() < allowedVisibleWidth - visibleWidth) {
-        --first;
-        visibleWidth += first->size().x();
-    }
-    while (last != mTabButtons.end()
-           && last->size().x() < allowedVisibleWidth - visibleWidth) {
-        visibleWidth += last->size().x();
-        ++last;
-    }
+    first = std::min(first, (int) (std::upper_bound(offsets, offsets + first,
+                                   offsets[last] - allowedVisibleWidth) - offsets));
+    last = std::max(last, (int) (std::lower_bound(offsets + last, offsets + count + 1,
+                                 offsets[first] + allowedVisibleWidth) - offsets) - 1);
 
-    mVisibleStart = (int) std::distance(mTabButtons.begin(), first);
-    mVisibleEnd = (int) std::distance(mTabButtons.begin(), last);
+    mVisibleStart = first;
+    mVisibleEnd = last;
 }
 
 std::pair<Vector2i, Vector2i> TabHeader::visibleButtonArea() const {
     if (mVisibleStart == mVisibleEnd)
         return { Vector2i::Zero(), Vector2i::Zero() };
     auto topLeft = mPos + Vector2i(theme()->mTabControlWidth, 0);
-    auto width = std::accumulate(visibleBegin(), visibleEnd(), theme()->mTabControlWidth,
-                                 [](int acc, const TabButton& tb) {
-        return acc + tb.size().x();
-    });
+    auto width = theme()->mTabControlWidth + mTabOffsets[mVisibleEnd] - mTabOffsets[mVisibleStart];
     auto bottomRight = mPos + Vector2i(width, mSize.y());
     return { topLeft, bottomRight };
 }
@@ -270,10 +281,7 @@ std::pair<Vector2i, Vector2i> TabHeader::visibleButtonArea() const {
 std::pair<Vector2i, Vector2i> TabHeader::activeButtonArea() const {
     if (mVisibleStart == mVisibleEnd || mActiveTab < mVisibleStart || mActiveTab >= mVisibleEnd)
         return { Vector2i::Zero(), Vector2i::Zero() };
-    auto width = std::accumulate(visibleBegin(), activeIterator(), theme()->mTabControlWidth,
-                                 [](int acc, const TabButton& tb) {
-        return acc + tb.size().x();
-    });
+    auto width = theme()->mTabControlWidth + mTabOffsets[mActiveTab] - mTabOffsets[mVisibleStart];
     auto topLeft = mPos + Vector2i(width, 0);
     auto bottomRight = mPos + Vector2i(width + activeIterator()->size().x(), mSize.y());
     return { topLeft, bottomRight };
@@ -282,17 +290,22 @@ std::pair<Vector2i, Vector2i> TabHeader::activeButtonArea() const {
 void TabHeader::performLayout(NVGcontext* ctx) {
     Widget::performLayout(ctx);
 
-    Vector2i currentPosition = Vector2i::Zero();
     // Place the tab buttons relative to the beginning of the tab header.
-    for (auto& tab : mTabButtons) {
-        auto tabPreferred = tab.preferredSize(ctx);
-        if (tabPreferred.x() < theme()->mTabMinButtonWidth)
-            tabPreferred.x() = theme()->mTabMinButtonWidth;
-        else if (tabPreferred.x() > theme()->mTabMaxButtonWidth)
-            tabPreferred.x() = theme()->mTabMaxButtonWidth;
-        tab.setSize(tabPreferred);
-        tab.calculateVisibleString(ctx);
-        currentPosition.x() += tabPreferred.x();
+    checkTabMetrics();
+    if (mTabsDirty) {
+        nvgFontFace(ctx, mFont.c_str());
+        nvgFontSize(ctx, fontSize());
+        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+        for (auto& tab : mTabButtons) {
+            bool labelChanged = !tab.measured();
+            auto tabPreferred = clampedTabSize(ctx, tab);
+            if (labelChanged || tabPreferred != tab.size()) {
+                tab.setSize(tabPreferred);
+                tab.calculateVisibleString(ctx);
+            }
+        }
+        updateTabOffsets();
+        mTabsDirty = false;
     }
     calculateVisibleEnd();
     if (mVisibleStart != 0 || mVisibleEnd != tabCount())
@@ -300,23 +313,58 @@ void TabHeader::performLayout(NVGcontext* ctx) {
 }
 
 Vector2i TabHeader::preferredSize(NVGcontext* ctx) const {
+    checkTabMetrics();
+    if (!mPreferredSizeDirty)
+        return mPreferredSize;
+
     // Set up the nvg context for measuring the text inside the tab buttons.
     nvgFontFace(ctx, mFont.c_str());
     nvgFontSize(ctx, fontSize());
     nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
     Vector2i size = Vector2i(2*theme()->mTabControlWidth, 0);
     for (auto& tab : mTabButtons) {
-        auto tabPreferred = tab.preferredSize(ctx);
-        if (tabPreferred.x() < theme()->mTabMinButtonWidth)
-            tabPreferred.x() = theme()->mTabMinButtonWidth;
-        else if (tabPreferred.x() > theme()->mTabMaxButtonWidth)
-            tabPreferred.x() = theme()->mTabMaxButtonWidth;
+        auto tabPreferred = clampedTabSize(ctx, tab);
         size.x() += tabPreferred.x();
         size.y() = std::max(size.y(), tabPreferred.y());
     }
+    mPreferredSize = size;
+    mPreferredSizeDirty = false;
     return size;
 }
 
+void TabHeader::checkTabMetrics() const {
+    std::vector<int> metrics = {
+        fontSize(), theme()->mTabButtonHorizontalPadding,
+        theme()->mTabButtonVerticalPadding, theme()->mTabMinButtonWidth,
+        theme()->mTabMaxButtonWidth
+    };
+    if (metrics == mMeasuredMetrics && mFont == mMeasuredFont)
+        return;
+    for (auto& tab : mTabButtons)
+        tab.invalidate();
+    mMeasuredMetrics = std::move(metrics);
+    mMeasuredFont = mFont;
+    mTabsDirty = mPreferredSizeDirty = true;
+}
+
+Vector2i TabHeader::clampedTabSize(NVGcontext* ctx, const TabButton& tab) const {
+    auto tabPreferred = tab.preferredSize(ctx);
+    if (tabPreferred.x() < theme()->mTabMinButtonWidth)
+        tabPreferred.x() = theme()->mTabMinButtonWidth;
+    else if (tabPreferred.x() > theme()->mTabMaxButtonWidth)
+        tabPreferred.x() = theme()->mTabMaxButtonWidth;
+    return tabPreferred;
+}
+
+void TabHeader::updateTabOffsets() {
+    mTabOffsets.resize(mTabButtons.size() + 1);
+    mTabOffsets[0] = 0;
+    for (size_t i = 0; i < mTabButtons.size(); ++i)
+        mTabOffsets[i + 1] = mTabOffsets[i] + mTabButtons[i].size().x();
+    mVisibleEnd = std::min(mVisibleEnd, tabCount());
+    mVisibleStart = std::min(mVisibleStart, mVisibleEnd);
+}
+
 bool TabHeader::mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) {
     Widget::mouseButtonEvent(p, button, down, modifiers);
     if (button == GLFW_MOUSE_BUTTON_1 && down) {
@@ -328,22 +376,18 @@ bool TabHeader::mouseButtonEvent(const Vector2i &p, int button, bool down, int m
             onArrowRight();
             return true;
         case ClickLocation::TabButtons:
-            auto first = visibleBegin();
-            auto last = visibleEnd();
-            int currentPosition = theme()->mTabControlWidth;
-            int endPosition = p.x();
-            auto firstInvisible = std::find_if(first, last,
-                                               [&currentPosition, endPosition](const TabButton& tb) {
-                currentPosition += tb.size().x();
-                return currentPosition > endPosition;
-            });
+            // Find the first visible tab whose right edge lies beyond the click.
+            const int *offsets = mTabOffsets.data();
+            int endPosition = p.x() - theme()->mTabControlWidth + offsets[mVisibleStart];
+            auto hit = std::upper_bound(offsets + mVisibleStart + 1,
+                                        offsets + mVisibleEnd + 1, endPosition);
 
             // Did not click on any of the tab buttons
-            if (firstInvisible == last)
+            if (hit == offsets + mVisibleEnd + 1)
                 return true;
 
             // Update the active tab and invoke the callback.
-            setActiveTab((int) std::distance(mTabButtons.begin(), firstInvisible));
+            setActiveTab((int) (hit - offsets) - 1);
             return true;
         }
     }
@@ -388,16 +432,11 @@ void TabHeader::draw(NVGcontext* ctx) {
 }
 
 void TabHeader::calculateVisibleEnd() {
-    auto first = visibleBegin();
-    auto last = mTabButtons.end();
-    int currentPosition = theme()->mTabControlWidth;
-    int lastPosition = mSize.x() - theme()->mTabControlWidth;
-    auto firstInvisible = std::find_if(first, last,
-                                       [&currentPosition, lastPosition](const TabButton& tb) {
-        currentPosition += tb.size().x();
-        return currentPosition > lastPosition;
-    });
-    mVisibleEnd = (int) std::distance(mTabButtons.begin(), firstInvisible);
+    // The first tab whose right edge does not fit anymore is invisible.
+    int lastPosition = mSize.x() - 2 * theme()->mTabControlWidth + mTabOffsets[mVisibleStart];
+    auto firstInvisible = std::upper_bound(mTabOffsets.begin() + mVisibleStart + 1,
+                                           mTabOffsets.end(), lastPosition);
+    mVisibleEnd = (int) std::distance(mTabOffsets.begin(), firstInvisible) - 1;
 }
 
 void TabHeader::drawControls(NVGcontext* ctx) {
@@ -16,6 +16,7 @@
 #include <nanogui/tabheader.h>
 #include <nanogui/stackedwidget.h>
 #include <nanogui/theme.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
 #include <nanogui/window.h>
 #include <nanogui/screen.h>
@@ -57,6 +58,26 @@ Widget* TabWidget::createTab(const std::string &label) {
     return createTab(tabCount(), label);
 }
 
+LazyPage* TabWidget::createLazyTab(int index, const std::string &label,
+                                   const std::function<void(Widget *)> &factory) {
+    LazyPage* tab = new LazyPage(nullptr, factory);
+    addTab(index, label, tab);
+    return tab;
+}
+
+LazyPage* TabWidget::createLazyTab(const std::string &label,
+                                   const std::function<void(Widget *)> &factory) {
+    return createLazyTab(tabCount(), label, factory);
+}
+
+void TabWidget::setReleaseTimeout(double seconds) {
+    mContent->setReleaseTimeout(seconds);
+}
+
+double TabWidget::releaseTimeout() const {
+    return mContent->releaseTimeout();
+}
+
 void TabWidget::addTab(const std::string &name, Widget *tab) {
     addTab(tabCount(), name, tab);
 }
@@ -143,13 +164,13 @@ void TabWidget::draw(NVGcontext* ctx) {
 
 
     for (int i = 0; i < 3; ++i) {
-        nvgSave(ctx);
+        PrimitiveBatch::save(ctx);
         if (i == 0)
-            nvgIntersectScissor(ctx, mPos.x(), mPos.y(), activeArea.first.x() + 1, mSize.y());
+            PrimitiveBatch::intersectScissor(ctx, mPos.x(), mPos.y(), activeArea.first.x() + 1, mSize.y());
         else if (i == 1)
-            nvgIntersectScissor(ctx, mPos.x() + activeArea.second.x(), mPos.y(), mSize.x() - activeArea.second.x(), mSize.y());
+            PrimitiveBatch::intersectScissor(ctx, mPos.x() + activeArea.second.x(), mPos.y(), mSize.x() - activeArea.second.x(), mSize.y());
         else
-            nvgIntersectScissor(ctx, mPos.x(), mPos.y() + tabHeight + 2, mSize.x(), mSize.y());
+            PrimitiveBatch::intersectScissor(ctx, mPos.x(), mPos.y() + tabHeight + 2, mSize.x(), mSize.y());
 
         nvgBeginPath(ctx);
         nvgStrokeWidth(ctx, 1.0f);
@@ -163,7 +184,7 @@ void TabWidget::draw(NVGcontext* ctx) {
                        mSize.y() - tabHeight - 2, mTheme->mButtonCornerRadius);
         nvgStrokeColor(ctx, mTheme->mBorderDark);
         nvgStroke(ctx);
-        nvgRestore(ctx);
+        PrimitiveBatch::restore(ctx);
     }
 
     Widget::draw(ctx);
@@ -0,0 +1,866 @@
+/*
+    src/textarea.cpp -- Multi-line text editor backed by a piece table
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textarea.h>
+#include <nanogui/screen.h>
+#include <nanogui/opengl.h>
+#include <nanogui/theme.h>
+#include <nanogui/primitives.h>
+#include <nanogui/skin.h>
+#include <nanogui/serializer/core.h>
+#include <algorithm>
+
+NAMESPACE_BEGIN(nanogui)
+
+namespace {
+    /// Distance between the border of the widget and the text
+    const float textPadding = 4.f;
+
+    /// Horizontal space reserved for the vertical scroll bar
+    const float scrollBarWidth = 12.f;
+
+    /// Number of cached line layouts that are kept beyond the visible lines
+    const size_t layoutCacheSlack = 256;
+
+    bool isContinuation(char c) { return (c & 0xC0) == 0x80; }
+
+    float scrollThumbHeight(float trackHeight, float viewHeight, float contentHeight) {
+        return std::min(trackHeight,
+            std::max(16.f, trackHeight * viewHeight / contentHeight));
+    }
+}
+
+TextDocument::TextDocument(const std::string &text)
+    : mLength(0), mCoalesce(false) {
+    setText(text);
+}
+
+void TextDocument::setText(const std::string &text) {
+    size_t removedLines = mLineStarts.empty() ? 0 : mLineStarts.size() - 1;
+
+    mOriginal = text;
+    mAdded.clear();
+    mPieces.clear();
+    mPieceOffsets.clear();
+    if (!text.empty()) {
+        mPieces.push_back(Piece{ false, 0, text.size() });
+        mPieceOffsets.push_back(0);
+    }
+    mLength = text.size();
+
+    mLineStarts.assign(1, 0);
+    for (size_t i = 0; i < text.size(); ++i)
+        if (text[i] == '\n')
+            mLineStarts.push_back(i + 1);
+
+    clearHistory();
+    if (mChangeCallback)
+        mChangeCallback(0, removedLines, mLineStarts.size() - 1);
+}
+
+size_t TextDocument::lineEnd(size_t line) const {
+    return line + 1 < mLineStarts.size() ? mLineStarts[line + 1] - 1 : mLength;
+}
+
+size_t TextDocument::lineOf(size_t offset) const {
+    return (size_t) (std::upper_bound(mLineStarts.begin(), mLineStarts.end(),
+                                      offset) - mLineStarts.begin()) - 1;
+}
+
+std::string TextDocument::line(size_t line) const {
+    return substr(lineStart(line), lineEnd(line) - lineStart(line));
+}
+
+char TextDocument::at(size_t offset) const {
+    size_t index = findPiece(offset);
+    const Piece &piece = mPieces[index];
+    return buffer(piece)[piece.start + offset - mPieceOffsets[index]];
+}
+
+std::string TextDocument::substr(size_t offset, size_t length) const {
+    std::string result;
+    if (offset >= mLength || length == 0)
+        return result;
+    length = std::min(length, mLength - offset);
+    result.reserve(length);
+
+    for (size_t index = findPiece(offset); length > 0; ++index) {
+        const Piece &piece = mPieces[index];
+        size_t skip = offset - mPieceOffsets[index];
+        size_t count = std::min(piece.length - skip, length);
+        result.append(buffer(piece), piece.start + skip, count);
+        offset += count;
+        length -= count;
+    }
+    return result;
+}
+
+void TextDocument::insert(size_t offset, const std::string &text) {
+    replace(offset, 0, text);
+}
+
+void TextDocument::erase(size_t offset, size_t length) {
+    replace(offset, length, std::string());
+}
+
+void TextDocument::replace(size_t offset, size_t length, const std::string &text) {
+    offset = std::min(offset, mLength);
+    length = std::min(length, mLength - offset);
+    if (length == 0 && text.empty())
+        return;
+    std::string removed = substr(offset, length);
+    rawErase(offset, length);
+    rawInsert(offset, text);
+    record(offset, removed, text);
+}
+
+bool TextDocument::undo(size_t *caret) {
+    if (mUndo.empty())
+        return false;
+    Delta delta = std::move(mUndo.back());
+    mUndo.pop_back();
+    rawErase(delta.offset, delta.inserted.size());
+    rawInsert(delta.offset, delta.removed);
+    if (caret)
+        *caret = delta.offset + delta.removed.size();
+    mRedo.push_back(std::move(delta));
+    mCoalesce = false;
+    return true;
+}
+
+bool TextDocument::redo(size_t *caret) {
+    if (mRedo.empty())
+        return false;
+    Delta delta = std::move(mRedo.back());
+    mRedo.pop_back();
+    rawErase(delta.offset, delta.removed.size());
+    rawInsert(delta.offset, delta.inserted);
+    if (caret)
+        *caret = delta.offset + delta.inserted.size();
+    mUndo.push_back(std::move(delta));
+    mCoalesce = false;
+    return true;
+}
+
+void TextDocument::clearHistory() {
+    mUndo.clear();
+    mRedo.clear();
+    mCoalesce = false;
+}
+
+size_t TextDocument::findPiece(size_t offset) const {
+    return (size_t) (std::upper_bound(mPieceOffsets.begin(), mPieceOffsets.end(),
+                                      offset) - mPieceOffsets.begin()) - 1;
+}
+
+size_t TextDocument::splitAt(size_t offset) {
+    if (offset >= mLength)
+        return mPieces.size();
+    size_t index = findPiece(offset);
+    size_t skip = offset - mPieceOffsets[index];
+    if (skip == 0)
+        return index;
+
+    Piece tail = mPieces[index];
+    tail.start += skip;
+    tail.length -= skip;
+    mPieces[index].length = skip;
+    mPieces.insert(mPieces.begin() + index + 1, tail);
+    mPieceOffsets.insert(mPieceOffsets.begin() + index + 1, offset);
+    return index + 1;
+}
+
+void TextDocument::updatePieceOffsets(size_t index) {
+    mPieceOffsets.resize(mPieces.size());
+    for (size_t i = index; i < mPieces.size(); ++i)
+        mPieceOffsets[i] = i == 0 ? 0 : mPieceOffsets[i - 1] + mPieces[i - 1].length;
+}
+
+void TextDocument::rawInsert(size_t offset, const std::string &text) {
+    if (text.empty())
+        return;
+    size_t line = lineOf(offset);
+
+    /* Typing appends to the end of the add buffer: grow the previous piece */
+    size_t index = 0;
+    bool extended = false;
+    if (offset > 0) {
+        size_t prev = findPiece(offset - 1);
+        Piece &piece = mPieces[prev];
+        if (piece.added && piece.start + piece.length == mAdded.size() &&
+            mPieceOffsets[prev] + piece.length == offset) {
+            piece.length += text.size();
+            index = prev + 1;
+            extended = true;
+        }
+    }
+    if (!extended) {
+        index = splitAt(offset);
+        mPieces.insert(mPieces.begin() + index, Piece{ true, mAdded.size(), text.size() });
+    }
+    mAdded += text;
+    mLength += text.size();
+    updatePieceOffsets(index);
+
+    for (size_t i = line + 1; i < mLineStarts.size(); ++i)
+        mLineStarts[i] += text.size();
+    std::vector<size_t> starts;
+    for (size_t i = 0; i < text.size(); ++i)
+        if (text[i] == '\n')
+            starts.push_back(offset + i + 1);
+    mLineStarts.insert(mLineStarts.begin() + line + 1, starts.begin(), starts.end());
+
+    if (mChangeCallback)
+        mChangeCallback(line, 0, starts.size());
+}
+
+void TextDocument::rawErase(size_t offset, size_t length) {
+    if (length == 0 || offset >= mLength)
+        return;
+    length = std::min(length, mLength - offset);
+    size_t end = offset + length;
+    size_t line = lineOf(offset);
+
+    size_t first = splitAt(offset);
+    size_t last = splitAt(end);
+    mPieces.erase(mPieces.begin() + first, mPieces.begin() + last);
+    mPieceOffsets.erase(mPieceOffsets.begin() + first, mPieceOffsets.begin() + last);
+    mLength -= length;
+    updatePieceOffsets(first);
+
+    /* Lines starting within (offset, end] lost their line break */
+    auto lo = std::upper_bound(mLineStarts.begin(), mLineStarts.end(), offset);
+    auto hi = std::upper_bound(lo, mLineStarts.end(), end);
+    size_t removed = (size_t) (hi - lo);
+    for (auto it = hi; it != mLineStarts.end(); ++it)
+        *it -= length;
+    mLineStarts.erase(lo, hi);
+
+    if (mChangeCallback)
+        mChangeCallback(line, removed, 0);
+}
+
+void TextDocument::record(size_t offset, const std::string &removed,
+                          const std::string &inserted) {
+    mRedo.clear();
+
+    /* Merge consecutive typing, backspacing and deleting within a line */
+    if (mCoalesce && !mUndo.empty() &&
+        inserted.find('\n') == std::string::npos &&
+        removed.find('\n') == std::string::npos) {
+        Delta &last = mUndo.back();
+        if (removed.empty() && last.offset + last.inserted.size() == offset) {
+            last.inserted += inserted;
+            return;
+        }
+        if (inserted.empty() && last.inserted.empty()) {
+            if (offset + removed.size() == last.offset) {
+                last.removed.insert(0, removed);
+                last.offset = offset;
+                return;
+            } else if (offset == last.offset) {
+                last.removed += removed;
+                return;
+            }
+        }
+    }
+
+    mUndo.push_back(Delta{ offset, removed, inserted });
+    mCoalesce = true;
+}
+
+TextArea::TextArea(Widget *parent, const std::string &value)
+    : Widget(parent), mDocument(value), mEditable(true), mFont("sans"),
+      mTextColor(Color(0, 0)), mCaret(0), mAnchor(0), mPreferredX(-1.f),
+      mScrollToCaret(false), mScroll(Vector2f::Zero()), mContentWidth(0.f),
+      mDragScrollBar(false), mLastClick(0.0), mLayoutFontSize(0.f) {
+    mDocument.setChangeCallback(
+        [this](size_t line, size_t removedLines, size_t insertedLines) {
+            invalidateLines(line, removedLines, insertedLines);
+        });
+    if (mTheme) mFontSize = mTheme->mTextBoxFontSize;
+    setCursor(Cursor::IBeam);
+}
+
+void TextArea::setValue(const std::string &value) {
+    mDocument.setText(value);
+    mLayouts.clear();
+    mContentWidth = 0.f;
+    mCaret = mAnchor = 0;
+    mPreferredX = -1.f;
+    mScroll = Vector2f::Zero();
+    markDirty();
+}
+
+void TextArea::setEditable(bool editable) {
+    mEditable = editable;
+    markDirty();
+}
+
+void TextArea::setTheme(Theme *theme) {
+    Widget::setTheme(theme);
+    if (mTheme)
+        mFontSize = mTheme->mTextBoxFontSize;
+}
+
+void TextArea::setCaretPosition(size_t offset) {
+    moveCaret(std::min(offset, mDocument.length()), false);
+}
+
+void TextArea::select(size_t begin, size_t end) {
+    mAnchor = std::min(begin, mDocument.length());
+    moveCaret(std::min(end, mDocument.length()), true);
+}
+
+std::string TextArea::selectedText() const {
+    size_t begin = std::min(mAnchor, mCaret), end = std::max(mAnchor, mCaret);
+    return mDocument.substr(begin, end - begin);
+}
+
+void TextArea::insert(const std::string &text) {
+    replaceRange(std::min(mAnchor, mCaret), std::max(mAnchor, mCaret), text);
+}
+
+bool TextArea::undo() {
+    size_t caret;
+    if (!mDocument.undo(&caret))
+        return false;
+    mCaret = mAnchor = caret;
+    mPreferredX = -1.f;
+    mScrollToCaret = true;
+    if (mCallback)
+        mCallback();
+    markDirty();
+    return true;
+}
+
+bool TextArea::redo() {
+    size_t caret;
+    if (!mDocument.redo(&caret))
+        return false;
+    mCaret = mAnchor = caret;
+    mPreferredX = -1.f;
+    mScrollToCaret = true;
+    if (mCallback)
+        mCallback();
+    markDirty();
+    return true;
+}
+
+void TextArea::scrollToLine(size_t line) {
+    float lh = lineHeight();
+    if (line * lh < mScroll.y())
+        mScroll.y() = line * lh;
+    else if ((line + 1) * lh > mScroll.y() + viewHeight())
+        mScroll.y() = (line + 1) * lh - viewHeight();
+    clampScroll();
+    markDirty();
+}
+
+float TextArea::viewWidth() const {
+    return mSize.x() - 2 * textPadding - (scrollBarVisible() ? scrollBarWidth : 0.f);
+}
+
+float TextArea::viewHeight() const {
+    return mSize.y() - 2 * textPadding;
+}
+
+bool TextArea::scrollBarVisible() const {
+    return mDocument.lineCount() * lineHeight() > viewHeight();
+}
+
+const TextArea::LineLayout &TextArea::layoutLine(NVGcontext *ctx, size_t line) {
+    if (mLayoutFont != mFont || mLayoutFontSize != fontSize()) {
+        mLayouts.clear();
+        mContentWidth = 0.f;
+        mLayoutFont = mFont;
+        mLayoutFontSize = (float) fontSize();
+    }
+
+    auto it = mLayouts.find(line);
+    if (it != mLayouts.end())
+        return it->second;
+
+    std::string text = mDocument.line(line);
+    LineLayout &layout = mLayouts[line];
+    layout.x.assign(text.size() + 1, -1.f);
+    layout.x[0] = 0.f;
+
+    if (!text.empty()) {
+        const char *begin = text.data(), *end = begin + text.size();
+        std::vector<NVGglyphPosition> glyphs(text.size());
+
+        nvgSave(ctx);
+        nvgFontFace(ctx, mFont.c_str());
+        nvgFontSize(ctx, fontSize());
+        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+        int count = nvgTextGlyphPositions(ctx, 0, 0, begin, end,
+                                          glyphs.data(), (int) glyphs.size());
+        float width = nvgTextBounds(ctx, 0, 0, begin, end, nullptr);
+        nvgRestore(ctx);
+
+        for (int i = 0; i < count; ++i)
+            layout.x[glyphs[i].str - begin] = glyphs[i].x;
+
+        /* Bytes within a multi-byte character share the position of its first byte */
+        for (size_t i = 1; i < text.size(); ++i)
+            if (layout.x[i] < 0.f)
+                layout.x[i] = layout.x[i - 1];
+        layout.x[text.size()] = std::max(width, layout.x[text.size() - 1]);
+    }
+
+    mContentWidth = std::max(mContentWidth, layout.x.back());
+    return layout;
+}
+
+void TextArea::invalidateLines(size_t line, size_t removedLines, size_t insertedLines) {
+    if (mLayouts.empty())
+        return;
+
+    if (removedLines == insertedLines) {
+        for (size_t i = line; i <= line + removedLines; ++i)
+            mLayouts.erase(i);
+        return;
+    }
+
+    /* Drop the edited lines and renumber the ones behind them */
+    std::unordered_map<size_t, LineLayout> layouts;
+    layouts.reserve(mLayouts.size());
+    for (auto &kv : mLayouts) {
+        if (kv.first < line)
+            layouts.emplace(kv.first, std::move(kv.second));
+        else if (kv.first > line + removedLines)
+            layouts.emplace(kv.first - removedLines + insertedLines,
+                            std::move(kv.second));
+    }
+    mLayouts.swap(layouts);
+}
+
+void TextArea::trimLayoutCache(size_t firstVisible, size_t lastVisible) {
+    if (mLayouts.size() <= lastVisible - firstVisible + layoutCacheSlack)
+        return;
+    size_t slack = layoutCacheSlack / 2;
+    for (auto it = mLayouts.begin(); it != mLayouts.end(); ) {
+        if (it->first + slack < firstVisible || it->first > lastVisible + slack)
+            it = mLayouts.erase(it);
+        else
+            ++it;
+    }
+}
+
+size_t TextArea::hitTest(const Vector2i &p) {
+    NVGcontext *ctx = screen()->nvgContext();
+    float y = p.y() - mPos.y() - textPadding + mScroll.y();
+    size_t line = y <= 0 ? 0 : std::min((size_t) (y / lineHeight()),
+                                        mDocument.lineCount() - 1);
+    return offsetAtX(ctx, line, p.x() - mPos.x() - textPadding + mScroll.x());
+}
+
+float TextArea::caretX(NVGcontext *ctx, size_t offset) {
+    size_t line = mDocument.lineOf(offset);
+    return layoutLine(ctx, line).x[offset - mDocument.lineStart(line)];
+}
+
+size_t TextArea::offsetAtX(NVGcontext *ctx, size_t line, float x) {
+    const LineLayout &layout = layoutLine(ctx, line);
+    size_t start = mDocument.lineStart(line);
+    size_t length = layout.x.size() - 1;
+
+    size_t index = (size_t) (std::lower_bound(layout.x.begin(), layout.x.end(), x) -
+                             layout.x.begin());
+    if (index > length)
+        return start + length;
+    if (index > 0 && x - layout.x[index - 1] < layout.x[index] - x)
+        return prevChar(start + index);
+    return start + index;
+}
+
+size_t TextArea::prevChar(size_t offset) const {
+    if (offset == 0)
+        return 0;
+    --offset;
+    while (offset > 0 && isContinuation(mDocument.at(offset)))
+        --offset;
+    return offset;
+}
+
+size_t TextArea::nextChar(size_t offset) const {
+    size_t length = mDocument.length();
+    if (offset >= length)
+        return length;
+    ++offset;
+    while (offset < length && isContinuation(mDocument.at(offset)))
+        ++offset;
+    return offset;
+}
+
+void TextArea::moveCaret(size_t offset, bool extend) {
+    mCaret = offset;
+    if (!extend)
+        mAnchor = offset;
+    mPreferredX = -1.f;
+    mScrollToCaret = true;
+    mDocument.closeUndoGroup();
+    markDirty();
+}
+
+void TextArea::replaceRange(size_t begin, size_t end, const std::string &text) {
+    mDocument.replace(begin, end - begin, text);
+    mCaret = mAnchor = begin + text.size();
+    mPreferredX = -1.f;
+    mScrollToCaret = true;
+    if (mCallback)
+        mCallback();
+    markDirty();
+}
+
+void TextArea::clampScroll() {
+    float maxX = std::max(0.f, mContentWidth + 1.f - viewWidth());
+    float maxY = std::max(0.f, mDocument.lineCount() * lineHeight() - viewHeight());
+    mScroll.x() = std::min(std::max(mScroll.x(), 0.f), maxX);
+    mScroll.y() = std::min(std::max(mScroll.y(), 0.f), maxY);
+}
+
+bool TextArea::copySelection() {
+    if (mAnchor == mCaret)
+        return false;
+    glfwSetClipboardString(screen()->glfwWindow(), selectedText().c_str());
+    return true;
+}
+
+void TextArea::pasteFromClipboard() {
+    const char *cbstr = glfwGetClipboardString(screen()->glfwWindow());
+    if (!cbstr)
+        return;
+    std::string text(cbstr);
+    text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+    insert(text);
+}
+
+bool TextArea::deleteSelection() {
+    if (mAnchor == mCaret)
+        return false;
+    insert(std::string());
+    return true;
+}
+
+bool TextArea::mouseButtonEvent(const Vector2i &p, int button, bool down,
+                                int modifiers) {
+    if (button != GLFW_MOUSE_BUTTON_1)
+        return Widget::mouseButtonEvent(p, button, down, modifiers);
+
+    if (!down) {
+        mDragScrollBar = false;
+        return true;
+    }
+    if (!mFocused)
+        requestFocus();
+
+    if (scrollBarVisible() && p.x() >= mPos.x() + mSize.x() - scrollBarWidth) {
+        mDragScrollBar = true;
+        return true;
+    }
+
+    size_t offset = hitTest(p);
+    double time = glfwGetTime();
+    if (time - mLastClick < 0.25) {
+        /* Double-click: select the line */
+        size_t line = mDocument.lineOf(offset);
+        mAnchor = mDocument.lineStart(line);
+        moveCaret(mDocument.lineEnd(line), true);
+    } else {
+        moveCaret(offset, modifiers & GLFW_MOD_SHIFT);
+    }
+    mLastClick = time;
+    return true;
+}
+
+bool TextArea::mouseDragEvent(const Vector2i &p, const Vector2i &rel,
+                              int /* button */, int /* modifiers */) {
+    if (mDragScrollBar) {
+        float contentHeight = mDocument.lineCount() * lineHeight();
+        float trackHeight = mSize.y() - 8.f;
+        float thumbHeight = scrollThumbHeight(trackHeight, viewHeight(), contentHeight);
+        if (trackHeight > thumbHeight)
+            mScroll.y() += rel.y() * (contentHeight - viewHeight()) /
+                           (trackHeight - thumbHeight);
+        clampScroll();
+        markDirty();
+    } else {
+        moveCaret(hitTest(p), true);
+    }
+    return true;
+}
+
+bool TextArea::scrollEvent(const Vector2i & /* p */, const Vector2f &rel) {
+    float step = 3 * lineHeight();
+    mScroll -= rel * step;
+    clampScroll();
+    markDirty();
+    return true;
+}
+
+bool TextArea::focusEvent(bool focused) {
+    Widget::focusEvent(focused);
+    mDocument.closeUndoGroup();
+    markDirty();
+    return true;
+}
+
+bool TextArea::keyboardEvent(int key, int /* scancode */, int action, int modifiers) {
+    if (!focused())
+        return false;
+    if (action != GLFW_PRESS && action != GLFW_REPEAT)
+        return true;
+
+    NVGcontext *ctx = screen()->nvgContext();
+    bool shift = (modifiers & GLFW_MOD_SHIFT) != 0;
+    bool command = (modifiers & SYSTEM_COMMAND_MOD) != 0;
+    size_t line = mDocument.lineOf(mCaret);
+    size_t length = mDocument.length();
+    size_t selBegin = std::min(mAnchor, mCaret), selEnd = std::max(mAnchor, mCaret);
+
+    if (key == GLFW_KEY_LEFT) {
+        moveCaret(!shift && selBegin != selEnd ? selBegin : prevChar(mCaret), shift);
+    } else if (key == GLFW_KEY_RIGHT) {
+        moveCaret(!shift && selBegin != selEnd ? selEnd : nextChar(mCaret), shift);
+    } else if (key == GLFW_KEY_UP || key == GLFW_KEY_DOWN ||
+               key == GLFW_KEY_PAGE_UP || key == GLFW_KEY_PAGE_DOWN) {
+        long pageLines = std::max(1l, (long) (viewHeight() / lineHeight()) - 1);
+        long delta = key == GLFW_KEY_UP ? -1 : key == GLFW_KEY_DOWN ? 1
+                   : key == GLFW_KEY_PAGE_UP ? -pageLines : pageLines;
+        long target = (long) line + delta;
+        float x = mPreferredX >= 0 ? mPreferredX : caretX(ctx, mCaret);
+
+        if (target < 0)
+            moveCaret(0, shift);
+        else if (target >= (long) mDocument.lineCount())
+            moveCaret(length, shift);
+        else
+            moveCaret(offsetAtX(ctx, (size_t) target, x), shift);
+        mPreferredX = x;
+
+        if (key == GLFW_KEY_PAGE_UP || key == GLFW_KEY_PAGE_DOWN) {
+            mScroll.y() += delta * lineHeight();
+            clampScroll();
+        }
+    } else if (key == GLFW_KEY_HOME) {
+        moveCaret(command ? 0 : mDocument.lineStart(line), shift);
+    } else if (key == GLFW_KEY_END) {
+        moveCaret(command ? length : mDocument.lineEnd(line), shift);
+    } else if (key == GLFW_KEY_BACKSPACE) {
+        if (mEditable && !deleteSelection() && mCaret > 0)
+            replaceRange(prevChar(mCaret), mCaret, std::string());
+    } else if (key == GLFW_KEY_DELETE) {
+        if (mEditable && !deleteSelection() && mCaret < length)
+            replaceRange(mCaret, nextChar(mCaret), std::string());
+    } else if (key == GLFW_KEY_ENTER || key == GLFW_KEY_KP_ENTER) {
+        if (mEditable)
+            insert("\n");
+    } else if (key == GLFW_KEY_A && command) {
+        mAnchor = 0;
+        moveCaret(length, true);
+    } else if (key == GLFW_KEY_C && command) {
+        copySelection();
+    } else if (key == GLFW_KEY_X && command) {
+        if (copySelection() && mEditable)
+            deleteSelection();
+    } else if (key == GLFW_KEY_V && command) {
+        if (mEditable)
+            pasteFromClipboard();
+    } else if (key == GLFW_KEY_Z && command) {
+        if (mEditable)
+            shift ? redo() : undo();
+    } else if (key == GLFW_KEY_Y && command) {
+        if (mEditable)
+            redo();
+    }
+
+    return true;
+}
+
+bool TextArea::keyboardCharacterEvent(unsigned int codepoint) {
+    if (mEditable && focused()) {
+        insert(utf8((int) codepoint).data());
+        return true;
+    }
+    return false;
+}
+
+Vector2i TextArea::preferredSize(NVGcontext *) const {
+    return Vector2i((int) (fontSize() * 20),
+                    (int) (lineHeight() * 8 + 2 * textPadding));
+}
+
+void TextArea::draw(NVGcontext *ctx) {
+    Widget::draw(ctx);
+
+    /* Background, as for text boxes */
+    bool editing = mEditable && focused();
+    const Skin *skin = mTheme->skin();
+    if (skin && skin->ready()) {
+        skin->draw(ctx, editing ? Skin::Element::TextBoxFocused
+                                : Skin::Element::TextBoxNormal,
+                   mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    } else {
+        NVGpaint bg = nvgBoxGradient(ctx,
+            mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
+            3, 4, editing ? Color(150, 32) : Color(255, 32), Color(32, 32));
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2,
+                       mSize.y() - 2, 3);
+        nvgFillPaint(ctx, bg);
+        nvgFill(ctx);
+
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, mPos.x() + 0.5f, mPos.y() + 0.5f, mSize.x() - 1,
+                       mSize.y() - 1, 2.5f);
+        nvgStrokeColor(ctx, Color(0, 48));
+        nvgStroke(ctx);
+    }
+
+    float lh = lineHeight();
+    size_t lineCount = mDocument.lineCount();
+
+    if (mScrollToCaret) {
+        mScrollToCaret = false;
+        size_t line = mDocument.lineOf(mCaret);
+        if (line * lh < mScroll.y())
+            mScroll.y() = line * lh;
+        else if ((line + 1) * lh > mScroll.y() + viewHeight())
+            mScroll.y() = (line + 1) * lh - viewHeight();
+        float x = caretX(ctx, mCaret);
+        if (x < mScroll.x())
+            mScroll.x() = x;
+        else if (x + 1 > mScroll.x() + viewWidth())
+            mScroll.x() = x + 1 - viewWidth();
+    }
+    clampScroll();
+
+    /* Only the visible lines are extracted, measured and drawn */
+    size_t first = std::min((size_t) (mScroll.y() / lh), lineCount - 1);
+    size_t last = std::min(lineCount, (size_t) ((mScroll.y() + viewHeight()) / lh) + 1);
+    float originX = mPos.x() + textPadding - mScroll.x();
+    float originY = mPos.y() + textPadding - mScroll.y();
+    float left = mScroll.x(), right = mScroll.x() + viewWidth();
+    size_t selBegin = std::min(mAnchor, mCaret), selEnd = std::max(mAnchor, mCaret);
+    Color textColor = mTextColor.w() > 0 ? mTextColor
+        : (mEnabled ? mTheme->mTextColor : mTheme->mDisabledTextColor);
+
+    PrimitiveBatch::save(ctx);
+    PrimitiveBatch::intersectScissor(ctx, mPos.x() + textPadding - 1.f, mPos.y() + 1.f,
+                        viewWidth() + 2.f, mSize.y() - 2.f);
+    nvgFontFace(ctx, mFont.c_str());
+    nvgFontSize(ctx, fontSize());
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+
+    for (size_t i = first; i < last; ++i) {
+        const LineLayout &layout = layoutLine(ctx, i);
+        size_t start = mDocument.lineStart(i);
+        size_t length = layout.x.size() - 1;
+        float y = originY + i * lh;
+
+        if (selBegin != selEnd && selBegin <= start + length && selEnd > start) {
+            float x0 = layout.x[std::max(selBegin, start) - start];
+            float x1 = layout.x[std::min(selEnd, start + length) - start];
+            if (selEnd > start + length)
+                x1 += fontSize() * 0.3f; /* the line break is selected */
+            nvgBeginPath(ctx);
+            nvgFillColor(ctx, nvgRGBA(255, 255, 255, 80));
+            nvgRect(ctx, originX + x0, y, x1 - x0, lh);
+            nvgFill(ctx);
+        }
+
+        /* Skip the characters that are scrolled out horizontally */
+        size_t a = (size_t) (std::upper_bound(layout.x.begin(), layout.x.end() - 1, left) -
+                             layout.x.begin());
+        a = a > 0 ? a - 1 : 0;
+        while (a > 0 && isContinuation(mDocument.at(start + a)))
+            --a;
+        size_t b = (size_t) (std::lower_bound(layout.x.begin(), layout.x.end(), right) -
+                             layout.x.begin());
+        b = std::min(b, length);
+        if (a < b) {
+            std::string text = mDocument.substr(start + a, b - a);
+            nvgFillColor(ctx, textColor);
+            nvgText(ctx, originX + layout.x[a], y + lh * 0.5f, text.data(),
+                    text.data() + text.size());
+        }
+
+        if (focused() && mCaret >= start && mCaret <= start + length) {
+            float x = originX + layout.x[mCaret - start];
+            nvgBeginPath(ctx);
+            nvgMoveTo(ctx, x, y + 1.f);
+            nvgLineTo(ctx, x, y + lh - 1.f);
+            nvgStrokeColor(ctx, nvgRGBA(255, 192, 0, 255));
+            nvgStrokeWidth(ctx, 1.0f);
+            nvgStroke(ctx);
+        }
+    }
+    PrimitiveBatch::restore(ctx);
+    trimLayoutCache(first, last);
+
+    if (!scrollBarVisible())
+        return;
+
+    float contentHeight = lineCount * lh;
+    float trackHeight = mSize.y() - 8.f;
+    float scrollh = scrollThumbHeight(trackHeight, viewHeight(), contentHeight);
+    float maxScroll = contentHeight - viewHeight();
+    float thumbY = mPos.y() + 4 + (trackHeight - scrollh) *
+        (maxScroll > 0 ? mScroll.y() / maxScroll : 0.f);
+
+    if (skin && skin->ready()) {
+        float x = mPos.x() + mSize.x() - 12;
+        skin->draw(ctx, Skin::Element::ScrollTrack, x, mPos.y() + 4, 8, trackHeight);
+        skin->draw(ctx, Skin::Element::ScrollThumb, x, thumbY, 8, scrollh);
+        return;
+    }
+
+    NVGpaint paint = nvgBoxGradient(
+        ctx, mPos.x() + mSize.x() - 12 + 1, mPos.y() + 4 + 1, 8,
+        trackHeight, 3, 4, Color(0, 32), Color(0, 92));
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, mPos.x() + mSize.x() - 12, mPos.y() + 4, 8,
+                   trackHeight, 3);
+    nvgFillPaint(ctx, paint);
+    nvgFill(ctx);
+
+    paint = nvgBoxGradient(
+        ctx, mPos.x() + mSize.x() - 12 - 1, thumbY - 1, 8, scrollh,
+        3, 4, Color(220, 100), Color(128, 100));
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, mPos.x() + mSize.x() - 12 + 1, thumbY + 1, 8 - 2,
+                   scrollh - 2, 2);
+    nvgFillPaint(ctx, paint);
+    nvgFill(ctx);
+}
+
+void TextArea::save(Serializer &s) const {
+    Widget::save(s);
+    s.set("value", mDocument.text());
+    s.set("editable", mEditable);
+    s.set("font", mFont);
+    s.set("textColor", mTextColor);
+}
+
+bool TextArea::load(Serializer &s) {
+    if (!Widget::load(s)) return false;
+    std::string value;
+    if (!s.get("value", value)) return false;
+    if (!s.get("editable", mEditable)) return false;
+    if (!s.get("font", mFont)) return false;
+    if (!s.get("textColor", mTextColor)) return false;
+    setValue(value);
+    return true;
+}
+
+NAMESPACE_END(nanogui)
@@ -17,12 +17,66 @@
 #include <nanogui/textbox.h>
 #include <nanogui/opengl.h>
 #include <nanogui/theme.h>
+#include <nanogui/primitives.h>
+#include <nanogui/skin.h>
 #include <nanogui/serializer/core.h>
+#include <algorithm>
 #include <regex>
 #include <iostream>
 
 NAMESPACE_BEGIN(nanogui)
 
+namespace {
+    /* Formats used by IntBox and FloatBox, which are checked without std::regex */
+    const char *signedIntegerFormat = "[-]?[0-9]*";
+    const char *unsignedIntegerFormat = "[0-9]*";
+    const char *floatFormat = "[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?";
+
+    /// Advance past a sequence of decimal digits and return its length
+    size_t skipDigits(const std::string &str, size_t &i) {
+        size_t start = i;
+        while (i < str.size() && str[i] >= '0' && str[i] <= '9')
+            ++i;
+        return i - start;
+    }
+
+    bool isSign(const std::string &str, size_t i) {
+        return i < str.size() && (str[i] == '-' || str[i] == '+');
+    }
+
+    /// Equivalent to matching "[-]?[0-9]*" (or "[0-9]*" if unsigned)
+    bool matchInteger(const std::string &str, bool allowSign) {
+        size_t i = 0;
+        if (allowSign && i < str.size() && str[i] == '-')
+            ++i;
+        skipDigits(str, i);
+        return i == str.size();
+    }
+
+    /// Equivalent to matching "[-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?"
+    bool matchFloat(const std::string &str) {
+        size_t i = 0;
+        if (isSign(str, i))
+            ++i;
+        size_t integerDigits = skipDigits(str, i);
+        if (i < str.size() && str[i] == '.') {
+            ++i;
+            if (skipDigits(str, i) == 0)
+                return false;
+        } else if (integerDigits == 0) {
+            return false;
+        }
+        if (i < str.size() && (str[i] == 'e' || str[i] == 'E')) {
+            ++i;
+            if (isSign(str, i))
+                ++i;
+            if (skipDigits(str, i) == 0)
+                return false;
+        }
+        return i == str.size();
+    }
+}
+
 TextBox::TextBox(Widget *parent,const std::string &value)
     : Widget(parent),
       mEditable(false),
@@ -43,7 +97,10 @@ TextBox::TextBox(Widget *parent,const std::string &value)
       mMouseDragPos(Vector2i(-1,-1)),
       mMouseDownModifier(0),
       mTextOffset(0),
-      mLastClick(0) {
+      mLastClick(0),
+      mGlyphFontSize(0),
+      mGlyphAlignment(Alignment::Center),
+      mGlyphLineHeight(0) {
     if (mTheme) mFontSize = mTheme->mTextBoxFontSize;
     mIconExtraScale = 0.8f;// widget override
 }
@@ -53,6 +110,11 @@ void TextBox::setEditable(bool editable) {
     setCursor(editable ? Cursor::IBeam : Cursor::Arrow);
 }
 
+void TextBox::setFormat(const std::string &format) {
+    mValidator = compileFormat(format);
+    mFormat = format;
+}
+
 void TextBox::setTheme(Theme *theme) {
     Widget::setTheme(theme);
     if (mTheme)
@@ -84,34 +146,45 @@ Vector2i TextBox::preferredSize(NVGcontext *ctx) const {
 void TextBox::draw(NVGcontext* ctx) {
     Widget::draw(ctx);
 
-    NVGpaint bg = nvgBoxGradient(ctx,
-        mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
-        3, 4, Color(255, 32), Color(32, 32));
-    NVGpaint fg1 = nvgBoxGradient(ctx,
-        mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
-        3, 4, Color(150, 32), Color(32, 32));
-    NVGpaint fg2 = nvgBoxGradient(ctx,
-        mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
-        3, 4, nvgRGBA(255, 0, 0, 100), nvgRGBA(255, 0, 0, 50));
-
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2,
-                   mSize.y() - 2, 3);
-
-    if (mEditable && focused())
-        mValidFormat ? nvgFillPaint(ctx, fg1) : nvgFillPaint(ctx, fg2);
-    else if (mSpinnable && mMouseDownPos.x() != -1)
-        nvgFillPaint(ctx, fg1);
-    else
-        nvgFillPaint(ctx, bg);
+    const Skin *skin = mTheme->skin();
+    if (skin && skin->ready()) {
+        Skin::Element element = Skin::Element::TextBoxNormal;
+        if (mEditable && focused())
+            element = mValidFormat ? Skin::Element::TextBoxFocused
+                                   : Skin::Element::TextBoxInvalid;
+        else if (mSpinnable && mMouseDownPos.x() != -1)
+            element = Skin::Element::TextBoxFocused;
+        skin->draw(ctx, element, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    } else {
+        NVGpaint bg = nvgBoxGradient(ctx,
+            mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
+            3, 4, Color(255, 32), Color(32, 32));
+        NVGpaint fg1 = nvgBoxGradient(ctx,
+            mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
+            3, 4, Color(150, 32), Color(32, 32));
+        NVGpaint fg2 = nvgBoxGradient(ctx,
+            mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2, mSize.y() - 2,
+            3, 4, nvgRGBA(255, 0, 0, 100), nvgRGBA(255, 0, 0, 50));
+
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, mPos.x() + 1, mPos.y() + 1 + 1.0f, mSize.x() - 2,
+                       mSize.y() - 2, 3);
+
+        if (mEditable && focused())
+            mValidFormat ? nvgFillPaint(ctx, fg1) : nvgFillPaint(ctx, fg2);
+        else if (mSpinnable && mMouseDownPos.x() != -1)
+            nvgFillPaint(ctx, fg1);
+        else
+            nvgFillPaint(ctx, bg);
 
-    nvgFill(ctx);
+        nvgFill(ctx);
 
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x() + 0.5f, mPos.y() + 0.5f, mSize.x() - 1,
-                   mSize.y() - 1, 2.5f);
-    nvgStrokeColor(ctx, Color(0, 48));
-    nvgStroke(ctx);
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, mPos.x() + 0.5f, mPos.y() + 0.5f, mSize.x() - 1,
+                       mSize.y() - 1, 2.5f);
+        nvgStrokeColor(ctx, Color(0, 48));
+        nvgStroke(ctx);
+    }
 
     nvgFontSize(ctx, fontSize());
     nvgFontFace(ctx, "sans");
@@ -204,8 +277,8 @@ void TextBox::draw(NVGcontext* ctx) {
     float clipWidth = mSize.x() - unitWidth - spinArrowsWidth - 2 * xSpacing + 2.0f;
     float clipHeight = mSize.y() - 3.0f;
 
-    nvgSave(ctx);
-    nvgIntersectScissor(ctx, clipX, clipY, clipWidth, clipHeight);
+    PrimitiveBatch::save(ctx);
+    PrimitiveBatch::intersectScissor(ctx, clipX, clipY, clipWidth, clipHeight);
 
     Vector2i oldDrawPos(drawPos);
     drawPos.x() += mTextOffset;
@@ -213,24 +286,17 @@ void TextBox::draw(NVGcontext* ctx) {
     if (mCommitted) {
         nvgText(ctx, drawPos.x(), drawPos.y(), mValue.c_str(), nullptr);
     } else {
-        const int maxGlyphs = 1024;
-        NVGglyphPosition glyphs[maxGlyphs];
-        float textBound[4];
-        nvgTextBounds(ctx, drawPos.x(), drawPos.y(), mValueTemp.c_str(),
-                      nullptr, textBound);
-        float lineh = textBound[3] - textBound[1];
-
-        // find cursor positions
-        int nglyphs =
-            nvgTextGlyphPositions(ctx, drawPos.x(), drawPos.y(),
-                                  mValueTemp.c_str(), nullptr, glyphs, maxGlyphs);
-        updateCursor(ctx, textBound[2], glyphs, nglyphs);
+        // find cursor positions (only measured again when the text changes)
+        updateGlyphPositions(ctx);
+        float lineh = mGlyphLineHeight;
+        int nglyphs = (int) mGlyphX.size() - 1;
+        updateCursor(ctx, drawPos.x());
 
         // compute text offset
         int prevCPos = mCursorPos > 0 ? mCursorPos - 1 : 0;
         int nextCPos = mCursorPos < nglyphs ? mCursorPos + 1 : nglyphs;
-        float prevCX = cursorIndex2Position(prevCPos, textBound[2], glyphs, nglyphs);
-        float nextCX = cursorIndex2Position(nextCPos, textBound[2], glyphs, nglyphs);
+        float prevCX = cursorIndex2Position(prevCPos, drawPos.x());
+        float nextCX = cursorIndex2Position(nextCPos, drawPos.x());
 
         if (nextCX > clipX + clipWidth)
             mTextOffset -= nextCX - (clipX + clipWidth) + 1;
@@ -241,19 +307,11 @@ void TextBox::draw(NVGcontext* ctx) {
 
         // draw text with offset
         nvgText(ctx, drawPos.x(), drawPos.y(), mValueTemp.c_str(), nullptr);
-        nvgTextBounds(ctx, drawPos.x(), drawPos.y(), mValueTemp.c_str(),
-                      nullptr, textBound);
-
-        // recompute cursor positions
-        nglyphs = nvgTextGlyphPositions(ctx, drawPos.x(), drawPos.y(),
-                mValueTemp.c_str(), nullptr, glyphs, maxGlyphs);
 
         if (mCursorPos > -1) {
             if (mSelectionPos > -1) {
-                float caretx = cursorIndex2Position(mCursorPos, textBound[2],
-                                                    glyphs, nglyphs);
-                float selx = cursorIndex2Position(mSelectionPos, textBound[2],
-                                                  glyphs, nglyphs);
+                float caretx = cursorIndex2Position(mCursorPos, drawPos.x());
+                float selx = cursorIndex2Position(mSelectionPos, drawPos.x());
 
                 if (caretx > selx)
                     std::swap(caretx, selx);
@@ -266,7 +324,7 @@ void TextBox::draw(NVGcontext* ctx) {
                 nvgFill(ctx);
             }
 
-            float caretx = cursorIndex2Position(mCursorPos, textBound[2], glyphs, nglyphs);
+            float caretx = cursorIndex2Position(mCursorPos, drawPos.x());
 
             // draw cursor
             nvgBeginPath(ctx);
@@ -277,7 +335,7 @@ void TextBox::draw(NVGcontext* ctx) {
             nvgStroke(ctx);
         }
     }
-    nvgRestore(ctx);
+    PrimitiveBatch::restore(ctx);
 }
 
 bool TextBox::mouseButtonEvent(const Vector2i &p, int button, bool down,
@@ -392,7 +450,7 @@ bool TextBox::focusEvent(bool focused) {
             mTextOffset = 0;
         }
 
-        mValidFormat = (mValueTemp == "") || checkFormat(mValueTemp, mFormat);
+        mValidFormat = mValueTemp.empty() || validate(mValueTemp);
     }
 
     return true;
@@ -401,6 +459,7 @@ bool TextBox::focusEvent(bool focused) {
 bool TextBox::keyboardEvent(int key, int /* scancode */, int action, int modifiers) {
     if (mEditable && focused()) {
         if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+            bool edited = false;
             if (key == GLFW_KEY_LEFT) {
                 if (modifiers == GLFW_MOD_SHIFT) {
                     if (mSelectionPos == -1)
@@ -440,6 +499,7 @@ bool TextBox::keyboardEvent(int key, int /* scancode */, int action, int modifie
 
                 mCursorPos = (int) mValueTemp.size();
             } else if (key == GLFW_KEY_BACKSPACE) {
+                edited = true;
                 if (!deleteSelection()) {
                     if (mCursorPos > 0) {
                         mValueTemp.erase(mValueTemp.begin() + mCursorPos - 1);
@@ -447,6 +507,7 @@ bool TextBox::keyboardEvent(int key, int /* scancode */, int action, int modifie
                     }
                 }
             } else if (key == GLFW_KEY_DELETE) {
+                edited = true;
                 if (!deleteSelection()) {
                     if (mCursorPos < (int) mValueTemp.length())
                         mValueTemp.erase(mValueTemp.begin() + mCursorPos);
@@ -459,16 +520,17 @@ bool TextBox::keyboardEvent(int key, int /* scancode */, int action, int modifie
                 mSelectionPos = 0;
             } else if (key == GLFW_KEY_X && modifiers == SYSTEM_COMMAND_MOD) {
                 copySelection();
-                deleteSelection();
+                edited = deleteSelection();
             } else if (key == GLFW_KEY_C && modifiers == SYSTEM_COMMAND_MOD) {
                 copySelection();
             } else if (key == GLFW_KEY_V && modifiers == SYSTEM_COMMAND_MOD) {
                 deleteSelection();
                 pasteFromClipboard();
+                edited = true;
             }
 
-            mValidFormat =
-                (mValueTemp == "") || checkFormat(mValueTemp, mFormat);
+            if (edited)
+                mValidFormat = mValueTemp.empty() || validate(mValueTemp);
         }
 
         return true;
@@ -486,7 +548,7 @@ bool TextBox::keyboardCharacterEvent(unsigned int codepoint) {
         mValueTemp.insert(mCursorPos, convert.str());
         mCursorPos++;
 
-        mValidFormat = (mValueTemp == "") || checkFormat(mValueTemp, mFormat);
+        mValidFormat = mValueTemp.empty() || validate(mValueTemp);
 
         return true;
     }
@@ -495,15 +557,35 @@ bool TextBox::keyboardCharacterEvent(unsigned int codepoint) {
 }
 
 bool TextBox::checkFormat(const std::string &input, const std::string &format) {
+    if (format == mFormat)
+        return validate(input);
+    Validator validator = compileFormat(format);
+    return !validator || validator(input);
+}
+
+bool TextBox::validate(const std::string &input) const {
+    return !mValidator || mValidator(input);
+}
+
+TextBox::Validator TextBox::compileFormat(const std::string &format) {
     if (format.empty())
-        return true;
+        return Validator();
+    if (format == signedIntegerFormat)
+        return [](const std::string &input) { return matchInteger(input, true); };
+    if (format == unsignedIntegerFormat)
+        return [](const std::string &input) { return matchInteger(input, false); };
+    if (format == floatFormat)
+        return matchFloat;
     try {
-        std::regex regex(format);
-        return regex_match(input, regex);
+        auto regex = std::make_shared<std::regex>(
+            format, std::regex::ECMAScript | std::regex::optimize);
+        return [regex](const std::string &input) {
+            return std::regex_match(input, *regex);
+        };
     } catch (const std::regex_error &) {
 #if __GNUC__ < 4 || (__GNUC__ == 4 && __GNUC_MINOR__ < 9)
         std::cerr << "Warning: cannot validate text field due to lacking regular expression support. please compile with GCC >= 4.9" << std::endl;
-        return true;
+        return Validator();
 #else
         throw;
 #endif
@@ -561,8 +643,30 @@ bool TextBox::deleteSelection() {
     return false;
 }
 
-void TextBox::updateCursor(NVGcontext *, float lastx,
-                           const NVGglyphPosition *glyphs, int size) {
+void TextBox::updateGlyphPositions(NVGcontext *ctx) {
+    if (!mGlyphX.empty() && mGlyphText == mValueTemp &&
+        mGlyphFontSize == fontSize() && mGlyphAlignment == mAlignment)
+        return;
+
+    /* Measured at the origin, using the font and alignment set up by draw() */
+    std::vector<NVGglyphPosition> glyphs(mValueTemp.size());
+    float textBound[4];
+    nvgTextBounds(ctx, 0, 0, mValueTemp.c_str(), nullptr, textBound);
+    int nglyphs = glyphs.empty() ? 0 :
+        nvgTextGlyphPositions(ctx, 0, 0, mValueTemp.c_str(), nullptr,
+                              glyphs.data(), (int) glyphs.size());
+
+    mGlyphX.resize(nglyphs + 1);
+    for (int i = 0; i < nglyphs; ++i)
+        mGlyphX[i] = glyphs[i].x;
+    mGlyphX[nglyphs] = textBound[2];
+    mGlyphLineHeight = textBound[3] - textBound[1];
+    mGlyphText = mValueTemp;
+    mGlyphFontSize = (float) fontSize();
+    mGlyphAlignment = mAlignment;
+}
+
+void TextBox::updateCursor(NVGcontext *, float originX) {
     // handle mouse cursor events
     if (mMouseDownPos.x() != -1) {
         if (mMouseDownModifier == GLFW_MOD_SHIFT) {
@@ -571,51 +675,40 @@ void TextBox::updateCursor(NVGcontext *, float lastx,
         } else
             mSelectionPos = -1;
 
-        mCursorPos =
-            position2CursorIndex(mMouseDownPos.x(), lastx, glyphs, size);
+        mCursorPos = position2CursorIndex(mMouseDownPos.x(), originX);
 
         mMouseDownPos = Vector2i(-1, -1);
     } else if (mMouseDragPos.x() != -1) {
         if (mSelectionPos == -1)
             mSelectionPos = mCursorPos;
 
-        mCursorPos =
-            position2CursorIndex(mMouseDragPos.x(), lastx, glyphs, size);
+        mCursorPos = position2CursorIndex(mMouseDragPos.x(), originX);
     } else {
         // set cursor to last character
         if (mCursorPos == -2)
-            mCursorPos = size;
+            mCursorPos = (int) mGlyphX.size() - 1;
     }
 
     if (mCursorPos == mSelectionPos)
         mSelectionPos = -1;
 }
 
-float TextBox::cursorIndex2Position(int index, float lastx,
-                                    const NVGglyphPosition *glyphs, int size) {
-    float pos = 0;
-    if (index == size)
-        pos = lastx; // last character
-    else
-        pos = glyphs[index].x;
-
-    return pos;
+float TextBox::cursorIndex2Position(int index, float originX) const {
+    // the last entry holds the position behind the last character
+    index = std::min(std::max(index, 0), (int) mGlyphX.size() - 1);
+    return originX + mGlyphX[index];
 }
 
-int TextBox::position2CursorIndex(float posx, float lastx,
-                                  const NVGglyphPosition *glyphs, int size) {
-    int mCursorId = 0;
-    float caretx = glyphs[mCursorId].x;
-    for (int j = 1; j < size; j++) {
-        if (std::abs(caretx - posx) > std::abs(glyphs[j].x - posx)) {
-            mCursorId = j;
-            caretx = glyphs[mCursorId].x;
-        }
-    }
-    if (std::abs(caretx - posx) > std::abs(lastx - posx))
-        mCursorId = size;
-
-    return mCursorId;
+int TextBox::position2CursorIndex(float posx, float originX) const {
+    // the caret positions increase monotonically: search for the closest one
+    float x = posx - originX;
+    int index = (int) (std::lower_bound(mGlyphX.begin(), mGlyphX.end(), x) -
+                       mGlyphX.begin());
+    if (index == (int) mGlyphX.size())
+        return index - 1;
+    if (index > 0 && std::abs(mGlyphX[index - 1] - x) <= std::abs(mGlyphX[index] - x))
+        --index;
+    return index;
 }
 
 TextBox::SpinArea TextBox::spinArea(const Vector2i & pos) {
@@ -655,7 +748,10 @@ bool TextBox::load(Serializer &s) {
     if (!s.get("defaultValue", mDefaultValue)) return false;
     if (!s.get("alignment", mAlignment)) return false;
     if (!s.get("units", mUnits)) return false;
-    if (!s.get("format", mFormat)) return false;
+    std::string format;
+    if (!s.get("format", format)) return false;
+    if (format != mFormat)
+        setFormat(format);
     if (!s.get("unitsImage", mUnitsImage)) return false;
     if (!s.get("validFormat", mValidFormat)) return false;
     if (!s.get("valueTemp", mValueTemp)) return false;
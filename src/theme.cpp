@@ -12,13 +12,19 @@
 */
 
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
 #include <nanogui/opengl.h>
 #include <nanogui/entypo.h>
 #include <nanogui_resources.h>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
-Theme::Theme(NVGcontext *ctx) {
+/* Themes that currently have a skin, so that the screen does not have to
+   search its widget tree for them every frame */
+static std::vector<Theme *> __nanogui_skinned_themes;
+
+Theme::Theme(NVGcontext *ctx) : mContext(ctx) {
     mStandardFontSize                 = 16;
     mButtonFontSize                   = 20;
     mTextBoxFontSize                  = 20;
@@ -90,4 +96,26 @@ Theme::Theme(NVGcontext *ctx) {
         throw std::runtime_error("Could not load fonts!");
 }
 
+Theme::~Theme() {
+    setSkin(nullptr);
+}
+
+void Theme::setSkin(Skin *skin) {
+    auto &themes = __nanogui_skinned_themes;
+    auto it = std::find(themes.begin(), themes.end(), this);
+    if (skin && it == themes.end())
+        themes.push_back(this);
+    else if (!skin && it != themes.end())
+        themes.erase(it);
+    mSkin = skin;
+}
+
+std::vector<Theme *> Theme::skinnedThemes(NVGcontext *ctx) {
+    std::vector<Theme *> result;
+    for (Theme *theme : __nanogui_skinned_themes)
+        if (theme->mContext == ctx)
+            result.push_back(theme);
+    return result;
+}
+
 NAMESPACE_END(nanogui)
@@ -12,16 +12,27 @@
 
 #include <nanogui/vscrollpanel.h>
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
 #include <nanogui/serializer/core.h>
+#include <cmath>
 
 NAMESPACE_BEGIN(nanogui)
 
+/* Decay rate of the scroll velocity (1/s). A scroll wheel step travels the
+   same total distance as without smooth scrolling. */
+static const float scrollFriction = 12.0f;
+
 VScrollPanel::VScrollPanel(Widget *parent)
-    : Widget(parent), mChildPreferredHeight(0), mScroll(0.0f), mUpdateLayout(false) { }
+    : Widget(parent), mChildPreferredHeight(0), mScroll(0.0f), mUpdateLayout(true),
+      mLayoutSize(Vector2i::Zero()), mSmoothScrolling(true),
+      mScrollVelocity(0.0f), mLastScrollTime(0.0) { }
 
 void VScrollPanel::performLayout(NVGcontext *ctx) {
     Widget::performLayout(ctx);
+    mUpdateLayout = false;
+    mLayoutSize = mSize;
 
     if (mChildren.empty())
         return;
@@ -56,7 +67,8 @@ bool VScrollPanel::mouseDragEvent(const Vector2i &p, const Vector2i &rel,
 
         mScroll = std::max((float) 0.0f, std::min((float) 1.0f,
                      mScroll + rel.y() / (float)(mSize.y() - 8 - scrollh)));
-        mUpdateLayout = true;
+        mScrollVelocity = 0.0f;
+        markDirty();
         return true;
     } else {
         return Widget::mouseDragEvent(p, rel, button, modifiers);
@@ -69,37 +81,85 @@ bool VScrollPanel::scrollEvent(const Vector2i &p, const Vector2f &rel) {
         float scrollh = height() *
             std::min(1.0f, height() / (float)mChildPreferredHeight);
 
-        mScroll = std::max((float) 0.0f, std::min((float) 1.0f,
-                mScroll - scrollAmount / (float)(mSize.y() - 8 - scrollh)));
-        mUpdateLayout = true;
+        float delta = -scrollAmount / (float)(mSize.y() - 8 - scrollh);
+
+        if (mSmoothScrolling) {
+            /* Reversing the direction cancels the remaining motion */
+            if (mScrollVelocity == 0.0f)
+                mLastScrollTime = glfwGetTime();
+            else if ((mScrollVelocity < 0.0f) != (delta < 0.0f))
+                mScrollVelocity = 0.0f;
+            mScrollVelocity += delta * scrollFriction;
+        } else {
+            mScroll = std::max((float) 0.0f, std::min((float) 1.0f, mScroll + delta));
+        }
+        markDirty();
         return true;
     } else {
         return Widget::scrollEvent(p, rel);
     }
 }
 
+void VScrollPanel::updateScrollMotion() {
+    if (mScrollVelocity == 0.0f)
+        return;
+
+    double now = glfwGetTime();
+    float dt = (float) std::min(now - mLastScrollTime, 0.1);
+    float decay = std::exp(-scrollFriction * dt);
+    mLastScrollTime = now;
+
+    mScroll += mScrollVelocity * (1.0f - decay) / scrollFriction;
+    mScrollVelocity *= decay;
+
+    /* Stop at either end, or once slower than a pixel per second */
+    float range = (float) (mChildPreferredHeight - mSize.y());
+    if (mScroll <= 0.0f || mScroll >= 1.0f || range <= 0.0f ||
+        std::abs(mScrollVelocity) * range < 1.0f) {
+        mScroll = std::max(0.0f, std::min(1.0f, mScroll));
+        mScrollVelocity = 0.0f;
+    } else {
+        /* Invalidate enclosing caches and wake up the main loop for the next frame */
+        markDirty();
+        glfwPostEmptyEvent();
+    }
+}
+
 void VScrollPanel::draw(NVGcontext *ctx) {
     if (mChildren.empty())
         return;
     Widget *child = mChildren[0];
+
+    /* Scrolling only moves the child; it is laid out again when needed */
+    if (mUpdateLayout || mSize != mLayoutSize)
+        performLayout(ctx);
+    updateScrollMotion();
+
     child->setPosition(Vector2i(0, -mScroll*(mChildPreferredHeight - mSize.y())));
-    mChildPreferredHeight = child->preferredSize(ctx).y();
     float scrollh = height() *
         std::min(1.0f, height() / (float) mChildPreferredHeight);
 
-    if (mUpdateLayout)
-        child->performLayout(ctx);
-
-    nvgSave(ctx);
+    PrimitiveBatch::save(ctx);
     nvgTranslate(ctx, mPos.x(), mPos.y());
-    nvgIntersectScissor(ctx, 0, 0, mSize.x(), mSize.y());
+    PrimitiveBatch::intersectScissor(ctx, 0, 0, mSize.x(), mSize.y());
     if (child->visible())
         child->draw(ctx);
-    nvgRestore(ctx);
+    PrimitiveBatch::restore(ctx);
 
     if (mChildPreferredHeight <= mSize.y())
         return;
 
+    const Skin *skin = mTheme->skin();
+    if (skin && skin->ready()) {
+        float x = mPos.x() + mSize.x() - 12;
+        skin->draw(ctx, Skin::Element::ScrollTrack, x, mPos.y() + 4, 8,
+                   mSize.y() - 8);
+        skin->draw(ctx, Skin::Element::ScrollThumb, x,
+                   mPos.y() + 4 + (mSize.y() - 8 - scrollh) * mScroll, 8,
+                   scrollh);
+        return;
+    }
+
     NVGpaint paint = nvgBoxGradient(
         ctx, mPos.x() + mSize.x() - 12 + 1, mPos.y() + 4 + 1, 8,
         mSize.y() - 8, 3, 4, Color(0, 32), Color(0, 92));
@@ -14,17 +14,52 @@
 #include <nanogui/theme.h>
 #include <nanogui/window.h>
 #include <nanogui/opengl.h>
+#include <nanogui/glutil.h>
 #include <nanogui/screen.h>
+#include <nanogui/primitives.h>
 #include <nanogui/serializer/core.h>
+#include <algorithm>
+#include <limits>
 
 NAMESPACE_BEGIN(nanogui)
 
+namespace {
+    /* Axis-aligned rectangle in device coordinates (x0, y0, x1, y1) */
+    struct ClipRect {
+        float x0, y0, x1, y1;
+        bool valid;
+    };
+
+    /* Conservative bounds of the scissor rectangle that applies to the widget
+       currently being drawn. Invalid outside of Widget::draw(), e.g. for the
+       root of a frame. */
+    ClipRect currentClip = { 0.f, 0.f, 0.f, 0.f, false };
+
+    /* Device space bounds of a rectangle under the transform ``xform`` */
+    ClipRect deviceBounds(const float *xform, float x, float y, float w, float h) {
+        ClipRect r = { std::numeric_limits<float>::infinity(),
+                       std::numeric_limits<float>::infinity(),
+                       -std::numeric_limits<float>::infinity(),
+                       -std::numeric_limits<float>::infinity(), true };
+        for (int i = 0; i < 4; ++i) {
+            float px = x + ((i & 1) ? w : 0.f), py = y + ((i & 2) ? h : 0.f);
+            float tx = xform[0] * px + xform[2] * py + xform[4],
+                  ty = xform[1] * px + xform[3] * py + xform[5];
+            r.x0 = std::min(r.x0, tx); r.x1 = std::max(r.x1, tx);
+            r.y0 = std::min(r.y0, ty); r.y1 = std::max(r.y1, ty);
+        }
+        return r;
+    }
+}
+
 Widget::Widget(Widget *parent)
     : mParent(nullptr), mTheme(nullptr), mLayout(nullptr),
       mPos(Vector2i::Zero()), mSize(Vector2i::Zero()),
       mFixedSize(Vector2i::Zero()), mVisible(true), mEnabled(true),
       mFocused(false), mMouseFocus(false), mTooltip(""), mFontSize(-1.0f),
-      mIconExtraScale(1.0f), mCursor(Cursor::Arrow) {
+      mIconExtraScale(1.0f), mCursor(Cursor::Arrow), mCached(false),
+      mCacheMargin(0), mStateVersion(0), mCacheVersion(0),
+      mCachePixelRatio(0.f), mCacheTarget(nullptr) {
     if (parent)
         parent->addChild(this);
 }
@@ -34,6 +69,10 @@ Widget::~Widget() {
         if (child)
             child->decRef();
     }
+    if (mCacheTarget) {
+        mCacheTarget->free();
+        delete mCacheTarget;
+    }
 }
 
 void Widget::setTheme(Theme *theme) {
@@ -42,6 +81,23 @@ void Widget::setTheme(Theme *theme) {
     mTheme = theme;
     for (auto child : mChildren)
         child->setTheme(theme);
+    markDirty();
+}
+
+void Widget::setCached(bool cached, int margin) {
+    mCached = cached;
+    mCacheMargin = margin;
+    if (!cached && mCacheTarget) {
+        mCacheTarget->free();
+        delete mCacheTarget;
+        mCacheTarget = nullptr;
+    }
+    markDirty();
+}
+
+void Widget::markDirty() {
+    for (Widget *widget = this; widget; widget = widget->mParent)
+        widget->mStateVersion++;
 }
 
 int Widget::fontSize() const {
@@ -145,6 +201,7 @@ void Widget::addChild(int index, Widget * widget) {
     widget->incRef();
     widget->setParent(this);
     widget->setTheme(mTheme);
+    markDirty();
 }
 
 void Widget::addChild(Widget * widget) {
@@ -154,12 +211,14 @@ void Widget::addChild(Widget * widget) {
 void Widget::removeChild(const Widget *widget) {
     mChildren.erase(std::remove(mChildren.begin(), mChildren.end(), widget), mChildren.end());
     widget->decRef();
+    markDirty();
 }
 
 void Widget::removeChild(int index) {
     Widget *widget = mChildren[index];
     mChildren.erase(mChildren.begin() + index);
     widget->decRef();
+    markDirty();
 }
 
 int Widget::childIndex(Widget *widget) const {
@@ -214,19 +273,92 @@ void Widget::draw(NVGcontext *ctx) {
     if (mChildren.empty())
         return;
 
+    /* Overlapping top-level windows are separated by a split of the primitive
+       batch, which draws their primitives above the NanoVG content of the
+       windows behind */
+    PrimitiveBatch *batch = mParent ? nullptr : PrimitiveBatch::active(ctx);
+
     nvgSave(ctx);
     nvgTranslate(ctx, mPos.x(), mPos.y());
+
+    float xform[6];
+    nvgCurrentTransform(ctx, xform);
+    bool axisAligned = xform[1] == 0.f && xform[2] == 0.f;
+    const ClipRect clip = currentClip;
+
     for (auto child : mChildren) {
-        if (child->visible()) {
-            nvgSave(ctx);
-            nvgIntersectScissor(ctx, child->mPos.x(), child->mPos.y(), child->mSize.x(), child->mSize.y());
-            child->draw(ctx);
-            nvgRestore(ctx);
+        if (!child->visible())
+            continue;
+
+        /* Skip children that lie entirely outside of the visible area
+           (layered children also draw their margin, e.g. a drop shadow,
+           so their clip rectangle is expanded by it) */
+        float m = child->mCached ? (float) child->mCacheMargin : 0.f;
+        float cx = child->mPos.x() - m, cy = child->mPos.y() - m,
+              cw = child->mSize.x() + 2 * m, ch = child->mSize.y() + 2 * m;
+        ClipRect bounds = deviceBounds(xform, cx, cy, cw, ch);
+        if (clip.valid &&
+            (bounds.x1 <= clip.x0 || bounds.x0 >= clip.x1 ||
+             bounds.y1 <= clip.y0 || bounds.y0 >= clip.y1))
+            continue;
+
+        /* Intersecting is a no-op if the child covers the visible area */
+        bool covers = clip.valid && axisAligned &&
+                      bounds.x0 <= clip.x0 && bounds.y0 <= clip.y0 &&
+                      bounds.x1 >= clip.x1 && bounds.y1 >= clip.y1;
+
+        if (batch) {
+            /* Include the drop shadow, which is drawn outside of the window */
+            float ds = child->theme() ? (float) child->theme()->mWindowDropShadowSize : 0.f;
+            ds = std::max(ds - m, 0.f);
+            if (batch->layer(cx - ds, cy - ds, cw + 2 * ds, ch + 2 * ds)) {
+                nvgSave(ctx);
+                nvgTranslate(ctx, mPos.x(), mPos.y());
+            }
+        }
+
+        PrimitiveBatch::save(ctx);
+        if (covers) {
+            currentClip = clip;
+        } else {
+            PrimitiveBatch::intersectScissor(ctx, cx, cy, cw, ch);
+            currentClip = bounds;
+            if (clip.valid) {
+                currentClip.x0 = std::max(bounds.x0, clip.x0);
+                currentClip.y0 = std::max(bounds.y0, clip.y0);
+                currentClip.x1 = std::max(currentClip.x0, std::min(bounds.x1, clip.x1));
+                currentClip.y1 = std::max(currentClip.y0, std::min(bounds.y1, clip.y1));
+            }
         }
+        if (child->mCached)
+            child->drawCached(ctx);
+        else
+            child->draw(ctx);
+        PrimitiveBatch::restore(ctx);
+        currentClip = clip;
     }
     nvgRestore(ctx);
 }
 
+void Widget::drawCached(NVGcontext *ctx) {
+    /* The cache is (re-)rendered by Screen::drawWidgets() before the frame starts */
+    if (!mCacheTarget || !mCacheTarget->ready()) {
+        draw(ctx);
+        return;
+    }
+
+    int image = screen()->textureImage(mCacheTarget->texture().texture(), mCacheTarget->size(),
+                                       NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+    float x = mPos.x() - mCacheMargin, y = mPos.y() - mCacheMargin,
+          w = mSize.x() + 2 * mCacheMargin, h = mSize.y() + 2 * mCacheMargin;
+
+    /* The parent's scissor already includes the margin (see draw()) */
+    nvgBeginPath(ctx);
+    nvgRect(ctx, x, y, w, h);
+    nvgFillPaint(ctx, nvgImagePattern(ctx, x, y, w, h, 0.0f, image, 1.0f));
+    nvgFill(ctx);
+}
+
 void Widget::save(Serializer &s) const {
     s.set("position", mPos);
     s.set("size", mSize);
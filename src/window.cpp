@@ -11,6 +11,8 @@
 
 #include <nanogui/window.h>
 #include <nanogui/theme.h>
+#include <nanogui/skin.h>
+#include <nanogui/primitives.h>
 #include <nanogui/opengl.h>
 #include <nanogui/screen.h>
 #include <nanogui/layout.h>
@@ -19,7 +21,7 @@
 NAMESPACE_BEGIN(nanogui)
 
 Window::Window(Widget *parent, const std::string &title)
-    : Widget(parent), mTitle(title), mButtonPanel(nullptr), mModal(false), mDrag(false) { }
+    : Widget(parent), mTitle(title), mButtonPanel(nullptr), mModal(false), mDrag(false), mOpacity(1.0f) { }
 
 Vector2i Window::preferredSize(NVGcontext *ctx) const {
     if (mButtonPanel)
@@ -67,59 +69,77 @@ void Window::draw(NVGcontext *ctx) {
     int ds = mTheme->mWindowDropShadowSize, cr = mTheme->mWindowCornerRadius;
     int hh = mTheme->mWindowHeaderHeight;
 
-    /* Draw window */
-    nvgSave(ctx);
-    nvgBeginPath(ctx);
-    nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr);
+    /* Layered windows apply the opacity when compositing */
+    bool fade = mOpacity < 1.0f && !mCached;
+    if (fade) {
+        PrimitiveBatch::save(ctx);
+        PrimitiveBatch::globalAlpha(ctx, mOpacity);
+    }
 
-    nvgFillColor(ctx, mMouseFocus ? mTheme->mWindowFillFocused
-                                  : mTheme->mWindowFillUnfocused);
-    nvgFill(ctx);
+    const Skin *skin = mTheme->skin();
+    bool skinned = skin && skin->ready();
 
+    /* Draw window */
+    nvgSave(ctx);
+    if (skinned) {
+        skin->draw(ctx, mMouseFocus ? Skin::Element::WindowFillFocused
+                                    : Skin::Element::WindowFill,
+                   mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    } else {
+        PrimitiveBatch::fillRoundedRect(
+            ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr,
+            mMouseFocus ? mTheme->mWindowFillFocused
+                        : mTheme->mWindowFillUnfocused);
+    }
 
     /* Draw a drop shadow */
-    NVGpaint shadowPaint = nvgBoxGradient(
-        ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr*2, ds*2,
-        mTheme->mDropShadow, mTheme->mTransparent);
-
-    nvgSave(ctx);
-    nvgResetScissor(ctx);
-    nvgBeginPath(ctx);
-    nvgRect(ctx, mPos.x()-ds,mPos.y()-ds, mSize.x()+2*ds, mSize.y()+2*ds);
-    nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr);
-    nvgPathWinding(ctx, NVG_HOLE);
-    nvgFillPaint(ctx, shadowPaint);
-    nvgFill(ctx);
-    nvgRestore(ctx);
+    PrimitiveBatch::save(ctx);
+    PrimitiveBatch::resetScissor(ctx);
+    if (skinned) {
+        skin->draw(ctx, Skin::Element::WindowShadow, mPos.x(), mPos.y(),
+                   mSize.x(), mSize.y());
+    } else {
+        NVGpaint shadowPaint = nvgBoxGradient(
+            ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr*2, ds*2,
+            mTheme->mDropShadow, mTheme->mTransparent);
+
+        PrimitiveBatch::fillRectWithHole(
+            ctx, mPos.x() - ds, mPos.y() - ds, mSize.x() + 2 * ds,
+            mSize.y() + 2 * ds, mPos.x(), mPos.y(), mSize.x(), mSize.y(), cr,
+            shadowPaint);
+    }
+    PrimitiveBatch::restore(ctx);
 
     if (!mTitle.empty()) {
-        /* Draw header */
-        NVGpaint headerPaint = nvgLinearGradient(
-            ctx, mPos.x(), mPos.y(), mPos.x(),
-            mPos.y() + hh,
-            mTheme->mWindowHeaderGradientTop,
-            mTheme->mWindowHeaderGradientBot);
-
-        nvgBeginPath(ctx);
-        nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), hh, cr);
-
-        nvgFillPaint(ctx, headerPaint);
-        nvgFill(ctx);
-
-        nvgBeginPath(ctx);
-        nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), hh, cr);
-        nvgStrokeColor(ctx, mTheme->mWindowHeaderSepTop);
-
-        nvgSave(ctx);
-        nvgIntersectScissor(ctx, mPos.x(), mPos.y(), mSize.x(), 0.5f);
-        nvgStroke(ctx);
-        nvgRestore(ctx);
-
-        nvgBeginPath(ctx);
-        nvgMoveTo(ctx, mPos.x() + 0.5f, mPos.y() + hh - 1.5f);
-        nvgLineTo(ctx, mPos.x() + mSize.x() - 0.5f, mPos.y() + hh - 1.5);
-        nvgStrokeColor(ctx, mTheme->mWindowHeaderSepBot);
-        nvgStroke(ctx);
+        if (skinned) {
+            skin->draw(ctx, Skin::Element::WindowHeader, mPos.x(), mPos.y(),
+                       mSize.x(), hh);
+        } else {
+            /* Draw header */
+            NVGpaint headerPaint = nvgLinearGradient(
+                ctx, mPos.x(), mPos.y(), mPos.x(),
+                mPos.y() + hh,
+                mTheme->mWindowHeaderGradientTop,
+                mTheme->mWindowHeaderGradientBot);
+
+            PrimitiveBatch::fillRoundedRect(ctx, mPos.x(), mPos.y(),
+                                            mSize.x(), hh, cr, headerPaint);
+
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, mPos.x(), mPos.y(), mSize.x(), hh, cr);
+            nvgStrokeColor(ctx, mTheme->mWindowHeaderSepTop);
+
+            PrimitiveBatch::save(ctx);
+            PrimitiveBatch::intersectScissor(ctx, mPos.x(), mPos.y(), mSize.x(), 0.5f);
+            nvgStroke(ctx);
+            PrimitiveBatch::restore(ctx);
+
+            nvgBeginPath(ctx);
+            nvgMoveTo(ctx, mPos.x() + 0.5f, mPos.y() + hh - 1.5f);
+            nvgLineTo(ctx, mPos.x() + mSize.x() - 0.5f, mPos.y() + hh - 1.5);
+            nvgStrokeColor(ctx, mTheme->mWindowHeaderSepBot);
+            nvgStroke(ctx);
+        }
 
         nvgFontSize(ctx, 18.0f);
         nvgFontFace(ctx, "sans-bold");
@@ -139,6 +159,9 @@ void Window::draw(NVGcontext *ctx) {
 
     nvgRestore(ctx);
     Widget::draw(ctx);
+
+    if (fade)
+        PrimitiveBatch::restore(ctx);
 }
 
 void Window::dispose() {
@@ -185,6 +208,21 @@ void Window::refreshRelativePlacement() {
     /* Overridden in \ref Popup */
 }
 
+int Window::layerMargin() const {
+    return mTheme ? mTheme->mWindowDropShadowSize : 0;
+}
+
+void Window::drawCached(NVGcontext *ctx) {
+    refreshRelativePlacement();
+    if (!mVisible || mOpacity <= 0.0f)
+        return;
+
+    nvgSave(ctx);
+    nvgGlobalAlpha(ctx, mOpacity);
+    Widget::drawCached(ctx);
+    nvgRestore(ctx);
+}
+
 void Window::save(Serializer &s) const {
     Widget::save(s);
     s.set("title", mTitle);